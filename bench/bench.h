@@ -0,0 +1,86 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "lexer.h"
+#include "parser.h"
+
+namespace Bench {
+    // best wall time of `samples` runs of `body`, in milliseconds
+    template<class Body>
+    double best(size_t samples, Body&& body) {
+        double result = 0;
+        for (size_t i = 0; i < samples; i++) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (i == 0 || elapsed < result) result = elapsed;
+        }
+        return result;
+    }
+
+    inline std::string bytes(size_t size) {
+        if (size >= 1024 * 1024) return std::to_string(size / (1024 * 1024)) + " MB";
+        if (size >= 1024) return std::to_string(size / 1024) + " KB";
+        return std::to_string(size) + " B";
+    }
+
+    // sizes given on the command line, in bytes, or `defaults`
+    inline std::vector<size_t> sizes(int argc, char** argv, std::vector<size_t> defaults) {
+        if (argc < 2) return defaults;
+        std::vector<size_t> result;
+        for (int i = 1; i < argc; i++) {
+            result.push_back(std::strtoull(argv[i], nullptr, 10));
+        }
+        return result;
+    }
+
+    // lexes and runs `code` the way the CLI does, exiting on errors so a broken script can not look fast
+    inline ParseResult run(const std::string& code, bool execute = true) {
+        auto lexed = Lexer::parse(code);
+        ParseResult result = Parser::parseTokens(std::move(lexed.second), execute, false, lexed.first, false, false, "bench");
+        if (!result.error.empty()) {
+            std::fprintf(stderr, "%s\n", result.error.c_str());
+            std::exit(1);
+        }
+        return result;
+    }
+
+    // one row: total time and time per unit, so linear work shows up as a flat last column
+    inline void report(const std::string& name, double milliseconds, size_t units, const char* unit) {
+        std::printf("%-28s %12.3f ms %12.2f ns/%s\n", name.c_str(), milliseconds, milliseconds * 1e6 / std::max<size_t>(units, 1), unit);
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// Lexing time of number-heavy configs. Every literal sits inside braces and brackets, where
+// the lexer has to know the depth to tell a decimal comma from a separator; ns/byte should stay
+// flat from the smallest input to the largest.
+
+#include "bench.h"
+#include "lexer.h"
+
+static std::string numbers(size_t size) {
+    std::string text = "values is {list is [";
+    for (size_t i = 0; text.length() < size; i++) {
+        text += std::to_string(i % 1000) + "." + std::to_string(i % 97) + ", ";
+    }
+    text += "0]}.";
+    return text;
+}
+
+int main(int argc, char** argv) {
+    for (size_t size : Bench::sizes(argc, argv, {1024, 1024 * 1024, 50 * 1024 * 1024})) {
+        const std::string text = numbers(size);
+        const size_t repeat = std::max<size_t>(1, (8 * 1024 * 1024) / text.length());
+        double milliseconds = Bench::best(5, [&]() {
+            for (size_t i = 0; i < repeat; i++) {
+                Lexer::parse(text);
+            }
+        }) / repeat;
+        Bench::report("lex " + Bench::bytes(size), milliseconds, text.length(), "byte");
+    }
+    return 0;
+}
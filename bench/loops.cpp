@@ -0,0 +1,40 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// Cost of one `while` iteration. The loop body and condition are parsed once and re-evaluated,
+// so ns/iteration should stay flat as the iteration count grows.
+
+#include "bench.h"
+
+int main(int argc, char** argv) {
+    for (size_t iterations : Bench::sizes(argc, argv, {1000, 10000, 100000})) {
+        const std::string code = "i = 0 , total = 0 , while (i != " + std::to_string(iterations) + ") { i = i + 1 , total = total + i * 2 . } .";
+        double milliseconds = Bench::best(3, [&]() {
+            Bench::run(code);
+        });
+        Bench::report("while " + std::to_string(iterations), milliseconds, iterations, "iteration");
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// Expression-heavy configs: every declaration mixes arithmetic, shifts, bitwise and comparison
+// operators with conditionals, so most of the time goes to the expression parser. "parse" runs
+// without executing, "interpret" evaluates as the CLI does, and "chain" is one long left-associative
+// expression, which is read in a loop rather than one stack frame per operator.
+
+#include "bench.h"
+
+static std::vector<ParserToken> lex(const std::string& code, SourceBuffer& source) {
+    auto lexed = Lexer::parse(code);
+    source = lexed.first;
+    return std::move(lexed.second);
+}
+
+static void parse(const std::vector<ParserToken>& tokens, const SourceBuffer& source, bool execute) {
+    ParseResult result = Parser::parseTokens(tokens, execute, false, source, false, false, "bench");
+    if (!result.error.empty()) {
+        std::fprintf(stderr, "%s\n", result.error.c_str());
+        std::exit(1);
+    }
+}
+
+int main(int argc, char** argv) {
+    for (size_t rows : Bench::sizes(argc, argv, {1000, 10000})) {
+        std::string code;
+        for (size_t i = 0; i < rows; i++) {
+            const std::string n = std::to_string(i);
+            const std::string a = "a" + n, b = "b" + n;
+            if (i != 0) code += " , ";
+            code += a + " is (" + n + " * 3 + 4) / 2 - " + n + " % 5 , " +
+                b + " is " + a + " * (" + a + " + 1) - " + a + " / 2 , " +
+                "c" + n + " is (" + a + " << 2) AND 255 | 1 XOR 6 , " +
+                "d" + n + " is " + a + " > 2 then " + b + " * 2 else -" + a + " , " +
+                "e" + n + " is " + b + " == c" + n + " ? 3 - -" + a + " : " + n + " ** 2";
+        }
+        code += " .";
+
+        SourceBuffer source;
+        const std::vector<ParserToken> tokens = lex(code, source);
+        const size_t declarations = rows * 5;
+
+        double milliseconds = Bench::best(3, [&]() {
+            parse(tokens, source, false);
+        });
+        Bench::report("parse " + std::to_string(declarations), milliseconds, declarations, "declaration");
+
+        milliseconds = Bench::best(3, [&]() {
+            parse(tokens, source, true);
+        });
+        Bench::report("interpret " + std::to_string(declarations), milliseconds, declarations, "declaration");
+    }
+
+    for (size_t operators : {1000, 10000}) {
+        std::string code = "x is 1 , y is x";
+        for (size_t i = 0; i < operators; i++) {
+            code += i % 2 ? " - x" : " + x";
+        }
+        code += " .";
+
+        SourceBuffer source;
+        const std::vector<ParserToken> tokens = lex(code, source);
+        double milliseconds = Bench::best(3, [&]() {
+            parse(tokens, source, true);
+        });
+        Bench::report("chain " + std::to_string(operators), milliseconds, operators, "operator");
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// UTF-8 validation of the input, the old way (a full wstring_convert round trip, as the lexer
+// did before) against Lexer::isValidUTF8, and lexing of an indentation-heavy config. Inputs are
+// mostly ASCII with a few multi-byte names, like real configs; files given on the command line
+// are measured instead of the generated text.
+
+#include "bench.h"
+#include "lexer.h"
+#include <codecvt>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+static std::string config(size_t size) {
+    static const char* names[] = {"Zürich", "server", "東京", "backup", "São Paulo", "cache"};
+    std::string text = "config is {\n";
+    for (size_t i = 0; text.length() < size; i++) {
+        text += "        entry" + std::to_string(i) + " is {\n";
+        text += "            name is \"" + std::string(names[i % 6]) + "\",\n";
+        text += "            port is " + std::to_string(8000 + i % 1000) + ",\n";
+        text += "            enabled is true\n";
+        text += "        },\n";
+    }
+    text += "        last is 0\n}.";
+    return text;
+}
+
+static bool convertUTF8(const std::string& text) {
+    static std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    try {
+        std::wstring wide = converter.from_bytes(text);
+        return !wide.empty() || text.empty();
+    } catch (...) {
+        return false;
+    }
+}
+
+static void measure(const std::string& name, const std::string& text) {
+    const size_t repeat = std::max<size_t>(1, (8 * 1024 * 1024) / text.length());
+    bool valid = true;
+    double milliseconds = Bench::best(5, [&]() {
+        for (size_t i = 0; i < repeat; i++) valid &= convertUTF8(text);
+    }) / repeat;
+    Bench::report("wstring_convert " + name, milliseconds, text.length(), "byte");
+    milliseconds = Bench::best(5, [&]() {
+        for (size_t i = 0; i < repeat; i++) valid &= Lexer::isValidUTF8(text);
+    }) / repeat;
+    Bench::report("isValidUTF8 " + name, milliseconds, text.length(), "byte");
+    milliseconds = Bench::best(5, [&]() {
+        for (size_t i = 0; i < repeat; i++) Lexer::parse(text);
+    }) / repeat;
+    Bench::report("lex " + name, milliseconds, text.length(), "byte");
+    if (!valid) std::printf("%s: not valid UTF-8\n", name.c_str());
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strtoull(argv[1], nullptr, 10) == 0) {
+        for (int i = 1; i < argc; i++) {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::stringstream text;
+            text << file.rdbuf();
+            measure(argv[i], text.str());
+        }
+        return 0;
+    }
+    for (size_t size : Bench::sizes(argc, argv, {1024, 1024 * 1024, 50 * 1024 * 1024})) {
+        measure(Bench::bytes(size), config(size));
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// Cost of evaluating a dependency chain `v0 is 1 , v1 is v0 + 1 , ...`. Variables are evaluated once,
+// in dependency order, so ns/variable should stay roughly flat up to the 50K-key chain.
+
+#include "bench.h"
+
+int main(int argc, char** argv) {
+    for (size_t count : Bench::sizes(argc, argv, {5000, 20000, 50000})) {
+        std::string code = "v0 is 1";
+        for (size_t i = 1; i < count; i++) {
+            code += " , v" + std::to_string(i) + " is v" + std::to_string(i - 1) + " + 1";
+        }
+        code += " .";
+
+        double milliseconds = Bench::best(3, [&]() {
+            Bench::run(code);
+        });
+        Bench::report("chain " + std::to_string(count), milliseconds, count, "variable");
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Monotonic memory for the bookkeeping of one parse: the declaration index, its memo and the scope
+// tables. Tokens, AST nodes and Values stay on the heap, as they outlive the parse (compiled functions
+// keep token ranges, ParseResult shares Value payloads across threads).
+// Freeing is a no-op; release() hands everything back at once and
+// needs every container allocating from the arena to be empty or destroyed first. Not
+// thread-safe: it is only touched under the same locking as the containers it backs.
+class ParseArena {
+public:
+    ParseArena() : resource(initial, sizeof(initial)) {}
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    std::pmr::memory_resource* get() {
+        return &resource;
+    }
+    // frees every block but the inline one, which the next parse starts from again
+    void release() {
+        resource.release();
+    }
+
+private:
+    alignas(std::max_align_t) std::byte initial[4096];
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+#endif
@@ -32,7 +32,7 @@ Value Binary::ToText(const std::vector<Value>& args) {
         throw std::runtime_error("Binary::ToText requires Binary Data as first argument");
     }
 
-    const auto& binary = args[0].binary_data;
+    const auto& binary = args[0].binary_data();
     std::string encoding = "utf-8";
 
     if (args.size() > 1) {
@@ -228,7 +228,6 @@ Value Binary::ToDataURL(const std::vector<Value>& args) {
         throw std::runtime_error("Binary::ToDataURL requires binary data as first argument");
     }
 
-    const auto& binary = args[0].binary_data;
     std::string mime_type = "application/octet-stream";
 
     if (args.size() > 1) {
@@ -43,6 +43,7 @@ SOFTWARE.
 #include "../compiler/justb.hpp"
 #include "../loader/justb.hpp"
 #include "../justb.hpp"
+#include "../threadpool.h"
 
 void logError(const std::string& error) {
     if (Utility::isGitHubActions()) {
@@ -197,7 +198,10 @@ Usage:
 
 Options:
   --                                    Indicate the end of JUSTC options
-  --async-evaluation                    Asynchronous variable evaluation
+  --async-evaluation                    Run builtins such as HTTP requests asynchronously
+  --async-metrics                       Print thread pool metrics after the run
+  --async-queue-limit <count>           Maximum number of queued asynchronous tasks (0 - unlimited)
+  --async-workers <count>               Number of worker threads used by asynchronous builtins
   -c, --check                           Validate JUSTC/JUSTO/JUSTB input
   --disallow-javascript                 Disallow JavaScript
   --disallow-luau                       Disallow Luau
@@ -312,6 +316,9 @@ struct CommandLineFlags {
     bool print = false;
     bool check = false;
     bool async = false;
+    size_t asyncWorkers = 0;
+    size_t asyncQueueLimit = 1024;
+    bool asyncMetrics = false;
     bool endOfOptions = false;
 
     bool allowJS = true;
@@ -398,6 +405,19 @@ CommandLineFlags parseArguments(int argc, char* argv[]) {
         } else if (arg == "--async-evaluation") {
             flags.async = true;
             ++i;
+        } else if (arg == "--async-workers" || arg == "--async-queue-limit") {
+            if (i + 1 >= args.size()) {
+                throwError("Missing value for option: " + arg);
+            }
+            try {
+                (arg == "--async-workers" ? flags.asyncWorkers : flags.asyncQueueLimit) = std::stoul(args[i + 1]);
+            } catch (...) {
+                throwError("Invalid value for option " + arg + ": " + args[i + 1]);
+            }
+            i += 2;
+        } else if (arg == "--async-metrics") {
+            flags.asyncMetrics = true;
+            ++i;
         } else if (arg == "--disallow-javascript") {
             flags.allowJS = false;
             ++i;
@@ -473,7 +493,7 @@ void handleExecute(const CommandLineFlags& flags) {
 
     std::string code = readFile(flags.input);
     auto lexerResult = lexer(code);
-    ParseResult result = Parser::parseTokens(lexerResult.second, true, flags.async, code, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
+    ParseResult result = Parser::parseTokens(std::move(lexerResult.second), true, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
 
     if (!result.error.empty()) {
         throwError(result.error);
@@ -492,7 +512,7 @@ void handleSerialize(const CommandLineFlags& flags) {
     std::string format = getOutputFormat(flags.format);
     std::string code = readFile(flags.input);
     auto lexerResult = lexer(code);
-    ParseResult result = Parser::parseTokens(lexerResult.second, false, flags.async, code, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
+    ParseResult result = Parser::parseTokens(std::move(lexerResult.second), false, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
 
     if (!result.error.empty()) {
         throwError(result.error);
@@ -514,7 +534,7 @@ void handleCompileJustb(const CommandLineFlags& flags) {
 
     std::string code = readFile(flags.input);
     auto lexerResult = lexer(code);
-    ParseResult result = Parser::parseTokens(lexerResult.second, true, flags.async, code, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
+    ParseResult result = Parser::parseTokens(std::move(lexerResult.second), true, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
 
     if (!result.error.empty()) {
         throwError(result.error);
@@ -560,7 +580,7 @@ void handleCheck(const CommandLineFlags& flags) {
     if (ext == "justc") {
         std::string code = readFile(flags.input);
         auto lexerResult = lexer(code);
-        ParseResult result = Parser::parseTokens(lexerResult.second, false, flags.async, code, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
+        ParseResult result = Parser::parseTokens(std::move(lexerResult.second), false, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
 
         if (!result.error.empty()) {
             throwError(result.error);
@@ -602,7 +622,7 @@ void handelJsonToJusto(const CommandLineFlags& flags) {
     std::string json = readFile(flags.input);
     std::string justc = JsonParser::stringify(json);
     auto lexerResult = lexer(justc);
-    ParseResult result = Parser::parseTokens(lexerResult.second, false, flags.async, justc, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
+    ParseResult result = Parser::parseTokens(std::move(lexerResult.second), false, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, flags.input, "script", flags.allowLuau, flags.allowLuau);
     std::string justo = serializeResult(result, "justo");
 
     if (!flags.output.empty()) {
@@ -621,6 +641,9 @@ int main(int argc, char* argv[]) {
     try {
         CommandLineFlags flags = parseArguments(argc, argv);
 
+        ThreadPool::setDefaultWorkers(flags.asyncWorkers);
+        ThreadPool::setDefaultQueueLimit(flags.asyncQueueLimit);
+
         if (flags.silent) {
             outputRedirector = new OutputRedirector(true, false);
         }
@@ -645,7 +668,7 @@ int main(int argc, char* argv[]) {
         } else if (flags.command == "evaluate") {
             std::string code = flags.input;
             auto lexerResult = lexer(code);
-            ParseResult result = Parser::parseTokens(lexerResult.second, true, flags.async, code, flags.allowJS, flags.allowJS, "<eval>", "script", flags.allowLuau, flags.allowLuau);
+            ParseResult result = Parser::parseTokens(std::move(lexerResult.second), true, flags.async, lexerResult.first, flags.allowJS, flags.allowJS, "<eval>", "script", flags.allowLuau, flags.allowLuau);
 
             if (!result.error.empty()) {
                 throwError(result.error);
@@ -688,6 +711,13 @@ int main(int argc, char* argv[]) {
             delete outputRedirector;
         }
 
+        if (flags.asyncMetrics) {
+            ThreadPool::Metrics metrics = ThreadPool::getInstance().metrics();
+            std::cerr << "Thread pool: " << metrics.workers << " workers, queue limit " << metrics.queueLimit
+                      << ", " << metrics.submitted << " tasks submitted, " << metrics.completed << " completed, "
+                      << metrics.ranInline << " ran inline, peak queue " << metrics.peakQueued << std::endl;
+        }
+
     } catch (const std::exception& e) {
         logError(e.what());
         return 1;
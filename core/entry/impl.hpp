@@ -50,7 +50,7 @@ Value API::convertFromCore(const ::Value& v) {
 
             Array arr;
 
-            for (const auto& item : v.array_elements)
+            for (const auto& item : v.array_elements())
                 arr.push_back(
                     convertFromCore(item)
                 );
@@ -63,7 +63,7 @@ Value API::convertFromCore(const ::Value& v) {
 
             Object obj;
 
-            for (const auto& [k,val] : v.properties)
+            for (const auto& [k,val] : v.properties())
                 obj[k]=convertFromCore(val);
 
             return obj;
@@ -141,10 +141,10 @@ Object API::parse(
 
     auto result =
         Parser::parseTokens(
-            lexed.second,
+            std::move(lexed.second),
             execute,
             async,
-            code
+            lexed.first
         );
 
     Object out;
@@ -309,7 +309,9 @@ std::pair<
 API::lexer(
     const std::string& code
 ){
-    return Lexer::parse(code,true);
+    auto lexed = Lexer::parse(code,true);
+    for (auto& token : lexed.second) token.value.detach();
+    return {*lexed.first, std::move(lexed.second)};
 }
 
 ParseResult API::parser(
@@ -109,6 +109,10 @@ static std::mutex varUpdateListenersMutex;
 static std::unordered_map<std::string, int> jsFunctions;
 static std::mutex jsFunctionsMutex;
 
+static std::unordered_map<int, LexedDocument> lexerDocuments;
+static int nextLexerDocument = 1;
+static std::mutex lexerDocumentsMutex;
+
 void ensureGlobalParser() {
     if (!globalParser) {
         globalParser = std::make_unique<Parser>(
@@ -173,7 +177,27 @@ char* lexer(const char* input, const char* outputMode) {
 
     try {
         auto parsed = Lexer::parse(input, true);
-        std::string json = outputString(mode, parsed.second, parsed.first);
+        std::string json = outputString(mode, parsed.second, *parsed.first);
+        return strdup(json.c_str());
+
+    } catch (const std::exception& e) {
+        std::string error = "{\"error\":\"" + JsonSerializer::escapeJsonString(std::string(e.what())) + "\",\"lexer\":true}";
+        return strdup(error.c_str());
+    }
+}
+
+// offsets are UTF-8 byte offsets into the document
+char* lexerOpen(const char* input) {
+    if (input == nullptr) return nullptr;
+
+    try {
+        LexedDocument document = Lexer::lexDocument(input);
+        std::string tokens = JsonSerializer::tokensToJson(document.tokens());
+
+        std::lock_guard<std::mutex> lock(lexerDocumentsMutex);
+        int id = nextLexerDocument++;
+        lexerDocuments[id] = std::move(document);
+        std::string json = "{\"document\":" + std::to_string(id) + ",\"tokens\":" + tokens + "}";
         return strdup(json.c_str());
 
     } catch (const std::exception& e) {
@@ -182,6 +206,40 @@ char* lexer(const char* input, const char* outputMode) {
     }
 }
 
+char* lexerEdit(int id, int offset, int removed, const char* inserted) {
+    if (inserted == nullptr) return nullptr;
+
+    try {
+        std::lock_guard<std::mutex> lock(lexerDocumentsMutex);
+        auto it = lexerDocuments.find(id);
+        if (it == lexerDocuments.end()) {
+            throw std::invalid_argument("Unknown lexer document " + std::to_string(id) + ".");
+        }
+        if (offset < 0 || removed < 0) {
+            throw std::out_of_range("Edit out of range.");
+        }
+
+        TokenDelta delta = Lexer::relex(it->second, offset, removed, inserted);
+        std::stringstream json;
+        json << "{";
+        json << "\"first\":" << delta.first << ",";
+        json << "\"removed\":" << delta.removed << ",";
+        json << "\"shift\":" << delta.shift << ",";
+        json << "\"tokens\":" << JsonSerializer::tokensToJson(delta.inserted);
+        json << "}";
+        return strdup(json.str().c_str());
+
+    } catch (const std::exception& e) {
+        std::string error = "{\"error\":\"" + JsonSerializer::escapeJsonString(std::string(e.what())) + "\",\"lexer\":true}";
+        return strdup(error.c_str());
+    }
+}
+
+void lexerClose(int id) {
+    std::lock_guard<std::mutex> lock(lexerDocumentsMutex);
+    lexerDocuments.erase(id);
+}
+
 char* parser(const char* tokensJUSTO, const char* outputMode) {
     if (tokensJUSTO == nullptr) return nullptr;
     std::string mode(outputMode == nullptr ? "json" : outputMode);
@@ -211,7 +269,7 @@ char* parse(const char* input, const bool execute, const bool runAsync, const ch
 
     try {
         auto lexerResult = Lexer::parse(input);
-        ParseResult result = Parser::parseTokens(lexerResult.second, execute, runAsync, input);
+        ParseResult result = Parser::parseTokens(std::move(lexerResult.second), execute, runAsync, lexerResult.first);
 
         if (result.variables) {
             for (const auto& [key, value] : *result.variables) {
@@ -0,0 +1,674 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "expression.h"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <stdexcept>
+
+// One grammar for expressions, read two ways: Interpreting evaluates each step as it is read and
+// backs parseExpression(); Compiling builds an Expression tree once, which if/while conditions
+// evaluate on every pass. Statement bodies are still interpreted from the tokens.
+// Operations whose operands are all literals are folded into a literal while compiling.
+
+namespace {
+    struct OperatorToken {
+        TokenKind kind;
+        const char* keyword;
+    };
+
+    const std::vector<OperatorToken> operatorLevels[OPERATOR_LEVELS] = {
+        {{TokenKind::KEYWORD, "OR"}, {TokenKind::PIPE, nullptr}},
+        {{TokenKind::KEYWORD, "XOR"}, {TokenKind::CARET, nullptr}},
+        {{TokenKind::KEYWORD, "AND"}, {TokenKind::AMP, nullptr}},
+        {{TokenKind::LESS_LESS, nullptr}, {TokenKind::GREATER_GREATER, nullptr}},
+        {{TokenKind::PIPE_GREATER, nullptr}, {TokenKind::LEFT_BRACKET, nullptr}, {TokenKind::DOT, nullptr}},
+        {{TokenKind::QUESTION_COLON, nullptr}, {TokenKind::QUESTION_QUESTION, nullptr}},
+        {{TokenKind::KEYWORD, "or"}, {TokenKind::PIPE_PIPE, nullptr}, {TokenKind::KEYWORD, "orn't"}, {TokenKind::BANG_PIPE, nullptr}, {TokenKind::KEYWORD, "nor"}},
+        {{TokenKind::KEYWORD, "xor"}, {TokenKind::KEYWORD, "xnor"}},
+        {{TokenKind::KEYWORD, "and"}, {TokenKind::AMP_AMP, nullptr}, {TokenKind::KEYWORD, "andn't"}, {TokenKind::BANG_AMP, nullptr}, {TokenKind::KEYWORD, "nand"}},
+        {{TokenKind::KEYWORD, "imply"}, {TokenKind::KEYWORD, "nimply"}},
+        {{TokenKind::KEYWORD, "is"}, {TokenKind::EQUAL_EQUAL, nullptr}, {TokenKind::KEYWORD, "isn't"}, {TokenKind::BANG_EQUAL, nullptr}, {TokenKind::TILDE_EQUAL, nullptr}, {TokenKind::EQUAL, nullptr}},
+        {{TokenKind::LESS, nullptr}, {TokenKind::GREATER, nullptr}, {TokenKind::LESS_EQUAL, nullptr}, {TokenKind::GREATER_EQUAL, nullptr}},
+        {{TokenKind::PLUS, nullptr}, {TokenKind::MINUS, nullptr}, {TokenKind::DOT_DOT, nullptr}},
+        {{TokenKind::STAR, nullptr}, {TokenKind::SLASH, nullptr}, {TokenKind::PERCENT, nullptr}, {TokenKind::COLON, nullptr}},
+        {{TokenKind::STAR_STAR, nullptr}}
+    };
+
+    struct OperatorIndex {
+        size_t symbols[256];
+        std::unordered_map<std::string, size_t> keywords;
+
+        OperatorIndex() {
+            std::fill(std::begin(symbols), std::end(symbols), static_cast<size_t>(OPERATOR_LEVELS));
+            for (size_t level = 0; level < OPERATOR_LEVELS; level++) {
+                for (const auto& op : operatorLevels[level]) {
+                    if (op.keyword) keywords[op.keyword] = level;
+                    else symbols[static_cast<size_t>(op.kind)] = level;
+                }
+            }
+        }
+    };
+
+    std::shared_ptr<Expression> node(ExpressionKind kind, const std::string& op, size_t token) {
+        auto result = std::make_shared<Expression>(kind, token);
+        result->op = op;
+        return result;
+    }
+}
+
+size_t operatorLevel(const ParserToken& token) {
+    static const OperatorIndex index;
+
+    if (token.kind != TokenKind::KEYWORD) return index.symbols[static_cast<size_t>(token.kind)];
+    auto found = index.keywords.find(token.value.str());
+    return found == index.keywords.end() ? static_cast<size_t>(OPERATOR_LEVELS) : found->second;
+}
+
+ExpressionPtr Parser::compileRange(size_t first, size_t last) {
+    const size_t saved = position;
+    position = first;
+
+    ExpressionPtr result;
+    try {
+        result = compileExpression();
+    } catch (...) {
+        result = nullptr;
+    }
+    if (position != last) result = nullptr;
+
+    position = saved;
+    return result;
+}
+
+// Reads a step of the grammar below by evaluating it on the spot, the way the parser always has
+struct Parser::Interpreting {
+    using Result = Value;
+
+    Parser& parser;
+    bool doExecute;
+    bool identifierMode;
+    bool doFunctionCall;
+    bool ignoreColon;
+
+    static bool ok(const Value&) { return true; }
+    Value fail(const std::string& message) const { throw std::runtime_error(message); }
+    Value empty() const { return Value(); }
+
+    size_t pipelineLevel(const Value& left, TokenKind kind) const {
+        if (kind != TokenKind::PIPE_GREATER && (left.type == DataType::VARIABLE || left.type == DataType::UNKNOWN)) return OPERATOR_LEVELS;
+        return PIPELINE;
+    }
+    static bool accepts(TokenKind) { return true; }
+
+    Value expression(bool ignoreColon) {
+        return parser.parseExpression(doExecute, identifierMode, doFunctionCall, ignoreColon);
+    }
+    Value pipeline(TokenKind kind) {
+        if (kind == TokenKind::DOT && parser.match(TokenKind::IDENTIFIER)) return parser.getIdentifier();
+        Interpreting access{parser, doExecute, true, false, true};
+        return parser.readBinary(access, COALESCING);
+    }
+    Value method() {
+        if (parser.match(TokenKind::IDENTIFIER)) return parser.getIdentifier();
+        Interpreting access{parser, doExecute, true, false, true};
+        return parser.readBinary(access, POWER);
+    }
+    Value primary() {
+        return parser.parsePrimary(doExecute, doFunctionCall);
+    }
+    Value unexpectedOperator() const {
+        throw std::runtime_error("Unexpected operator \"" + parser.currentToken().value + "\" at " + parser.sourcePosition(parser.currentToken().start) + ".");
+    }
+
+    Value unary(size_t op, const Value& operand) {
+        if (parser.tokens[op].value == "#") {
+            return parser.evaluateLengthOperator(operand);
+        }
+        return parser.evaluateExpression(Value(), parser.tokens[op].value.str(), operand, doExecute);
+    }
+    Value binary(const Value& left, size_t op, const Value& right) {
+        return parser.evaluateExpression(left, parser.tokens[op].value.str(), right, doExecute);
+    }
+    Value conditional(const Value& condition, size_t thenOp, const Value& thenValue, size_t elseOp, const Value& elseValue) {
+        return parser.handleConditional(condition, thenValue, elseValue, parser.tokens[thenOp].value.str(), parser.tokens[elseOp].value.str());
+    }
+};
+
+// Reads the same steps into Expression nodes. Anything whose parse depends on runtime values or
+// that assigns makes it give up with nullptr, and the caller interprets the tokens instead.
+struct Parser::Compiling {
+    using Result = ExpressionPtr;
+
+    Parser& parser;
+    static constexpr bool identifierMode = false;
+    bool ignoreColon;
+
+    static bool ok(const ExpressionPtr& result) { return result != nullptr; }
+    ExpressionPtr fail(const std::string&) const { return nullptr; }
+    ExpressionPtr empty() const { return node(ExpressionKind::LITERAL, "", parser.position); }
+
+    // a pipeline step is chosen by the value on its left
+    static size_t pipelineLevel(const ExpressionPtr&, TokenKind) { return OPERATOR_LEVELS + 1; }
+    static bool accepts(TokenKind kind) { return kind != TokenKind::EQUAL && kind != TokenKind::COLON; } // assignment, method call
+
+    ExpressionPtr expression(bool ignoreColon) {
+        return parser.compileExpression(ignoreColon);
+    }
+    ExpressionPtr pipeline(TokenKind) { return nullptr; }
+    ExpressionPtr method() { return nullptr; }
+    ExpressionPtr primary() {
+        return parser.compilePrimary();
+    }
+    ExpressionPtr unexpectedOperator() const { return nullptr; }
+
+    ExpressionPtr unary(size_t op, const ExpressionPtr& operand) {
+        auto result = node(ExpressionKind::UNARY, parser.tokens[op].value.str(), op);
+        result->operands = {operand};
+        result->token = parser.position;
+        return parser.foldConstant(result);
+    }
+    ExpressionPtr binary(const ExpressionPtr& left, size_t op, const ExpressionPtr& right) {
+        auto result = node(ExpressionKind::BINARY, parser.tokens[op].value.str(), op);
+        result->operands = {left, right};
+        result->token = parser.position;
+        return parser.foldConstant(result);
+    }
+    ExpressionPtr conditional(const ExpressionPtr& condition, size_t thenOp, const ExpressionPtr& thenValue, size_t elseOp, const ExpressionPtr& elseValue) {
+        auto result = node(ExpressionKind::CONDITIONAL, parser.tokens[thenOp].value.str(), thenOp);
+        result->elseOp = parser.tokens[elseOp].value.str();
+        result->operands = {condition, thenValue, elseValue};
+        result->token = parser.position;
+        return parser.foldConstant(result);
+    }
+};
+
+template<class Reader>
+typename Reader::Result Parser::readConditional(Reader& reader) {
+    typename Reader::Result condition = readBinary(reader, BITWISE_OR);
+    if (!reader.ok(condition) || reader.identifierMode) return condition;
+
+    if (match(TokenKind::KEYWORD, "then") || match(TokenKind::QUESTION)) {
+        const size_t thenOp = position;
+        advance();
+
+        typename Reader::Result thenValue = reader.expression(true);
+        if (!reader.ok(thenValue)) return {};
+        if (!match(TokenKind::KEYWORD, "else") && !match(TokenKind::COLON)) return reader.fail("Expected 'else' after 'then'");
+        const size_t elseOp = position;
+        advance();
+
+        typename Reader::Result elseValue = reader.expression(reader.ignoreColon);
+        if (!reader.ok(elseValue)) return {};
+        return reader.conditional(condition, thenOp, thenValue, elseOp, elseValue);
+    }
+
+    if (match(TokenKind::KEYWORD, "elseif")) {
+        advance();
+
+        typename Reader::Result elseifCondition = reader.expression(reader.ignoreColon);
+        if (!reader.ok(elseifCondition)) return {};
+        if (!match(TokenKind::KEYWORD, "then") && !match(TokenKind::QUESTION)) return reader.fail("Expected 'then' after 'elseif'");
+        const size_t thenOp = position;
+        advance();
+
+        typename Reader::Result thenValue = reader.expression(true);
+        if (!reader.ok(thenValue)) return {};
+        if (!match(TokenKind::KEYWORD, "else") && !match(TokenKind::COLON)) return reader.fail("Expected 'else' after 'then' in elseif");
+        const size_t elseOp = position;
+        advance();
+
+        typename Reader::Result elseValue = reader.expression(reader.ignoreColon);
+        if (!reader.ok(elseValue)) return {};
+        typename Reader::Result nested = reader.conditional(elseifCondition, thenOp, thenValue, elseOp, elseValue);
+        if (!reader.ok(nested)) return {};
+        return reader.conditional(condition, thenOp, thenValue, elseOp, nested);
+    }
+
+    return condition;
+}
+
+// Precedence climbing over the operator table in expression.h: operators of `minLevel` or above
+// are taken, and the right operand of a level-n operator is read with minLevel n + 1.
+template<class Reader>
+typename Reader::Result Parser::readBinary(Reader& reader, size_t minLevel) {
+    size_t maxLevel = OPERATOR_LEVELS;
+    typename Reader::Result left;
+
+    if (minLevel <= BITWISE_AND && (match(TokenKind::KEYWORD, "NOT") || match(TokenKind::TILDE))) {
+        left = readBitwiseNOT(reader);
+        maxLevel = BITWISE_SHIFT;
+    } else {
+        left = readUnary(reader);
+    }
+
+    while (reader.ok(left)) {
+        const ParserToken& token = currentToken();
+        size_t level = operatorLevel(token);
+        switch (level) {
+            case PIPELINE:
+                if (token.kind == TokenKind::DOT && (position + 1 >= tokens.size() || tokens[position - 1].kind == TokenKind::KEYWORD)) level = OPERATOR_LEVELS; // full stop
+                else level = reader.pipelineLevel(left, token.kind);
+                break;
+            case EQUALITY:
+                if (reader.identifierMode) level = OPERATOR_LEVELS;
+                break;
+            case FACTOR:
+                if (token.kind == TokenKind::COLON && (reader.identifierMode || reader.ignoreColon)) level = OPERATOR_LEVELS;
+                break;
+        }
+        if (level > OPERATOR_LEVELS) return {};
+        if (level < minLevel || level >= maxLevel) break;
+
+        const TokenKind kind = token.kind;
+        if (!reader.accepts(kind)) return {};
+        const size_t op = position;
+        advance();
+
+        typename Reader::Result right;
+        if (level == PIPELINE) {
+            right = reader.pipeline(kind);
+        } else if (kind == TokenKind::COLON) {
+            right = reader.method();
+        } else if (level == BITWISE_AND && (match(TokenKind::KEYWORD, "NOT") || match(TokenKind::TILDE))) {
+            right = readBitwiseNOT(reader);
+        } else if (level == POWER) {
+            right = readUnary(reader);
+        } else {
+            right = readBinary(reader, level + 1);
+        }
+        if (!reader.ok(right)) return {};
+
+        left = reader.binary(left, op, right);
+        maxLevel = level + 1;
+    }
+
+    return left;
+}
+
+template<class Reader>
+typename Reader::Result Parser::readBitwiseNOT(Reader& reader) {
+    typename Reader::Result left = reader.empty();
+
+    while (match(TokenKind::KEYWORD, "NOT") || match(TokenKind::TILDE)) {
+        const size_t op = position;
+        advance();
+
+        typename Reader::Result right = readBinary(reader, BITWISE_SHIFT);
+        if (!reader.ok(right)) return {};
+        left = reader.binary(left, op, right);
+    }
+
+    return left;
+}
+
+template<class Reader>
+typename Reader::Result Parser::readUnary(Reader& reader) {
+    if ((match(TokenKind::MINUS) && !reader.identifierMode) || match(TokenKind::PLUS) || match(TokenKind::BANG) ||
+        (match(TokenKind::DASH) && !reader.identifierMode) || match(TokenKind::HASH)) {
+        const size_t op = position;
+        advance();
+
+        typename Reader::Result operand = readUnary(reader);
+        if (!reader.ok(operand)) return {};
+        return reader.unary(op, operand);
+    }
+
+    if (isOperatorStart(reader.identifierMode)) {
+        if (!match(TokenKind::KEYWORD, "NOT") && !match(TokenKind::TILDE)) return reader.unexpectedOperator();
+        return readBinary(reader, BITWISE_OR);
+    }
+
+    return reader.primary();
+}
+
+Value Parser::parseConditional(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
+    Interpreting reader{*this, doExecute, identifierMode, doFunctionCall, ignoreColon};
+    return readConditional(reader);
+}
+
+Value Parser::parseBinary(size_t minLevel, bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
+    Interpreting reader{*this, doExecute, identifierMode, doFunctionCall, ignoreColon};
+    return readBinary(reader, minLevel);
+}
+
+ExpressionPtr Parser::compileExpression(bool ignoreColon) {
+    if (match(TokenKind::KEYWORD, "function") || match(TokenKind::KEYWORD, "isolated")) return nullptr;
+
+    Compiling reader{*this, ignoreColon};
+    ExpressionPtr result = readConditional(reader);
+
+    if (match(TokenKind::MINUS_MINUS) || match(TokenKind::PLUS_PLUS) || match(TokenKind::HASH) || match(TokenKind::BANG) || match(TokenKind::TILDE)) {
+        return nullptr; // unary assignment
+    }
+
+    return result;
+}
+
+ExpressionPtr Parser::compilePrimary() {
+    if (match(TokenKind::NUMBER) || match(TokenKind::HEX) || match(TokenKind::BINARY) || match(TokenKind::STRING) ||
+        match(TokenKind::LINK) || match(TokenKind::BOOLEAN) || match(TokenKind::NULL_VALUE) || (
+            (match(TokenKind::DOT) || match(TokenKind::COMMA)) && peekToken().kind == TokenKind::NUMBER
+        )
+    ) {
+        auto result = node(ExpressionKind::LITERAL, "", position);
+        result->value = parsePrimary(false);
+        result->token = position;
+        return result;
+    }
+
+    if (match(TokenKind::IDENTIFIER)) {
+        std::string name = currentToken().value.str();
+        if ((peekToken().kind == TokenKind::DOT && position + 2 < tokens.size()) || peekToken().kind == TokenKind::LEFT_BRACKET) {
+            return compileMember();
+        }
+        if (!name.empty() && name[0] == '$') return nullptr;
+        if (peekToken().kind == TokenKind::LEFT_PAREN) return compileCall();
+        if (peekToken().kind == TokenKind::COLON_COLON) return nullptr;
+
+        auto result = node(ExpressionKind::VARIABLE, name, position);
+        advance();
+        result->token = position;
+        return result;
+    }
+
+    if (match(TokenKind::KEYWORD) && peekToken().kind == TokenKind::LEFT_PAREN) return compileCall();
+
+    if (match(TokenKind::LEFT_PAREN)) {
+        advance();
+        ExpressionPtr result = compileExpression();
+        if (!result || !match(TokenKind::RIGHT_PAREN)) return nullptr;
+        advance();
+        return result;
+    }
+
+    return nullptr;
+}
+
+ExpressionPtr Parser::compileCall() {
+    auto result = node(ExpressionKind::CALL, currentToken().value.str(), position);
+    result->builtin = findBuiltinFunction(result->op);
+    result->call = true;
+    advance();
+
+    if (!compileArguments(result->arguments)) return nullptr;
+
+    result->token = position;
+    return result;
+}
+
+ExpressionPtr Parser::compileMember() {
+    auto result = node(ExpressionKind::MEMBER, currentToken().value.str(), position);
+    advance();
+
+    while ((match(TokenKind::DOT) || match(TokenKind::LEFT_BRACKET)) && position + 1 < tokens.size()) {
+        if (match(TokenKind::DOT)) {
+            advance();
+            if (!match(TokenKind::IDENTIFIER) && !match(TokenKind::KEYWORD)) return nullptr;
+
+            auto propName = node(ExpressionKind::LITERAL, "", position);
+            propName->value = stringToValue(currentToken().value.str());
+            result->operands.push_back(propName);
+            advance();
+        } else {
+            advance();
+            ExpressionPtr index = compileExpression();
+            if (!index || !match(TokenKind::RIGHT_BRACKET)) return nullptr;
+            result->operands.push_back(index);
+            advance();
+        }
+    }
+
+    if (match(TokenKind::LEFT_PAREN)) {
+        result->call = true;
+        if (!compileArguments(result->arguments)) return nullptr;
+    }
+
+    result->token = position;
+    return foldConstant(result);
+}
+
+bool Parser::compileArguments(std::vector<ExpressionPtr>& arguments) {
+    if (!match(TokenKind::LEFT_PAREN)) return false;
+    advance();
+
+    while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
+        ExpressionPtr argument = compileExpression();
+        if (!argument) return false;
+        arguments.push_back(argument);
+
+        if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
+        else if (!match(TokenKind::RIGHT_PAREN)) return false;
+    }
+
+    if (!match(TokenKind::RIGHT_PAREN)) return false;
+    advance();
+    return true;
+}
+
+ExpressionPtr Parser::foldConstant(ExpressionPtr expression) {
+    auto literal = [](const ExpressionPtr& operand) { return operand->kind == ExpressionKind::LITERAL; };
+    const auto& operands = expression->operands;
+    const auto& arguments = expression->arguments;
+
+    switch (expression->kind) {
+        case ExpressionKind::UNARY:
+        case ExpressionKind::BINARY:
+        case ExpressionKind::CONDITIONAL:
+            // `#` counts characters by CharType, which the script can change after this is folded
+            if (expression->op == "#" || !std::all_of(operands.begin(), operands.end(), literal)) return expression;
+            break;
+
+        case ExpressionKind::MEMBER: {
+            // Math.<constant> and Math.<function>(<literals>...), while Math is still the builtin object
+            if (expression->op != "Math" || operands.size() != 1 || !literal(operands[0]) || operands[0]->value.type != DataType::STRING) return expression;
+            if (!std::all_of(arguments.begin(), arguments.end(), literal) || !canFoldBuiltinCalls()) return expression;
+            if (expression->call) {
+                const BuiltinFunction* builtin = findBuiltinFunction("Math." + operands[0]->value.string_value);
+                if (!builtin || !builtin->pure) return expression;
+            }
+            break;
+        }
+
+        default:
+            return expression;
+    }
+
+    auto result = node(ExpressionKind::LITERAL, "", expression->token);
+    try {
+        result->value = evaluate(*expression, true);
+    } catch (...) {
+        return expression; // reported when evaluated, at its own position
+    }
+    result->foldedCall = expression->kind == ExpressionKind::MEMBER ||
+        std::any_of(operands.begin(), operands.end(), [](const ExpressionPtr& operand) { return operand->foldedCall; }) ||
+        std::any_of(arguments.begin(), arguments.end(), [](const ExpressionPtr& operand) { return operand->foldedCall; });
+    return result;
+}
+
+bool Parser::canFoldBuiltinCalls() {
+    if (!doExecute || hasLocal(currentScope, "Math")) return false;
+    auto it = variables.find("Math");
+    return it != variables.end() && it->second.type == DataType::JSON_OBJECT && it->second.name == "Math";
+}
+
+bool Parser::foldedConstant(bool ignoreColon, Value& result) {
+    if (isEnd()) return false;
+
+    const ParserToken& first = currentToken();
+    switch (first.kind) {
+        case TokenKind::NUMBER: case TokenKind::HEX: case TokenKind::BINARY: case TokenKind::STRING:
+        case TokenKind::BOOLEAN: case TokenKind::NULL_VALUE: case TokenKind::LEFT_PAREN:
+        case TokenKind::MINUS: case TokenKind::PLUS: case TokenKind::BANG: case TokenKind::DASH:
+        case TokenKind::TILDE: case TokenKind::DOT: case TokenKind::COMMA:
+            break;
+        case TokenKind::IDENTIFIER:
+            if (first.value != "Math") return false;
+            break;
+        case TokenKind::KEYWORD:
+            if (first.value != "NOT") return false;
+            break;
+        default:
+            return false;
+    }
+
+    auto& expressions = constantFolds->expressions;
+    const size_t key = first.start * 2 + (ignoreColon ? 1 : 0);
+    auto it = expressions.find(key);
+    if (it == expressions.end()) {
+        const size_t saved = position;
+        ExpressionPtr expression;
+        try {
+            expression = compileExpression(ignoreColon);
+        } catch (...) {
+            expression = nullptr;
+        }
+        const size_t end = position;
+        position = saved;
+
+        FoldedConstant folded{0, 0, false, nullptr};
+        if (expression && expression->kind == ExpressionKind::LITERAL && end - saved > 1) {
+            folded = FoldedConstant{end - saved, tokens[end - 1].start, expression->foldedCall, std::make_shared<const Value>(expression->value)};
+        }
+        it = expressions.emplace(key, std::move(folded)).first;
+    }
+
+    const FoldedConstant& folded = it->second;
+    if (!folded.tokens || position + folded.tokens > tokens.size() || tokens[position + folded.tokens - 1].start != folded.lastStart) return false;
+    if (folded.calls && !canFoldBuiltinCalls()) return false;
+
+    result = *folded.value;
+    position += folded.tokens;
+    return true;
+}
+
+Value Parser::evaluate(const Expression& expression, bool doExecute, const std::unordered_map<std::string, Value>* scope) {
+    const size_t saved = position;
+    try {
+        Value result = evaluateNode(expression, doExecute, scope);
+        position = saved;
+        return result;
+    } catch (...) {
+        position = saved;
+        throw;
+    }
+}
+
+Value Parser::lookup(const std::string& name, bool unknownIsString, const std::unordered_map<std::string, Value>* scope) {
+    if (scope && !hasGlobal(name)) {
+        auto it = scope->find(name);
+        if (it != scope->end()) return it->second;
+    }
+    return resolveVariableValue(name, unknownIsString);
+}
+
+Value Parser::evaluateNode(const Expression& expression, bool doExecute, const std::unordered_map<std::string, Value>* scope) {
+    switch (expression.kind) {
+        case ExpressionKind::LITERAL:
+            return expression.value;
+
+        case ExpressionKind::VARIABLE: {
+            try {
+                return lookup(expression.op, true, scope);
+            } catch (...) {
+                Value result;
+                result.type = DataType::VARIABLE;
+                result.string_value = expression.op;
+                return result;
+            }
+        }
+
+        case ExpressionKind::UNARY: {
+            Value right = evaluateNode(*expression.operands[0], doExecute, scope);
+            position = expression.token;
+            if (expression.op == "#") {
+                return evaluateLengthOperator(right);
+            }
+            return evaluateExpression(Value(), expression.op, right, doExecute);
+        }
+
+        case ExpressionKind::BINARY: {
+            Value left = evaluateNode(*expression.operands[0], doExecute, scope);
+            Value right = evaluateNode(*expression.operands[1], doExecute, scope);
+            position = expression.token;
+            return evaluateExpression(left, expression.op, right, doExecute);
+        }
+
+        case ExpressionKind::CONDITIONAL: {
+            Value condition = evaluateNode(*expression.operands[0], doExecute, scope);
+            const bool holds = conditionHolds(condition, expression.op);
+            Value selected = evaluateNode(*expression.operands[holds ? 1 : 2], doExecute, scope);
+            return handleConditional(condition, selected, selected, expression.op, expression.elseOp);
+        }
+
+        case ExpressionKind::CALL: {
+            Value funcValue = lookup(expression.op, false, scope);
+
+            std::vector<Value> args;
+            args.reserve(expression.arguments.size());
+            for (const auto& argument : expression.arguments) {
+                args.push_back(evaluateNode(*argument, doExecute, scope));
+            }
+
+            position = expression.token;
+            if (funcValue.type == DataType::FUNCTION) {
+                return callFunction(funcValue, args, currentToken().start, doExecute);
+            }
+            return executeFunction(expression.op, args, currentToken().start, expression.builtin);
+        }
+
+        case ExpressionKind::MEMBER: {
+            std::vector<std::variant<std::string, size_t>> accessChain = {expression.op};
+            for (const auto& operand : expression.operands) {
+                Value key = evaluateNode(*operand, doExecute, scope);
+                if (key.type == DataType::STRING) {
+                    accessChain.push_back(key.string_value);
+                } else if (key.type == DataType::NUMBER) {
+                    accessChain.push_back(static_cast<size_t>(key.toNumber()));
+                } else {
+                    position = expression.token;
+                    throw std::runtime_error("Expected string or numeric index in bracket access, got <" + dataTypeToString(key.type) + "> at " + sourcePosition(currentToken().start) + ".");
+                }
+            }
+
+            Value root = lookup(expression.op, false, scope);
+            position = expression.token;
+            return resolvePropertyAccess(accessChain, root, expression.call, [&]() {
+                std::vector<Value> args;
+                args.reserve(expression.arguments.size());
+                for (const auto& argument : expression.arguments) {
+                    args.push_back(evaluateNode(*argument, doExecute, scope));
+                }
+                position = expression.token;
+                return args;
+            }, doExecute);
+        }
+
+        default:
+            throw std::runtime_error("Invalid expression kind \"" + expressionKindToString(expression.kind) + "\".");
+    }
+}
@@ -0,0 +1,87 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "parser.h"
+
+enum class ExpressionKind {
+    LITERAL     = 0,
+    VARIABLE    = 1,
+    UNARY       = 2,
+    BINARY      = 3,
+    CONDITIONAL = 4,
+    CALL        = 5,
+    MEMBER      = 6
+};
+
+inline std::string expressionKindToString(ExpressionKind kind) {
+    switch (kind) {
+        case ExpressionKind::LITERAL:     return "Literal";
+        case ExpressionKind::VARIABLE:    return "Variable";
+        case ExpressionKind::UNARY:       return "Unary";
+        case ExpressionKind::BINARY:      return "Binary";
+        case ExpressionKind::CONDITIONAL: return "Conditional";
+        case ExpressionKind::CALL:        return "Call";
+        case ExpressionKind::MEMBER:      return "Member";
+        default:                          return "invalid";
+    }
+};
+
+// Binary operator precedence, lowest first. Operators of one level are left-associative.
+enum OperatorLevel : size_t {
+    BITWISE_OR, BITWISE_XOR, BITWISE_AND, BITWISE_SHIFT, PIPELINE, COALESCING,
+    LOGICAL_OR, LOGICAL_XOR, LOGICAL_AND, LOGICAL_IMPLY,
+    EQUALITY, COMPARISON, TERM, FACTOR, POWER,
+    OPERATOR_LEVELS
+};
+
+// Precedence level of `token` as a binary operator, OPERATOR_LEVELS if it is not one
+size_t operatorLevel(const ParserToken& token);
+
+// Compiled once by Parser::compileExpression(), evaluated any number of times by Parser::evaluate().
+// `token` is the index (in the compiling parser's tokens) that the interpreter would be at when
+// producing this node's value; the evaluator moves there so positions in errors stay the same.
+struct Expression {
+    ExpressionKind kind;
+    std::string op;     // operator, variable name, callee or root of a member chain
+    std::string elseOp; // CONDITIONAL only
+    Value value;        // LITERAL only
+    std::vector<ExpressionPtr> operands;
+    std::vector<ExpressionPtr> arguments;
+    const BuiltinFunction* builtin; // CALL only, resolved when compiled
+    bool call;
+    bool foldedCall;    // LITERAL only, computed at compile time from a builtin call
+    size_t token;
+
+    Expression(ExpressionKind kind, size_t token) : kind(kind), builtin(nullptr), call(false), foldedCall(false), token(token) {}
+};
+
+#endif
@@ -39,7 +39,7 @@ SOFTWARE.
 #include "justo.hpp"
 #include <unordered_map>
 
-std::string Import::ReadFile(const std::string path, const std::string position, const bool isLink, const bool isImport) {
+std::string Import::ReadFile(const std::string& path, const std::string& position, const bool isLink, const bool isImport) {
     if (isLink) {
         return Utility::value2string(Fetch::request(path));
     } else {
@@ -55,22 +55,22 @@ std::string Import::ReadFile(const std::string path, const std::string position,
     }
 }
 
-std::pair<ParseResult, std::string> Import::JUSTC(const std::string path, const std::string position, const bool doExecute, const bool asynchronously, const bool allowJavaScript, const bool imports, const bool allowLuau, const bool isLink, const bool isString) {
+std::pair<ParseResult, std::string> Import::JUSTC(const std::string& path, const std::string& position, const bool doExecute, const bool asynchronously, const bool allowJavaScript, const bool imports, const bool allowLuau, const bool isLink, const bool isString) {
     std::string File = isString ? path : ReadFile(path, position, isLink, true);
     auto lexerResult = Lexer::parse(File);
-    return {Parser::parseTokens(lexerResult.second, doExecute, asynchronously, lexerResult.first, allowJavaScript, false, path, imports ? "module" : "script", allowLuau, false), File};
+    return {Parser::parseTokens(std::move(lexerResult.second), doExecute, asynchronously, std::move(lexerResult.first), allowJavaScript, false, path, imports ? "module" : "script", allowLuau, false), std::move(File)};
 }
 
-std::pair<Value, std::string> Import::JUSTO(const std::string path, const std::string position, const bool isLink, const bool isString, std::unordered_map<std::string, Value> justoPointers) {
+std::pair<Value, std::string> Import::JUSTO(const std::string& path, const std::string& position, const bool isLink, const bool isString, std::unordered_map<std::string, Value> justoPointers) {
     Value nanVal;
     nanVal.type = DataType::NOT_A_NUMBER;
     nanVal.name = "NaN";
-    justoPointers["nan"] = nanVal;
+    justoPointers["nan"] = std::move(nanVal);
 
     Value infVal;
     infVal.type = DataType::INFINITE;
     infVal.name = "Infinity";
-    justoPointers["inf"] = infVal;
+    justoPointers["inf"] = std::move(infVal);
 
     std::string File = isString ? path : ReadFile(path, position, isLink, true);
     JUSTO::JUSTOParser parser;
@@ -81,5 +81,5 @@ std::pair<Value, std::string> Import::JUSTO(const std::string path, const std::s
     if (parsed.type != DataType::JSON_OBJECT && parsed.type != DataType::JUSTC_OBJECT) {
         throw std::runtime_error("Import error: Cannot import non-object JUSTO \"" + path + "\" at " + position + ".");
     }
-    return {parsed, File};
+    return {std::move(parsed), std::move(File)};
 }
@@ -294,7 +294,7 @@ inline std::string valueToJUSTO(const Value& value) {
         case DataType::JSON_OBJECT: {
             std::string result = "o{";
             bool first = true;
-            for (const auto& [key, val] : value.properties) {
+            for (const auto& [key, val] : value.properties()) {
                 if (!first) result += ";";
                 first = false;
                 result += key + ":" + valueToJUSTO(val);
@@ -304,9 +304,9 @@ inline std::string valueToJUSTO(const Value& value) {
         }
         case DataType::JSON_ARRAY: {
             std::string result = "a[";
-            for (size_t i = 0; i < value.array_elements.size(); i++) {
+            for (size_t i = 0; i < value.array_elements().size(); i++) {
                 if (i > 0) result += ",";
-                result += valueToJUSTO(value.array_elements[i]);
+                result += valueToJUSTO(value.array_elements()[i]);
             }
             result += "]";
             return result;
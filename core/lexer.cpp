@@ -29,7 +29,8 @@ SOFTWARE.
 #include <stdexcept>
 #include <cctype>
 #include <algorithm>
-#include <regex>
+#include <string_view>
+#include <unordered_map>
 #include <string>
 #include <cstring>
 #include <sstream>
@@ -37,6 +38,25 @@ SOFTWARE.
 #include <iostream>
 #include <codecvt>
 #include <locale>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JUSTC_LEXER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// AVX2 is picked at run time where the compiler can target it per function, or always when the whole build targets it
+#if defined(__AVX2__)
+#define JUSTC_LEXER_AVX2
+#include <immintrin.h>
+#elif defined(JUSTC_LEXER_SSE2) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define JUSTC_LEXER_AVX2
+#define JUSTC_LEXER_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
 
 #ifdef __EMSCRIPTEN__
 #include "parser.h"
@@ -45,69 +65,412 @@ SOFTWARE.
 
 namespace {
     std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+
+    TokenKind wordType(std::string_view word) {
+        static const std::unordered_map<std::string_view, TokenKind> words = [] {
+            std::unordered_map<std::string_view, TokenKind> result;
+            for (const std::string& keyword : ::keywords) {
+                result.emplace(keyword, TokenKind::KEYWORD);
+            }
+            for (std::string_view keyword : {
+                "is", "isn't", "isif", "then", "elseif", "else", "isifn't", "elseifn't",
+                "then't", "elsen't", "or", "orn't", "and", "andn't", "not", "AND", "OR",
+                "XOR", "NOT", "nand", "nor", "xor", "imply", "nimply"
+            }) {
+                result.emplace(keyword, TokenKind::KEYWORD);
+            }
+            for (std::string_view boolean : {
+                "true", "True", "TRUE", "yes", "Yes", "YES", "false", "False", "FALSE",
+                "no", "No", "NO", "Y", "y", "N", "n"
+            }) {
+                result.emplace(boolean, TokenKind::BOOLEAN);
+            }
+            for (std::string_view null : {"null", "Null", "NULL", "nil", "Nil", "NIL"}) {
+                result.emplace(null, TokenKind::NULL_VALUE);
+            }
+            result.emplace("undefined", TokenKind::UNDEFINED);
+            return result;
+        }();
+
+        auto it = words.find(word);
+        return it != words.end() ? it->second : TokenKind::IDENTIFIER;
+    }
+
+    std::string warningPrefix() {
+        #ifndef __EMSCRIPTEN__
+        if (Utility::isGitHubActions()) {
+            return "::warning::";
+        }
+        #endif
+        return "";
+    }
+
+    // note: no token looks further ahead than this past the position it stops at
+    const size_t streamLookahead = 4;
+
+    const size_t checkpointInterval = 512;
+
+    // a streamed buffer drops the lines it is done with once they are at least this long
+    const size_t streamDropSize = 64 * 1024;
+
+    bool splitsUTF8(const std::string& str, size_t at) {
+        return at < str.length() && (static_cast<unsigned char>(str[at]) & 0xC0) == 0x80;
+    }
+
+    bool sameToken(const ParserToken& a, const ParserToken& b, std::ptrdiff_t shift) {
+        return a.kind == b.kind && a.start + shift == b.start && a.value == b.value;
+    }
+
+    size_t completeUTF8(const std::string& str) {
+        size_t end = str.length();
+        for (size_t i = 1; i <= 3 && i <= end; i++) {
+            unsigned char ch = static_cast<unsigned char>(str[end - i]);
+            if ((ch & 0xC0) != 0x80) {
+                size_t length = ch >= 0xF0 ? 4 : ch >= 0xE0 ? 3 : ch >= 0xC0 ? 2 : 1;
+                return length > i ? end - i : end;
+            }
+        }
+        return end;
+    }
+
+    #ifdef JUSTC_LEXER_AVX2
+    #ifdef JUSTC_LEXER_AVX2_DISPATCH
+    __attribute__((target("avx2")))
+    #endif
+    size_t asciiPrefixAVX2(const char* data, size_t size) {
+        size_t i = 0;
+        while (i + 64 <= size) {
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+            if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0) break;
+            i += 64;
+        }
+        while (i + 32 <= size && _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))) == 0) {
+            i += 32;
+        }
+        return i;
+    }
+
+    const bool hasAVX2 = [] {
+        #ifdef JUSTC_LEXER_AVX2_DISPATCH
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+        #else
+        return true;
+        #endif
+    }();
+    #endif
+
+    size_t asciiPrefix(const char* data, size_t size) {
+        size_t i = 0;
+        #ifdef JUSTC_LEXER_AVX2
+        if (hasAVX2) {
+            i = asciiPrefixAVX2(data, size);
+        }
+        #endif
+        #ifdef JUSTC_LEXER_SSE2
+        while (i + 16 <= size && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))) == 0) {
+            i += 16;
+        }
+        #endif
+        while (i + 8 <= size) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if (word & 0x8080808080808080ULL) break;
+            i += 8;
+        }
+        while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+            i++;
+        }
+        return i;
+    }
+
+    bool validUTF8(const char* data, size_t size) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        size_t i = 0;
+        while (i < size) {
+            i += asciiPrefix(data + i, size - i);
+            if (i == size) break;
+
+            unsigned char lead = bytes[i];
+            unsigned char low = 0x80, high = 0xBF;
+            size_t length;
+            if (lead >= 0xC2 && lead <= 0xDF) {
+                length = 2;
+            } else if (lead >= 0xE0 && lead <= 0xEF) {
+                length = 3;
+                if (lead == 0xE0) low = 0xA0; // overlong
+                if (lead == 0xED) high = 0x9F; // surrogates
+            } else if (lead >= 0xF0 && lead <= 0xF4) {
+                length = 4;
+                if (lead == 0xF0) low = 0x90; // overlong
+                if (lead == 0xF4) high = 0x8F; // above U+10FFFF
+            } else {
+                return false;
+            }
+
+            if (size - i < length || bytes[i + 1] < low || bytes[i + 1] > high) {
+                return false;
+            }
+            for (size_t j = 2; j < length; j++) {
+                if ((bytes[i + j] & 0xC0) != 0x80) return false;
+            }
+            i += length;
+        }
+        return true;
+    }
+
+    enum CharClass : unsigned char {
+        SPACE = 1,
+        WORD = 2
+    };
+
+    const std::array<unsigned char, 256> charClasses = [] {
+        std::array<unsigned char, 256> result{};
+        for (int ch = 0; ch < 256; ch++) {
+            if (std::isspace(ch)) result[ch] |= SPACE;
+            if (std::isalnum(ch) || ch == '_' || ch == '\'' || ch > 127) result[ch] |= WORD;
+        }
+        return result;
+    }();
+
+    bool hasClass(char ch, CharClass charClass) {
+        return charClasses[static_cast<unsigned char>(ch)] & charClass;
+    }
+
+    size_t skipClass(const std::string& str, size_t position, CharClass charClass) {
+        const size_t length = str.length();
+        while (position < length && hasClass(str[position], charClass)) {
+            position++;
+        }
+        return position;
+    }
+
+    // whitespace runs (indentation mostly) are skipped 16 bytes at a time
+    size_t skipSpace(const std::string& str, size_t position) {
+        #ifdef JUSTC_LEXER_SSE2
+        const size_t length = str.length();
+        while (position + 16 <= length) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + position));
+            __m128i control = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(chunk, _mm_set1_epi8('\r' + 1)));
+            unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(control, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '))))) & 0xFFFF;
+            if (mask != 0) {
+                #ifdef _MSC_VER
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return position + index;
+                #else
+                return position + __builtin_ctz(mask);
+                #endif
+            }
+            position += 16;
+        }
+        #endif
+        return skipClass(str, position, SPACE);
+    }
+
+    size_t findByte(const std::string& str, size_t position, char ch) {
+        if (position >= str.length()) return str.length();
+        const void* found = std::memchr(str.data() + position, ch, str.length() - position);
+        return found ? static_cast<const char*>(found) - str.data() : str.length();
+    }
+}
+
+TokenKind stringToTokenKind(const std::string& type) {
+    static const std::unordered_map<std::string, TokenKind> kinds = [] {
+        std::unordered_map<std::string, TokenKind> result;
+        for (uint8_t i = 0; i < static_cast<uint8_t>(TokenKind::SYMBOL); i++) {
+            TokenKind kind = static_cast<TokenKind>(i);
+            result.emplace(tokenKindToString(kind), kind);
+        }
+        return result;
+    }();
+
+    auto it = kinds.find(type);
+    return it != kinds.end() ? it->second : TokenKind::SYMBOL;
 }
 
-Lexer::Lexer(const std::string& input, const bool& warn) : input(input), warn(warn), position(0), dollarBefore(false) {
+Lexer::Lexer(SourceBuffer source, const bool& warn) : source(std::move(source)), input(*this->source), warn(warn), position(0), dollarBefore(false), depthPosition(0), braceDepth(0), bracketDepth(0), parenthesisDepth(0),
+    warnPrefix(warningPrefix()), finished(true), validated(0), emitted(0), reach(0), hasTokens(false),
+    consumed(0), consumedLines(0), lineScan(0), lineStart(0) {
     if (input.empty()) {
         throw std::invalid_argument("Invalid Input.");
     }
     if (!isValidUTF8(input)) {
         throw std::invalid_argument("Out of range. JUSTC supports only UTF-8.");
     }
-    initializeKeywords();
     tokenize();
 }
 
-bool Lexer::isValidUTF8(const std::string& str) {
-    try {
-        std::wstring wstr = converter.from_bytes(str);
-        return true;
-    } catch (...) {
-        return false;
+Lexer::Lexer(const std::string& input, const bool& warn) : Lexer(std::make_shared<const std::string>(input), warn) {}
+
+Lexer::Lexer(ChunkReader reader, const bool& warn) : buffer(std::make_shared<std::string>()), source(buffer), input(*source), warn(warn), position(0), dollarBefore(false), depthPosition(0), braceDepth(0), bracketDepth(0), parenthesisDepth(0),
+    warnPrefix(warningPrefix()), reader(std::move(reader)), finished(false), validated(0), emitted(0), reach(0), hasTokens(false),
+    consumed(0), consumedLines(0), lineScan(0), lineStart(0) {}
+
+Lexer::Lexer(SourceBuffer source, const LexerCheckpoint& checkpoint) : source(std::move(source)), input(*this->source), warn(false), position(checkpoint.position), dollarBefore(checkpoint.dollarBefore),
+    depthPosition(checkpoint.position), braceDepth(checkpoint.braceDepth), bracketDepth(checkpoint.bracketDepth), parenthesisDepth(checkpoint.parenthesisDepth),
+    warnPrefix(warningPrefix()), finished(true), validated(input.length()), emitted(0), reach(0), hasTokens(false),
+    consumed(0), consumedLines(0), lineScan(0), lineStart(0) {}
+
+bool Lexer::next(ParserToken& token) {
+    while (emitted == tokens.size()) {
+        tokens.clear();
+        emitted = 0;
+        if (buffer) dropConsumed();
+
+        if (finished && position >= input.length()) {
+            if (reader) {
+                reader = nullptr;
+                addDollarBefore();
+                if (hasTokens) {
+                    checkEnd(firstToken, lastToken);
+                }
+            }
+            return false;
+        }
+
+        if (!finished && (position + streamLookahead > validated || !tryStep())) {
+            readChunk();
+        } else if (finished) {
+            tryStep();
+        }
     }
+
+    token = std::move(tokens[emitted++]);
+    token.start += consumed;
+    return true;
 }
 
-std::string Lexer::toUTF8(const std::wstring& wstr) {
-    return converter.to_bytes(wstr);
+void Lexer::readChunk() {
+    std::string chunk;
+    if (!reader(chunk)) {
+        finished = true;
+        if (buffer->empty()) {
+            throw std::invalid_argument("Invalid Input.");
+        }
+    } else {
+        buffer->append(chunk);
+    }
+
+    size_t complete = finished ? buffer->length() : completeUTF8(*buffer);
+    if (complete > validated) {
+        if (!validUTF8(buffer->data() + validated, complete - validated)) {
+            throw std::invalid_argument("Out of range. JUSTC supports only UTF-8.");
+        }
+        validated = complete;
+    }
 }
 
-std::wstring Lexer::fromUTF8(const std::string& str) {
-    return converter.from_bytes(str);
+bool Lexer::tryStep() {
+    const size_t savedPosition = position;
+    const size_t savedTokens = tokens.size();
+    const size_t savedGotos = gotopos.size();
+    const bool savedDollarBefore = dollarBefore;
+    const size_t savedDepthPosition = depthPosition;
+    const int savedBraceDepth = braceDepth;
+    const int savedBracketDepth = bracketDepth;
+    const int savedParenthesisDepth = parenthesisDepth;
+
+    bool starved;
+    reach = 0;
+    try {
+        step();
+        starved = needsInput();
+    } catch (const std::exception&) {
+        // a token cut off by the end of the read input can fail to lex; it is lexed again with more input
+        if (!needsInput()) throw;
+        starved = true;
+    }
+
+    if (starved) {
+        position = savedPosition;
+        tokens.resize(savedTokens);
+        gotopos.resize(savedGotos);
+        dollarBefore = savedDollarBefore;
+        depthPosition = savedDepthPosition;
+        braceDepth = savedBraceDepth;
+        bracketDepth = savedBracketDepth;
+        parenthesisDepth = savedParenthesisDepth;
+        warnings.clear();
+        return false;
+    }
+
+    flushWarnings();
+    if (tokens.size() > savedTokens) {
+        if (!hasTokens) {
+            firstToken = tokens[savedTokens];
+            hasTokens = true;
+        }
+        lastToken = tokens.back();
+    }
+    return true;
 }
 
-bool Lexer::isUnicodeLetter(char ch) const {
-    return static_cast<unsigned char>(ch) > 127;
+// the last step looked at bytes that are not read yet, so it may lex differently once they are
+bool Lexer::needsInput() const {
+    return !finished && std::max(position, reach) + streamLookahead > validated;
 }
 
-bool Lexer::isIdentifierStart(char ch) const {
-    return isLetter(ch) || isUnicodeLetter(ch) || ch == '_';
+// drops the whole lines before the earliest byte still needed, so the buffer holds only what is being lexed;
+// after a goto the whole rest is kept, as it may jump back
+void Lexer::dropConsumed() {
+    if (!gotopos.empty()) return;
+    if (!dollarBefore) trackDepth();
+
+    size_t keep = std::min(position, depthPosition);
+    if (hasTokens) keep = std::min(keep, lastToken.start);
+    if (keep > 0) keep--; // one byte of lookbehind
+    if (keep < streamDropSize || keep * 2 < input.length()) return;
+
+    for (; lineScan < keep; lineScan++) {
+        if (input[lineScan] == '\n') lineStart = lineScan + 1;
+    }
+    const size_t cut = lineStart;
+    if (cut < streamDropSize || cut * 2 < input.length()) return;
+
+    consumedLines += Utility::pos(cut, input).first - 1;
+    buffer->erase(0, cut);
+    consumed += cut;
+    position -= cut;
+    validated -= cut;
+    depthPosition -= cut;
+    lastToken.start -= cut;
+    lineScan -= cut;
+    lineStart = 0;
 }
 
-bool Lexer::isIdentifierContinue(char ch) const {
-    return isIdentifierStart(ch) || isDigit(ch) || ch == '\'';
+std::string Lexer::where(size_t at) const {
+    if (consumed == 0) return Utility::position(at, input);
+    std::pair<size_t, size_t> pos = Utility::pos(at, input);
+    return "line " + std::to_string(consumedLines + pos.first) + ", column " + std::to_string(pos.second);
 }
 
-std::string Lexer::readUnicodeChar() {
-    if (position >= input.length()) return "";
+void Lexer::flushWarnings() {
+    for (const auto& warning : warnings) {
+        warning();
+    }
+    warnings.clear();
+}
 
-    char first = input[position];
+bool Lexer::isValidUTF8(const std::string& str) {
+    return validUTF8(str.data(), str.length());
+}
 
-    int charLen = 1;
-    if ((first & 0xE0) == 0xC0) charLen = 2;
-    else if ((first & 0xF0) == 0xE0) charLen = 3;
-    else if ((first & 0xF8) == 0xF0) charLen = 4;
+std::string Lexer::toUTF8(const std::wstring& wstr) {
+    return converter.to_bytes(wstr);
+}
 
-    if (position + charLen > input.length()) {
-        throw std::runtime_error("Encoding error: Invalid UTF-8 sequence at " + Utility::position(position, input) + ".");
-    }
+std::wstring Lexer::fromUTF8(const std::string& str) {
+    return converter.from_bytes(str);
+}
 
-    std::string result = input.substr(position, charLen);
-    position += charLen;
-    return result;
+bool Lexer::isUnicodeLetter(char ch) const {
+    return static_cast<unsigned char>(ch) > 127;
 }
 
-void Lexer::initializeKeywords() {
-    keywords = ::keywords;
+bool Lexer::isIdentifierStart(char ch) const {
+    return isLetter(ch) || isUnicodeLetter(ch) || ch == '_';
 }
 
 void Lexer::invalidInput() {
@@ -119,7 +482,7 @@ void Lexer::invalidUsage() {
 }
 
 bool Lexer::isWhitespace(char ch) const {
-    return std::isspace(static_cast<unsigned char>(ch));
+    return hasClass(ch, SPACE);
 }
 
 bool Lexer::isLetter(char ch) const {
@@ -147,9 +510,7 @@ char Lexer::peek(size_t offset) const {
 
 // single-line comment: -- comment
 void Lexer::readComment() {
-    while (position < input.length() && input[position] != '\n') {
-        position++;
-    }
+    position = findByte(input, position, '\n');
     if (position < input.length() && input[position] == '\n') {
         position++;
     }
@@ -164,11 +525,33 @@ void Lexer::readMultiLineComment() {
     }
 }
 
+TokenText Lexer::slice(size_t from, size_t length) const {
+    // a streamed buffer still grows and may move, so its tokens keep copies
+    if (buffer) return TokenText(input.substr(from, length));
+    return TokenText::slice(std::string_view(input).substr(from, length));
+}
+
 ParserToken Lexer::readString(char quote, bool raw) {
     size_t start = ++position;
+    size_t end = start;
+    while (end < input.length() && input[end] != quote && input[end] != '\\') {
+        end++;
+    }
+    if (end >= input.length() || input[end] == quote) {
+        position = end < input.length() ? end + 1 : end;
+        return ParserToken{TokenKind::STRING, slice(start, end - start), start};
+    }
+
     std::string value = "";
-    
     while (position < input.length()) {
+        size_t end = position;
+        while (end < input.length() && input[end] != quote && input[end] != '\\') {
+            end++;
+        }
+        value.append(input, position, end - position);
+        position = end;
+        if (position >= input.length()) break;
+
         char ch = input[position];
         
         if (ch == '\\' && position + 1 < input.length()) {
@@ -190,17 +573,32 @@ ParserToken Lexer::readString(char quote, bool raw) {
     }
     
     if (!raw) value = StringEscape::unescape(value);
-    return ParserToken{"string", value, start};
+    return ParserToken{TokenKind::STRING, value, start};
 }
 
 ParserToken Lexer::readLink() {
     size_t start = ++position;
-    std::string value = "";
-    while (position < input.length() && input[position] != '>') {
-        value += input[position++];
-    }
+    position = findByte(input, position, '>');
+    TokenText value = slice(start, position - start);
     position++;
-    return ParserToken{"link", value, start};
+    return ParserToken{TokenKind::LINK, value, start};
+}
+
+void Lexer::trackDepth() {
+    if (depthPosition > position) { // lgt
+        depthPosition = 0;
+        braceDepth = 0;
+        bracketDepth = 0;
+        parenthesisDepth = 0;
+    }
+    for (; depthPosition < position; depthPosition++) {
+        if (input[depthPosition] == '{') braceDepth++;
+        else if (input[depthPosition] == '}') braceDepth--;
+        else if (input[depthPosition] == '[') bracketDepth++;
+        else if (input[depthPosition] == ']') bracketDepth--;
+        else if (input[depthPosition] == '(') parenthesisDepth++;
+        else if (input[depthPosition] == ')') parenthesisDepth--;
+    }
 }
 
 ParserToken Lexer::readNumber() {
@@ -212,6 +610,7 @@ ParserToken Lexer::readNumber() {
     bool isB64 = false;
     bool enableType = false;
     bool allowCommaDecimal = true;
+    size_t commaDecimal = std::string::npos;
 
     enum class NumType {
         big,
@@ -225,18 +624,7 @@ ParserToken Lexer::readNumber() {
         {'e', NumType::exp},
     };
 
-    int braceDepth = 0;
-    int bracketDepth = 0;
-    int parenthesisDepth = 0;
-    for (size_t i = 0; i < position; i++) {
-        if (input[i] == '{') braceDepth++;
-        else if (input[i] == '}') braceDepth--;
-        else if (input[i] == '[') bracketDepth++;
-        else if (input[i] == ']') bracketDepth--;
-        else if (input[i] == '(') parenthesisDepth++;
-        else if (input[i] == ')') parenthesisDepth--;
-    }
-
+    trackDepth();
     if (braceDepth > 0 || bracketDepth > 0 || parenthesisDepth > 0) {
         allowCommaDecimal = false;
     }
@@ -292,7 +680,7 @@ ParserToken Lexer::readNumber() {
             if (ch == ',') {
                 if (!point && allowCommaDecimal) {
                     point = true;
-                    input[position] = '.';
+                    commaDecimal = position;
                 } else {
                     break;
                 }
@@ -313,43 +701,49 @@ ParserToken Lexer::readNumber() {
         }
     }
 
-    std::string numStr = input.substr(start, position - start);
-    numStr.erase(std::remove(numStr.begin(), numStr.end(), '_'), numStr.end());
-    std::string checkstr = numStr;
-    std::transform(checkstr.begin(), checkstr.end(), checkstr.begin(), ::tolower);
+    std::string_view numStr(input.data() + start, position - start);
+    std::string cleaned;
+    if (commaDecimal != std::string::npos || numStr.find('_') != std::string_view::npos) {
+        cleaned.assign(numStr);
+        if (commaDecimal != std::string::npos) {
+            cleaned[commaDecimal - start] = '.';
+        }
+        cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), '_'), cleaned.end());
+        numStr = cleaned;
+    }
+    const char first = numStr.empty() ? '\0' : numStr.front();
 
-    std::string type;
+    TokenKind kind;
     if (isBin) {
-        type = "binary";
+        kind = TokenKind::BINARY;
     } else if (isOct) {
-        type = "octal";
-    } else if (isHex || checkstr[0] == '#') {
-        type = "hex";
-    } else if (isB64 || checkstr[0] == '&') {
-        type = "base64";
+        kind = TokenKind::OCTAL;
+    } else if (isHex || first == '#') {
+        kind = TokenKind::HEX;
+    } else if (isB64 || first == '&') {
+        kind = TokenKind::BASE64;
     } else {
-        type = "number";
+        kind = TokenKind::NUMBER;
 
-        if (enableType && !checkstr.empty() && NumTypes.find(std::tolower(checkstr.back())) != NumTypes.end()) {
-            checkstr.pop_back();
-            numStr.pop_back();
+        if (enableType && !numStr.empty() && NumTypes.find(std::tolower(numStr.back())) != NumTypes.end()) {
+            numStr.remove_suffix(1);
             switch (numtype) {
                 case NumType::big:
-                    type = "big";
+                    kind = TokenKind::BIG;
                     break;
 
                 case NumType::int_:
-                    type = "int";
+                    kind = TokenKind::INT;
                     break;
 
                 case NumType::exp:
-                    type = "exp";
+                    kind = TokenKind::EXP;
                     break;
             }
         }
     }
 
-    ParserToken token(type, numStr, start);
+    ParserToken token(kind, cleaned.empty() ? slice(start, numStr.length()) : TokenText(std::string(numStr)), start);
     return token;
 }
 
@@ -361,48 +755,19 @@ ParserToken Lexer::readIdentifier() {
         start = position - 1;
     }
 
-    std::string id;
-    while (position < input.length()) {
-        char ch = input[position];
-
-        if (isIdentifierContinue(ch)) {
-            if (isUnicodeLetter(ch)) {
-                size_t before = position;
-                std::string unicodeChar = readUnicodeChar();
-                id += unicodeChar;
-            } else {
-                id += ch;
-                position++;
-            }
-        } else if (ch == ',' || ch == ';' || ch == '.' || ch == '=' || ch == ':' || ch == '-') {
-            break;
-        } else {
-            break;
-        }
-    }
+    size_t end = skipClass(input, position, WORD);
+    std::string_view id(input.data() + position, end - position);
+    TokenText text = slice(position, end - position);
+    position = end;
 
-    std::string idWithoutDollar = id;
+    std::string_view idWithoutDollar = id;
     if (!id.empty() && id[0] == '$') {
-        idWithoutDollar = id.substr(1);
-    }
-
-    if (std::find(keywords.begin(), keywords.end(), idWithoutDollar) != keywords.end()) {
-        return ParserToken{"keyword", id, start};
+        idWithoutDollar.remove_prefix(1);
     }
 
-    std::regex keyword_regex("^is$|^isn't$|^isif$|^then$|^elseif$|^else$|^isifn't$|^elseifn't$|^then't$|^elsen't$|^or$|^orn't$|^and$|^andn't$|^not$|^AND$|^OR$|^XOR$|^NOT$|^nand$|^nor$|^xor$|^imply$|^nimply$");
-    std::regex boolean_regex("^true$|^True$|^TRUE$|^yes$|^Yes$|^YES$|^false$|^False$|^FALSE$|^no$|^No$|^NO$|^Y$|^y$|^N$|^n$");
-    std::regex null_regex("^null$|^Null$|^NULL$|^nil$|^Nil$|^NIL$");
-    std::regex undefined_regex("^undefined$");
-
-    if (std::regex_match(idWithoutDollar, keyword_regex)) {
-        return ParserToken{"keyword", id, start};
-    } else if (std::regex_match(idWithoutDollar, boolean_regex)) {
-        return ParserToken{"boolean", id, start};
-    } else if (std::regex_match(idWithoutDollar, null_regex)) {
-        return ParserToken{"null", id, start};
-    } else if (std::regex_match(idWithoutDollar, undefined_regex)) {
-        return ParserToken{"undefined", id, start};
+    TokenKind kind = wordType(idWithoutDollar);
+    if (kind != TokenKind::IDENTIFIER) {
+        return ParserToken{kind, text, start};
     } else {
         bool isAllDigits = !id.empty();
         for (char c : id) {
@@ -413,9 +778,9 @@ ParserToken Lexer::readIdentifier() {
         }
 
         if (isAllDigits) {
-            return ParserToken{"number", id, start};
+            return ParserToken{TokenKind::NUMBER, text, start};
         } else {
-            return ParserToken{"identifier", id, start};
+            return ParserToken{TokenKind::IDENTIFIER, text, start};
         }
     }
 }
@@ -480,6 +845,7 @@ ParserToken Lexer::readJSXOpeningTag() {
     bool selfClosing = false;
     
     while (position < input.length() && peek() != '>' && peek() != '/') {
+        const size_t attributeStart = position;
         skipWhitespace();
         if (peek() == '/') {
             position++;
@@ -508,6 +874,7 @@ ParserToken Lexer::readJSXOpeningTag() {
         }
         
         skipWhitespace();
+        if (position == attributeStart) break; // neither an attribute nor the end of the tag, e.g. the end of input
     }
     
     if (!selfClosing && peek() == '>') {
@@ -531,7 +898,7 @@ ParserToken Lexer::readJSXOpeningTag() {
     
     if (selfClosing) {
         result += "[]}";
-        return ParserToken("jsx_element", result, start);
+        return ParserToken(TokenKind::JSX_ELEMENT, result, start);
     }
     
     std::string children;
@@ -562,7 +929,7 @@ ParserToken Lexer::readJSXOpeningTag() {
     }
     
     result += "[" + children + "]}";
-    return ParserToken("jsx_element", result, start);
+    return ParserToken(TokenKind::JSX_ELEMENT, result, start);
 }
 
 ParserToken Lexer::readJSX() {
@@ -570,7 +937,7 @@ ParserToken Lexer::readJSX() {
     position++;
     
     if (position >= input.length()) {
-        return ParserToken("error", "", start);
+        return ParserToken(TokenKind::INVALID, "", start);
     }
     
     if (peek() == '/') {
@@ -581,12 +948,12 @@ ParserToken Lexer::readJSX() {
             position++;
         }
         if (peek() == '>') position++;
-        return ParserToken("jsx_closing", tagName, start);
+        return ParserToken(TokenKind::JSX_CLOSING, tagName, start);
     }
     
     if (peek() == '>') {
         position++;
-        return ParserToken("jsx_fragment_open", "", start);
+        return ParserToken(TokenKind::JSX_FRAGMENT_OPEN, "", start);
     }
     
     return readJSXOpeningTag();
@@ -600,466 +967,668 @@ void Lexer::addDollarBefore() {
 }
 
 void Lexer::tokenize() {
-    std::string warnPrefix = "";
-    #ifndef __EMSCRIPTEN__
-    if (Utility::isGitHubActions()) {
-        warnPrefix = "::warning::";
-    }
-    #endif
     while (position < input.length()) {
-        char ch = input[position];
-
-        if (isWhitespace(ch)) {
-            addDollarBefore();
-            position++;
-            continue;
-        }
-
-        if (ch == '-' && peek() == '-') {
-            if ((isDigit(input[position - 1]) || isLetter(input[position - 1])) && (peek(2) == ',' || peek(2) == '.' || peek(2) == ')')) {
-                addDollarBefore();
-                tokens.push_back(ParserToken{"--", "--", position});
-                position += 2;
-                continue;
-            } else {
-                addDollarBefore();
-                readComment();
-                continue;
-            }
-        }
-        if (ch == '-' && peek() == '{') {
-            addDollarBefore();
-            readMultiLineComment();
-            continue;
-        }
-
-        if (ch == '/' && peek() == '/') {
-            if ((isDigit(input[position - 1]) || isLetter(input[position - 1])) && (peek(2) == ',' || peek(2) == '.' || peek(2) == ')')) {
-                addDollarBefore();
-                tokens.push_back(ParserToken{"//", "//", position});
-                position += 2;
-                continue;
-            } else {
-                addDollarBefore();
-                position += 2;
-                while (position < input.length() && input[position] != '\n') {
-                    position++;
-                }
-                if (position < input.length() && input[position] == '\n') {
-                    position++;
-                }
-                continue;
-            }
-        }
-        if (ch == '/' && peek() == '*') {
-            addDollarBefore();
-            position += 2;
-            while (position < input.length()) {
-                if (input[position] == '*' && peek() == '/') {
-                    position += 2;
-                    break;
-                }
-                position++;
-            }
-            continue;
-        }
-
-        if (ch == '"' || ch == '\'') {
-            addDollarBefore();
-            tokens.push_back(readString(ch, ch == '\''));
-            continue;
-        }
-
-        if (ch == '<' && peek() != '<' && peek() != '=') {
-            addDollarBefore();
-            tokens.push_back(readJSX());
-            continue;
-        }
+        step();
+        flushWarnings();
+    }
 
-        if (ch == 'l' && peek() == '<') {
-            addDollarBefore();
-            position++;
-            tokens.push_back(readLink());
-            continue;
-        }
+    addDollarBefore();
+}
 
-        if (ch == '=' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"==", "==", position});
-            position += 2;
-            continue;
-        }
+void Lexer::step() {
+    char ch = input[position];
 
-        if (ch == '?' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"?=", "?=", position});
-            position += 2;
-            continue;
-        }
+    if (isWhitespace(ch)) {
+        addDollarBefore();
+        position = skipSpace(input, position + 1);
+        return;
+    }
 
-        if (ch == '?' && peek() == '?') {
+    if (ch == '-' && peek() == '-') {
+        if (position > 0 && (isDigit(input[position - 1]) || isLetter(input[position - 1])) && (peek(2) == ',' || peek(2) == '.' || peek(2) == ')')) {
             addDollarBefore();
-            tokens.push_back(ParserToken{"??", "??", position});
+            tokens.push_back(ParserToken{TokenKind::MINUS_MINUS, slice(position, 2), position});
             position += 2;
-            continue;
-        }
-
-        if (ch == '?' && peek() == ':') {
+            return;
+        } else {
             addDollarBefore();
-            tokens.push_back(ParserToken{"?:", "?:", position});
-            position += 2;
-            continue;
+            readComment();
+            return;
         }
+    }
+    if (ch == '-' && peek() == '{') {
+        addDollarBefore();
+        readMultiLineComment();
+        return;
+    }
 
-        if (ch == '=' && peek() == '!') {
+    if (ch == '/' && peek() == '/') {
+        if (position > 0 && (isDigit(input[position - 1]) || isLetter(input[position - 1])) && (peek(2) == ',' || peek(2) == '.' || peek(2) == ')')) {
             addDollarBefore();
-            tokens.push_back(ParserToken{"=!", "=!", position});
+            tokens.push_back(ParserToken{TokenKind::SLASH_SLASH, slice(position, 2), position});
             position += 2;
-            continue;
-        }
-
-        if (ch == '?' && peek() == '!') {
+            return;
+        } else {
             addDollarBefore();
-            tokens.push_back(ParserToken{"?!", "?!", position});
             position += 2;
-            continue;
+            readComment();
+            return;
         }
-
-        if (ch == '!' && peek() == '?') {
-            if (peek(1) == '?') {
-                addDollarBefore();
-                tokens.push_back(ParserToken{"!??", "!??", position});
-                position += 3;
-            } else {
-                addDollarBefore();
-                tokens.push_back(ParserToken{"!?", "!?", position});
+    }
+    if (ch == '/' && peek() == '*') {
+        addDollarBefore();
+        position += 2;
+        while ((position = findByte(input, position, '*')) < input.length()) {
+            if (peek() == '/') {
                 position += 2;
+                break;
             }
-            continue;
+            position++;
         }
+        return;
+    }
 
-        if (ch == '.' && peek() == '.' && peek(2) == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"..=", "..=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '.' && peek() == '.' && (position + 2) < input.length()) {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"..", "..", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '"' || ch == '\'') {
+        addDollarBefore();
+        tokens.push_back(readString(ch, ch == '\''));
+        return;
+    }
 
-        if (ch == '<' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"<=", "<=", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '<' && peek() != '<' && peek() != '=') {
+        addDollarBefore();
+        tokens.push_back(readJSX());
+        return;
+    }
 
-        if (ch == '>' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{">=", ">=", position});
-            position += 2;
-            continue;
-        }
+    if (ch == 'l' && peek() == '<') {
+        addDollarBefore();
+        position++;
+        tokens.push_back(readLink());
+        return;
+    }
 
-        if (ch == '!' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"!=", "!=", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '=' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::EQUAL_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '|' && peek() == '|' && peek(2) == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"||=", "||=", position});
-            position += 3;
-            continue;
-        }
-        if (ch == '|' && peek() == '|') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"||", "||", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '?' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::QUESTION_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '|' && peek() == '>') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"|>", "|>", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '?' && peek() == '?') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::QUESTION_QUESTION, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '!' && peek() == '|' && peek(2) == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"!|=", "!|=", position});
-            position += 3;
-            continue;
-        }
-        if (ch == '!' && peek() == '|') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"!|", "!|", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '?' && peek() == ':') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::QUESTION_COLON, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '&' && peek() == '&' && peek(2) == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"&&=", "&&=", position});
-            position += 3;
-            continue;
-        }
-        if (ch == '&' && peek() == '&') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"&&", "&&", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '=' && peek() == '!') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::EQUAL_BANG, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '?' && peek() == '!') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::QUESTION_BANG, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '!' && peek() == '&' && peek(2) == '=') {
+    if (ch == '!' && peek() == '?') {
+        if (peek(1) == '?') {
             addDollarBefore();
-            tokens.push_back(ParserToken{"!&=", "!&=", position});
+            tokens.push_back(ParserToken{TokenKind::BANG_QUESTION_QUESTION, slice(position, 3), position});
             position += 3;
-            continue;
-        }
-        if (ch == '!' && peek() == '&') {
+        } else {
             addDollarBefore();
-            tokens.push_back(ParserToken{"!&", "!&", position});
+            tokens.push_back(ParserToken{TokenKind::BANG_QUESTION, slice(position, 2), position});
             position += 2;
-            continue;
         }
+        return;
+    }
 
-        if (isDigit(ch) || (
-            ch == '#' && isDigit(peek())
-        )) {
-            addDollarBefore();
-            tokens.push_back(readNumber());
-            continue;
-        }
-        if (ch == '#' && peek() == '&' && isDigit(peek(2))) {
-            addDollarBefore();
-            position++;
-            tokens.push_back(readNumber());
-            continue;
-        }
+    if (ch == '.' && peek() == '.' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::DOT_DOT_EQUAL, slice(position, 3), position});
+        position += 2;
+        return;
+    }
+    if (ch == '.' && peek() == '.' && (position + 2) < input.length()) {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::DOT_DOT, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if ((ch == 'l' || ch == 'j' || ch == 'c' || ch == 'o') && (peek() == '"' || peek() == '\'')) {
-            addDollarBefore();
-            char qch = peek();
-            position++;
-            ParserToken str = readString(qch, qch == '\'');
-            std::string type = ch == 'l' ? "Luau" : ch == 'j' ? "JavaScript" : ch == 'c' ? "JUSTC" : "JUSTO";
-            tokens.push_back(ParserToken{type, str.value, str.start});
-            if (warn) {
-                #ifdef __EMSCRIPTEN__
-                warn_lexer_lang(Parser::getCurrentTimestamp().c_str(), Utility::position(position, input).c_str(), type.c_str());
-                #else
-                std::cout << warnPrefix + "Warning: " + type + " may be corrupted in the lexer output." << std::endl;
-                #endif
-            }
-            continue;
-        }
+    if (ch == '<' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::LESS_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == ',' || ch == '.' || ch == '[' || ch == ']' ||
-            ch == '(' || ch == ')' || ch == '{' || ch == '}') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{std::string(1, ch), std::string(1, ch), position});
-            position++;
-            continue;
-        }
+    if (ch == '>' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::GREATER_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (isIdentifierStart(ch)) {
-            const ParserToken currToken = readIdentifier();
-            const size_t currPos = position;
-
-            if (currToken.type == "keyword") {
-                if (currToken.value == "lgt") {
-                    if (std::find(gotopos.begin(), gotopos.end(), currPos) != gotopos.end()) {
-                        #ifdef __EMSCRIPTEN__
-                        warn_lexer_goto(Parser::getCurrentTimestamp().c_str(), Utility::position(position, input).c_str());
-                        #else
-                        std::cout << warnPrefix + "Warning: Found goto loop at " + Utility::position(position, input) + "." << std::endl;
-                        #endif
-                        continue;
-                    }
-                    gotopos.push_back(currPos);
-                    try {
-                        while(position < input.length() &&
-                            isWhitespace(input[position]))
-                        {
-                            position++;
-                        }
-
-                        ParserToken target = readNumber();
-                        position = static_cast<size_t>(std::stod(target.value));
-
-                        continue;
-                    } catch (...) {
-                        throw std::runtime_error("Invalid goto usage at " + Utility::position(position, input) + ".");
+    if (ch == '!' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::BANG_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '|' && peek() == '|' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PIPE_PIPE_EQUAL, slice(position, 3), position});
+        position += 3;
+        return;
+    }
+    if (ch == '|' && peek() == '|') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PIPE_PIPE, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '|' && peek() == '>') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PIPE_GREATER, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '!' && peek() == '|' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::BANG_PIPE_EQUAL, slice(position, 3), position});
+        position += 3;
+        return;
+    }
+    if (ch == '!' && peek() == '|') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::BANG_PIPE, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '&' && peek() == '&' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::AMP_AMP_EQUAL, slice(position, 3), position});
+        position += 3;
+        return;
+    }
+    if (ch == '&' && peek() == '&') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::AMP_AMP, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (ch == '!' && peek() == '&' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::BANG_AMP_EQUAL, slice(position, 3), position});
+        position += 3;
+        return;
+    }
+    if (ch == '!' && peek() == '&') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::BANG_AMP, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+
+    if (isDigit(ch) || (
+        ch == '#' && isDigit(peek())
+    )) {
+        addDollarBefore();
+        tokens.push_back(readNumber());
+        return;
+    }
+    if (ch == '#' && peek() == '&' && isDigit(peek(2))) {
+        addDollarBefore();
+        position++;
+        tokens.push_back(readNumber());
+        return;
+    }
+
+    if ((ch == 'l' || ch == 'j' || ch == 'c' || ch == 'o') && (peek() == '"' || peek() == '\'')) {
+        addDollarBefore();
+        char qch = peek();
+        position++;
+        ParserToken str = readString(qch, qch == '\'');
+        std::string type = ch == 'l' ? "Luau" : ch == 'j' ? "JavaScript" : ch == 'c' ? "JUSTC" : "JUSTO";
+        tokens.push_back(ParserToken{stringToTokenKind(type), str.value, str.start});
+        if (warn) {
+            #ifdef __EMSCRIPTEN__
+            std::string at = where(position);
+            warnings.push_back([at, type] {
+                warn_lexer_lang(Parser::getCurrentTimestamp().c_str(), at.c_str(), type.c_str());
+            });
+            #else
+            std::string message = warnPrefix + "Warning: " + type + " may be corrupted in the lexer output.";
+            warnings.push_back([message] {
+                std::cout << message << std::endl;
+            });
+            #endif
+        }
+        return;
+    }
+
+    if (ch == ',' || ch == '.' || ch == '[' || ch == ']' ||
+        ch == '(' || ch == ')' || ch == '{' || ch == '}') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{stringToTokenKind(std::string(1, ch)), slice(position, 1), position});
+        position++;
+        return;
+    }
+
+    if (isIdentifierStart(ch)) {
+        const ParserToken currToken = readIdentifier();
+        const size_t currPos = position;
+
+        if (currToken.kind == TokenKind::KEYWORD) {
+            if (currToken.value == "lgt") {
+                if (std::find(gotopos.begin(), gotopos.end(), currPos) != gotopos.end()) {
+                    #ifdef __EMSCRIPTEN__
+                    std::string at = where(position);
+                    warnings.push_back([at] {
+                        warn_lexer_goto(Parser::getCurrentTimestamp().c_str(), at.c_str());
+                    });
+                    #else
+                    std::string message = warnPrefix + "Warning: Found goto loop at " + where(position) + ".";
+                    warnings.push_back([message] {
+                        std::cout << message << std::endl;
+                    });
+                    #endif
+                    return;
+                }
+                gotopos.push_back(currPos);
+                try {
+                    while(position < input.length() &&
+                        isWhitespace(input[position]))
+                    {
+                        position++;
                     }
+
+                    ParserToken target = readNumber();
+                    reach = position;
+                    size_t to = static_cast<size_t>(std::stod(target.value.str()));
+                    if (consumed > 0 && to < consumed + position) invalidUsage(); // a streamed buffer only jumps forward once it dropped lines
+                    position = to - consumed;
+
+                    return;
+                } catch (...) {
+                    throw std::runtime_error("Invalid goto usage at " + where(position) + ".");
                 }
             }
-
-            tokens.push_back(currToken);
-            continue;
         }
 
-        if (ch == '-') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"minus", "-", position});
-            position++;
-            continue;
-        }
+        tokens.push_back(currToken);
+        return;
+    }
 
-        if (ch == '$') {
-            dollarBefore = true;
-            position++;
-            continue;
-        }
+    if (ch == '-') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::MINUS, slice(position, 1), position});
+        position++;
+        return;
+    }
 
-        if (ch == '<' && peek() == '<') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"<<", "<<", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '$') {
+        dollarBefore = true;
+        position++;
+        return;
+    }
 
-        if (ch == '>' && peek() == '>') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{">>", ">>", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '<' && peek() == '<') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::LESS_LESS, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '*' && peek() == '*' && peek(2) == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"**=", "**=", position});
-            position += 3;
-            continue;
-        }
-        if (ch == '*' && peek() == '*') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"**", "**", position});
-            position += 2;
-            continue;
-        }
-        
-        if (ch == '+' && peek() == '+') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"++", "++", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '+' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"+=", "+=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '-' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"-=", "-=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '/' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"/=", "/=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '*' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"*=", "*=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '&' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"&=", "&=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '|' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"|=", "|=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '^' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"^=", "^=", position});
-            position += 2;
-            continue;
-        }
-        if (ch == '%' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"%=", "%=", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '>' && peek() == '>') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::GREATER_GREATER, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '=' || ch == '?' || ch == '!' || ch == '<' ||
-            ch == '>' || ch == '|' || ch == '&' || ch == '+' ||
-            ch == '*' || ch == '/' || ch == '%' || ch == '^') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{std::string(1, ch), std::string(1, ch), position});
-            position++;
-            continue;
-        }
+    if (ch == '*' && peek() == '*' && peek(2) == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::STAR_STAR_EQUAL, slice(position, 3), position});
+        position += 3;
+        return;
+    }
+    if (ch == '*' && peek() == '*') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::STAR_STAR, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    
+    if (ch == '+' && peek() == '+') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PLUS_PLUS, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '+' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PLUS_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '-' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::MINUS_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '/' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::SLASH_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '*' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::STAR_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '&' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::AMP_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '|' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PIPE_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '^' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::CARET_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
+    if (ch == '%' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::PERCENT_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == ':' && peek() == ':') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"::", "::", position});
-            position += 2;
-            continue;
-        }
+    if (ch == '=' || ch == '?' || ch == '!' || ch == '<' ||
+        ch == '>' || ch == '|' || ch == '&' || ch == '+' ||
+        ch == '*' || ch == '/' || ch == '%' || ch == '^') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{stringToTokenKind(std::string(1, ch)), slice(position, 1), position});
+        position++;
+        return;
+    }
 
-        if (ch == '~' && peek() == '=') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"~=", "~=", position});
-            position += 2;
-            continue;
-        }
+    if (ch == ':' && peek() == ':') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::COLON_COLON, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '~') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"~", "~", position});
-            position++;
-            continue;
-        }
+    if (ch == '~' && peek() == '=') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::TILDE_EQUAL, slice(position, 2), position});
+        position += 2;
+        return;
+    }
 
-        if (ch == '^') {
-            addDollarBefore();
-            tokens.push_back(ParserToken{"^", "^", position});
-            position++;
-            continue;
-        }
+    if (ch == '~') {
+        addDollarBefore();
+        tokens.push_back(ParserToken{TokenKind::TILDE, slice(position, 1), position});
+        position++;
+        return;
+    }
 
+    if (ch == '^') {
         addDollarBefore();
-        tokens.push_back(ParserToken{std::string(1, ch), std::string(1, ch), position});
+        tokens.push_back(ParserToken{TokenKind::CARET, slice(position, 1), position});
         position++;
+        return;
     }
 
     addDollarBefore();
+    tokens.push_back(ParserToken{stringToTokenKind(std::string(1, ch)), slice(position, 1), position});
+    position++;
+}
+
+void Lexer::checkEnd(const ParserToken& first, const ParserToken& last) const {
+    if (last.kind != TokenKind::DOT && last.value != "." && !(
+        (first.kind == TokenKind::LEFT_BRACE && last.kind == TokenKind::RIGHT_BRACE) ||
+        (first.kind == TokenKind::LEFT_BRACKET && last.kind == TokenKind::RIGHT_BRACKET)
+    )) {
+        throw std::runtime_error("Expected \".\", got EOF at " + where(last.start));
+    }
 }
 
 std::vector<ParserToken> Lexer::getTokens() const {
     if (!tokens.empty()) {
-        const auto& lastToken = tokens.back();
-        if (lastToken.type != "." && lastToken.value != "." && !(
-            (tokens[0].type == "{" && lastToken.type == "}") ||
-            (tokens[0].type == "[" && lastToken.type == "]")
-        )) {
-            throw std::runtime_error("Expected \".\", got EOF at " + Utility::position(lastToken.start, input));
+        checkEnd(tokens.front(), tokens.back());
+    }
+    // the copies may outlive this lexer and its buffer; Lexer::parse() hands out both instead
+    std::vector<ParserToken> result = tokens;
+    for (ParserToken& token : result) {
+        token.value.detach();
+    }
+    return result;
+}
+
+std::pair<SourceBuffer, std::vector<ParserToken>> Lexer::parse(SourceBuffer source, const bool& warn) {
+    Lexer lexer(source, warn);
+    if (!lexer.tokens.empty()) {
+        lexer.checkEnd(lexer.tokens.front(), lexer.tokens.back());
+    }
+    return std::make_pair(std::move(source), std::move(lexer.tokens));
+}
+
+std::pair<SourceBuffer, std::vector<ParserToken>> Lexer::parse(const std::string& input, const bool& warn) {
+    return parse(std::make_shared<const std::string>(input), warn);
+}
+
+size_t Lexer::relexFrom(std::vector<LexerCheckpoint>& checkpoints, const std::vector<LexerCheckpoint>& previous, size_t candidate, std::ptrdiff_t shift, size_t syncAfter, size_t firstToken) {
+    size_t nextCheckpoint = position;
+    while (position < input.length()) {
+        if (position > syncAfter && gotopos.empty()) {
+            while (candidate < previous.size() && previous[candidate].position + shift < position) {
+                candidate++;
+            }
+            if (candidate < previous.size() && previous[candidate].position + shift == position && previous[candidate].dollarBefore == dollarBefore) {
+                trackDepth();
+                const LexerCheckpoint& checkpoint = previous[candidate];
+                if (checkpoint.braceDepth == braceDepth && checkpoint.bracketDepth == bracketDepth && checkpoint.parenthesisDepth == parenthesisDepth) {
+                    return candidate;
+                }
+            }
+        }
+        if (position >= nextCheckpoint) {
+            trackDepth();
+            checkpoints.push_back(LexerCheckpoint{position, firstToken + tokens.size(), dollarBefore, braceDepth, bracketDepth, parenthesisDepth});
+            nextCheckpoint = position + checkpointInterval;
         }
+        step();
     }
-    return tokens;
+
+    addDollarBefore();
+    return previous.size();
+}
+
+namespace {
+    // overwrites what overlaps, so the tail only moves when the count changes
+    template<class T>
+    void replaceRange(std::vector<T>& target, size_t first, size_t last, std::vector<T>& items) {
+        const size_t common = std::min(last - first, items.size());
+        std::move(items.begin(), items.begin() + common, target.begin() + first);
+        if (items.size() > common) {
+            target.insert(target.begin() + first + common, std::make_move_iterator(items.begin() + common), std::make_move_iterator(items.end()));
+        } else {
+            target.erase(target.begin() + first + common, target.begin() + last);
+        }
+    }
+}
+
+void LexedDocument::assign(size_t first, size_t last, std::vector<LexerCheckpoint> checkpoints, std::vector<ParserToken> tokens, size_t firstToken) {
+    std::vector<std::vector<ParserToken>> fresh(checkpoints.size());
+    for (size_t i = 0; i < checkpoints.size(); i++) {
+        size_t from = checkpoints[i].tokens - firstToken;
+        size_t to = i + 1 < checkpoints.size() ? checkpoints[i + 1].tokens - firstToken : tokens.size();
+        fresh[i].assign(std::make_move_iterator(tokens.begin() + from), std::make_move_iterator(tokens.begin() + to));
+        for (ParserToken& token : fresh[i]) {
+            token.start -= checkpoints[i].position;
+            token.value.detach();
+        }
+    }
+
+    replaceRange(this->checkpoints, first, last, checkpoints);
+    replaceRange(segments, first, last, fresh);
+}
+
+std::vector<ParserToken> LexedDocument::tokens(size_t first, size_t last) const {
+    std::vector<ParserToken> result;
+    for (size_t i = first; i < last && i < segments.size(); i++) {
+        for (const ParserToken& token : segments[i]) {
+            result.push_back(token);
+            result.back().start += checkpoints[i].position;
+        }
+    }
+    return result;
+}
+
+std::vector<ParserToken> LexedDocument::tokens() const {
+    return tokens(0, segments.size());
+}
+
+LexedDocument Lexer::lexDocument(std::string text) {
+    auto source = std::make_shared<std::string>(std::move(text));
+    if (source->empty()) {
+        throw std::invalid_argument("Invalid Input.");
+    }
+    if (!isValidUTF8(*source)) {
+        throw std::invalid_argument("Out of range. JUSTC supports only UTF-8.");
+    }
+
+    LexedDocument document;
+    std::vector<LexerCheckpoint> checkpoints;
+    Lexer lexer(source, LexerCheckpoint{});
+    lexer.relexFrom(checkpoints, {}, 0, 0, std::string::npos, 0);
+    document.source = std::move(source);
+    document.assign(0, 0, std::move(checkpoints), std::move(lexer.tokens), 0);
+    document.jumps = !lexer.gotopos.empty();
+    return document;
 }
 
-std::pair<std::string, std::vector<ParserToken>> Lexer::parse(const std::string& input, const bool& warn) {
-    Lexer lexer(input, warn);
-    return std::make_pair(input, lexer.getTokens());
+TokenDelta Lexer::relex(LexedDocument& document, size_t offset, size_t removed, const std::string& inserted) {
+    std::string& text = *document.source;
+    if (offset > text.length() || removed > text.length() - offset) {
+        throw std::out_of_range("Edit out of range.");
+    }
+    if (!isValidUTF8(inserted) || splitsUTF8(text, offset) || splitsUTF8(text, offset + removed)) {
+        throw std::invalid_argument("Out of range. JUSTC supports only UTF-8.");
+    }
+
+    // the segments own their text, so the buffer can be spliced in place
+    text.replace(offset, removed, inserted);
+    SourceBuffer source = document.source;
+
+    const std::ptrdiff_t shift = static_cast<std::ptrdiff_t>(inserted.length()) - static_cast<std::ptrdiff_t>(removed);
+    const size_t editEnd = offset + inserted.length();
+    const std::vector<LexerCheckpoint>& previous = document.checkpoints;
+
+    // restart from the last checkpoint whose lookahead could not have reached the edit
+    size_t restart = 0;
+    if (!document.jumps && !previous.empty()) {
+        restart = std::partition_point(previous.begin() + 1, previous.end(), [offset](const LexerCheckpoint& checkpoint) {
+            return checkpoint.position + streamLookahead <= offset;
+        }) - previous.begin() - 1;
+    }
+    const size_t candidate = document.jumps ? previous.size() : std::partition_point(previous.begin(), previous.end(), [offset, removed](const LexerCheckpoint& checkpoint) {
+        return checkpoint.position < offset + removed;
+    }) - previous.begin();
+
+    std::vector<LexerCheckpoint> checkpoints;
+    LexerCheckpoint start = restart < previous.size() ? previous[restart] : LexerCheckpoint{};
+    size_t synced = previous.size();
+    std::vector<ParserToken> relexed;
+    bool jumps = false;
+    try {
+        if (source->empty()) {
+            throw std::invalid_argument("Invalid Input.");
+        }
+        Lexer lexer(source, start);
+        synced = lexer.relexFrom(checkpoints, previous, candidate, shift, editEnd, start.tokens);
+        if (!lexer.gotopos.empty() && start.position != 0) {
+            checkpoints.clear();
+            restart = 0;
+            start = LexerCheckpoint{};
+            Lexer full(source, start);
+            full.relexFrom(checkpoints, {}, 0, 0, std::string::npos, 0);
+            synced = previous.size();
+            lexer.tokens = std::move(full.tokens);
+            lexer.gotopos = std::move(full.gotopos);
+        }
+        relexed = std::move(lexer.tokens);
+        jumps = !lexer.gotopos.empty();
+    } catch (...) {
+        document = LexedDocument{document.source, {}, {}, false};
+        throw;
+    }
+
+    const std::vector<ParserToken> replaced = document.tokens(restart, synced);
+    const std::ptrdiff_t tokenShift = static_cast<std::ptrdiff_t>(relexed.size()) - static_cast<std::ptrdiff_t>(replaced.size());
+    size_t from = 0, to = relexed.size();
+    size_t first = 0, end = replaced.size();
+    while (from < to && first < end && sameToken(replaced[first], relexed[from], 0)) {
+        first++;
+        from++;
+    }
+    while (from < to && first < end && sameToken(replaced[end - 1], relexed[to - 1], shift)) {
+        end--;
+        to--;
+    }
+
+    TokenDelta delta;
+    delta.first = start.tokens + first;
+    delta.removed = end - first;
+    delta.inserted.assign(relexed.begin() + from, relexed.begin() + to);
+    for (ParserToken& token : delta.inserted) {
+        token.value.detach();
+    }
+    delta.shift = shift;
+
+    for (size_t i = synced; i < previous.size(); i++) {
+        document.checkpoints[i].position += shift;
+        document.checkpoints[i].tokens += tokenShift;
+    }
+    document.assign(restart, synced, std::move(checkpoints), std::move(relexed), start.tokens);
+    document.jumps = jumps;
+    return delta;
 }
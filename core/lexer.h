@@ -28,38 +28,341 @@ SOFTWARE.
 #define LEXER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 #include <unordered_map>
 #include <memory>
+#include <functional>
 #include <codecvt>
 #include <locale>
 #include "keywords.h"
 
+enum class TokenKind : uint8_t {
+    STRING,
+    LINK,
+    PATH,
+    NUMBER,
+    BIG,
+    INT,
+    EXP,
+    HEX,
+    BINARY,
+    OCTAL,
+    BASE64,
+    KEYWORD,
+    BOOLEAN,
+    NULL_VALUE,
+    UNDEFINED,
+    IDENTIFIER,
+    MINUS,
+    JSX_ELEMENT,
+    JSX_CLOSING,
+    JSX_FRAGMENT_OPEN,
+    INVALID,
+    LUAU,
+    JAVASCRIPT,
+    JUSTC,
+    JUSTO,
+    END_OF_FILE,
+    EQUAL_EQUAL,
+    QUESTION_EQUAL,
+    QUESTION_QUESTION,
+    QUESTION_COLON,
+    EQUAL_BANG,
+    QUESTION_BANG,
+    BANG_QUESTION_QUESTION,
+    BANG_QUESTION,
+    DOT_DOT_EQUAL,
+    DOT_DOT,
+    LESS_EQUAL,
+    GREATER_EQUAL,
+    BANG_EQUAL,
+    PIPE_PIPE_EQUAL,
+    PIPE_PIPE,
+    PIPE_GREATER,
+    BANG_PIPE_EQUAL,
+    BANG_PIPE,
+    AMP_AMP_EQUAL,
+    AMP_AMP,
+    BANG_AMP_EQUAL,
+    BANG_AMP,
+    LESS_LESS,
+    GREATER_GREATER,
+    STAR_STAR_EQUAL,
+    STAR_STAR,
+    PLUS_PLUS,
+    PLUS_EQUAL,
+    MINUS_EQUAL,
+    SLASH_EQUAL,
+    STAR_EQUAL,
+    AMP_EQUAL,
+    PIPE_EQUAL,
+    CARET_EQUAL,
+    PERCENT_EQUAL,
+    COLON_COLON,
+    TILDE_EQUAL,
+    MINUS_MINUS,
+    SLASH_SLASH,
+    COMMA,
+    DOT,
+    SEMICOLON,
+    COLON,
+    LEFT_PAREN,
+    RIGHT_PAREN,
+    LEFT_BRACKET,
+    RIGHT_BRACKET,
+    LEFT_BRACE,
+    RIGHT_BRACE,
+    EQUAL,
+    QUESTION,
+    BANG,
+    LESS,
+    GREATER,
+    PIPE,
+    AMP,
+    PLUS,
+    DASH,
+    STAR,
+    SLASH,
+    PERCENT,
+    CARET,
+    TILDE,
+    HASH,
+    SYMBOL
+};
+
+inline std::string tokenKindToString(TokenKind kind) {
+    switch (kind) {
+        case TokenKind::STRING:                 return "string";
+        case TokenKind::LINK:                   return "link";
+        case TokenKind::PATH:                   return "path";
+        case TokenKind::NUMBER:                 return "number";
+        case TokenKind::BIG:                    return "big";
+        case TokenKind::INT:                    return "int";
+        case TokenKind::EXP:                    return "exp";
+        case TokenKind::HEX:                    return "hex";
+        case TokenKind::BINARY:                 return "binary";
+        case TokenKind::OCTAL:                  return "octal";
+        case TokenKind::BASE64:                 return "base64";
+        case TokenKind::KEYWORD:                return "keyword";
+        case TokenKind::BOOLEAN:                return "boolean";
+        case TokenKind::NULL_VALUE:             return "null";
+        case TokenKind::UNDEFINED:              return "undefined";
+        case TokenKind::IDENTIFIER:             return "identifier";
+        case TokenKind::MINUS:                  return "minus";
+        case TokenKind::JSX_ELEMENT:            return "jsx_element";
+        case TokenKind::JSX_CLOSING:            return "jsx_closing";
+        case TokenKind::JSX_FRAGMENT_OPEN:      return "jsx_fragment_open";
+        case TokenKind::INVALID:                return "error";
+        case TokenKind::LUAU:                   return "Luau";
+        case TokenKind::JAVASCRIPT:             return "JavaScript";
+        case TokenKind::JUSTC:                  return "JUSTC";
+        case TokenKind::JUSTO:                  return "JUSTO";
+        case TokenKind::END_OF_FILE:            return "EOF";
+        case TokenKind::EQUAL_EQUAL:            return "==";
+        case TokenKind::QUESTION_EQUAL:         return "?=";
+        case TokenKind::QUESTION_QUESTION:      return "??";
+        case TokenKind::QUESTION_COLON:         return "?:";
+        case TokenKind::EQUAL_BANG:             return "=!";
+        case TokenKind::QUESTION_BANG:          return "?!";
+        case TokenKind::BANG_QUESTION_QUESTION: return "!??";
+        case TokenKind::BANG_QUESTION:          return "!?";
+        case TokenKind::DOT_DOT_EQUAL:          return "..=";
+        case TokenKind::DOT_DOT:                return "..";
+        case TokenKind::LESS_EQUAL:             return "<=";
+        case TokenKind::GREATER_EQUAL:          return ">=";
+        case TokenKind::BANG_EQUAL:             return "!=";
+        case TokenKind::PIPE_PIPE_EQUAL:        return "||=";
+        case TokenKind::PIPE_PIPE:              return "||";
+        case TokenKind::PIPE_GREATER:           return "|>";
+        case TokenKind::BANG_PIPE_EQUAL:        return "!|=";
+        case TokenKind::BANG_PIPE:              return "!|";
+        case TokenKind::AMP_AMP_EQUAL:          return "&&=";
+        case TokenKind::AMP_AMP:                return "&&";
+        case TokenKind::BANG_AMP_EQUAL:         return "!&=";
+        case TokenKind::BANG_AMP:               return "!&";
+        case TokenKind::LESS_LESS:              return "<<";
+        case TokenKind::GREATER_GREATER:        return ">>";
+        case TokenKind::STAR_STAR_EQUAL:        return "**=";
+        case TokenKind::STAR_STAR:              return "**";
+        case TokenKind::PLUS_PLUS:              return "++";
+        case TokenKind::PLUS_EQUAL:             return "+=";
+        case TokenKind::MINUS_EQUAL:            return "-=";
+        case TokenKind::SLASH_EQUAL:            return "/=";
+        case TokenKind::STAR_EQUAL:             return "*=";
+        case TokenKind::AMP_EQUAL:              return "&=";
+        case TokenKind::PIPE_EQUAL:             return "|=";
+        case TokenKind::CARET_EQUAL:            return "^=";
+        case TokenKind::PERCENT_EQUAL:          return "%=";
+        case TokenKind::COLON_COLON:            return "::";
+        case TokenKind::TILDE_EQUAL:            return "~=";
+        case TokenKind::MINUS_MINUS:            return "--";
+        case TokenKind::SLASH_SLASH:            return "//";
+        case TokenKind::COMMA:                  return ",";
+        case TokenKind::DOT:                    return ".";
+        case TokenKind::SEMICOLON:              return ";";
+        case TokenKind::COLON:                  return ":";
+        case TokenKind::LEFT_PAREN:             return "(";
+        case TokenKind::RIGHT_PAREN:            return ")";
+        case TokenKind::LEFT_BRACKET:           return "[";
+        case TokenKind::RIGHT_BRACKET:          return "]";
+        case TokenKind::LEFT_BRACE:             return "{";
+        case TokenKind::RIGHT_BRACE:            return "}";
+        case TokenKind::EQUAL:                  return "=";
+        case TokenKind::QUESTION:               return "?";
+        case TokenKind::BANG:                   return "!";
+        case TokenKind::LESS:                   return "<";
+        case TokenKind::GREATER:                return ">";
+        case TokenKind::PIPE:                   return "|";
+        case TokenKind::AMP:                    return "&";
+        case TokenKind::PLUS:                   return "+";
+        case TokenKind::DASH:                   return "-";
+        case TokenKind::STAR:                   return "*";
+        case TokenKind::SLASH:                  return "/";
+        case TokenKind::PERCENT:                return "%";
+        case TokenKind::CARET:                  return "^";
+        case TokenKind::TILDE:                  return "~";
+        case TokenKind::HASH:                   return "#";
+        default:                                return "";
+    }
+};
+
+TokenKind stringToTokenKind(const std::string& type);
+
+using SourceBuffer = std::shared_ptr<const std::string>;
+using ChunkReader = std::function<bool(std::string& chunk)>;
+
+// Text of a token. The lexer hands out slices of the SourceBuffer it read, so they are only valid
+// while that buffer is; text that is not in the source as is (unescaped strings, values set by
+// the parser) is owned by the token and kept in a short string where it fits. The text is read
+// through view() or copied with str(), so a copy never loses the string it owns.
+class TokenText {
+public:
+    TokenText() = default;
+    TokenText(std::string text) : owned(std::move(text)) {}
+    TokenText(const char* text) : owned(text) {}
+
+    static TokenText slice(std::string_view text) {
+        TokenText result;
+        result.borrowed = text;
+        return result;
+    }
+
+    std::string_view view() const {
+        return borrowed.data() ? borrowed : std::string_view(owned);
+    }
+    std::string str() const {
+        return std::string(view());
+    }
+    bool empty() const {
+        return view().empty();
+    }
+    size_t size() const {
+        return view().size();
+    }
+    size_t length() const {
+        return view().length();
+    }
+    // gives a slice its own copy, so it can outlive the buffer it was cut from
+    void detach() {
+        if (borrowed.data()) *this = TokenText(str());
+    }
+
+    friend bool operator==(const TokenText& left, const TokenText& right) { return left.view() == right.view(); }
+    friend bool operator==(const TokenText& left, std::string_view right) { return left.view() == right; }
+    friend bool operator==(std::string_view left, const TokenText& right) { return left == right.view(); }
+    friend bool operator==(const TokenText& left, const std::string& right) { return left.view() == right; }
+    friend bool operator==(const std::string& left, const TokenText& right) { return left == right.view(); }
+    friend bool operator==(const TokenText& left, const char* right) { return left.view() == right; }
+    friend bool operator!=(const TokenText& left, const TokenText& right) { return !(left == right); }
+    friend bool operator!=(const TokenText& left, std::string_view right) { return !(left == right); }
+    friend bool operator!=(const TokenText& left, const std::string& right) { return !(left == right); }
+    friend bool operator!=(const TokenText& left, const char* right) { return !(left == right); }
+
+private:
+    std::string_view borrowed;
+    std::string owned;
+};
+
+inline std::string operator+(const std::string& left, const TokenText& right) {
+    std::string result;
+    result.reserve(left.length() + right.length());
+    return result.append(left).append(right.view());
+}
+inline std::string operator+(std::string&& left, const TokenText& right) {
+    return std::move(left.append(right.view()));
+}
+inline std::string operator+(const char* left, const TokenText& right) {
+    return std::string(left).append(right.view());
+}
+inline std::string operator+(const TokenText& left, const std::string& right) {
+    return left.str().append(right);
+}
+inline std::string operator+(const TokenText& left, const char* right) {
+    return left.str().append(right);
+}
+
 struct ParserToken {
-    std::string type;
-    std::string value;
+    TokenKind kind;
+    TokenText value;
     size_t start;
 
-    ParserToken() : type(""), value(""), start(0) {}
-    ParserToken(const std::string& t, const std::string& v, size_t s)
-        : type(t), value(v), start(s) {}
+    ParserToken() : kind(TokenKind::SYMBOL), start(0) {}
+    ParserToken(TokenKind k, TokenText v, size_t s)
+        : kind(k), value(std::move(v)), start(s) {}
+
+    std::string type() const {
+        return kind == TokenKind::SYMBOL ? value.str() : tokenKindToString(kind);
+    }
+};
+
+struct LexerCheckpoint {
+    size_t position = 0;
+    size_t tokens = 0;
+    bool dollarBefore = false;
+    int braceDepth = 0;
+    int bracketDepth = 0;
+    int parenthesisDepth = 0;
+};
+
+// tokens are kept per checkpoint with starts relative to it, so an edit only touches the segments it re-lexes;
+// their text is owned, as edits are spliced into the source in place
+struct LexedDocument {
+    std::shared_ptr<std::string> source;
+    std::vector<LexerCheckpoint> checkpoints;
+    std::vector<std::vector<ParserToken>> segments;
+    bool jumps = false;
+
+    std::vector<ParserToken> tokens() const;
+    std::vector<ParserToken> tokens(size_t first, size_t last) const;
+    void assign(size_t first, size_t last, std::vector<LexerCheckpoint> checkpoints, std::vector<ParserToken> tokens, size_t firstToken);
+};
+
+// tokens [first, first + removed) were replaced by inserted; every token after them moved by shift
+struct TokenDelta {
+    size_t first = 0;
+    size_t removed = 0;
+    std::vector<ParserToken> inserted;
+    std::ptrdiff_t shift = 0;
 };
 
 class Lexer {
 private:
-    std::string input;
+    std::shared_ptr<std::string> buffer;
+    SourceBuffer source;
+    const std::string& input;
     bool warn;
     size_t position;
     std::vector<ParserToken> tokens;
 
-    std::vector<std::string> keywords;
     std::unordered_map<std::string, std::string> smallkeywords;
     std::unordered_map<std::string, std::string> bigkeywords;
     std::vector<std::string> skw;
     std::vector<std::string> bkw;
     std::vector<size_t> gotopos;
 
-    void initializeKeywords();
     bool isWhitespace(char ch) const;
     bool isLetter(char ch) const;
     bool isDigit(char ch) const;
@@ -68,10 +371,9 @@ private:
 
     bool isUnicodeLetter(char ch) const;
     bool isIdentifierStart(char ch) const;
-    bool isIdentifierContinue(char ch) const;
-    std::string readUnicodeChar();
 
     char peek(size_t offset = 1) const;
+    TokenText slice(size_t from, size_t length) const;
     void readComment();
     void readMultiLineComment();
     ParserToken readString(char quote, bool raw = false);
@@ -79,6 +381,7 @@ private:
     ParserToken readNumber();
     ParserToken readIdentifier();
     void tokenize();
+    void step();
 
     void invalidInput();
     void invalidUsage();
@@ -93,10 +396,49 @@ private:
     bool isJSXIdentifier(char ch) const;
     void skipWhitespace();
 
+    size_t depthPosition;
+    int braceDepth;
+    int bracketDepth;
+    int parenthesisDepth;
+    void trackDepth();
+    void checkEnd(const ParserToken& first, const ParserToken& last) const;
+
+    std::string warnPrefix;
+    std::vector<std::function<void()>> warnings;
+    void flushWarnings();
+
+    ChunkReader reader;
+    bool finished;
+    size_t validated;
+    size_t emitted;
+    size_t reach;
+    bool hasTokens;
+    ParserToken firstToken;
+    ParserToken lastToken;
+    size_t consumed;
+    size_t consumedLines;
+    size_t lineScan;
+    size_t lineStart;
+    void readChunk();
+    bool needsInput() const;
+    bool tryStep();
+    void dropConsumed();
+    std::string where(size_t at) const;
+
+    Lexer(SourceBuffer source, const LexerCheckpoint& checkpoint);
+    size_t relexFrom(std::vector<LexerCheckpoint>& checkpoints, const std::vector<LexerCheckpoint>& previous, size_t candidate, std::ptrdiff_t shift, size_t syncAfter, size_t firstToken);
+
 public:
+    Lexer(SourceBuffer source, const bool& warn);
     Lexer(const std::string& input, const bool& warn);
+    Lexer(ChunkReader reader, const bool& warn);
+    bool next(ParserToken& token);
     std::vector<ParserToken> getTokens() const;
-    static std::pair<std::string, std::vector<ParserToken>> parse(const std::string& input, const bool& warn = false);
+    static std::pair<SourceBuffer, std::vector<ParserToken>> parse(SourceBuffer source, const bool& warn = false);
+    static std::pair<SourceBuffer, std::vector<ParserToken>> parse(const std::string& input, const bool& warn = false);
+
+    static LexedDocument lexDocument(std::string source);
+    static TokenDelta relex(LexedDocument& document, size_t offset, size_t removed, const std::string& inserted);
 
     static bool isValidUTF8(const std::string& str);
     static std::string toUTF8(const std::wstring& wstr);
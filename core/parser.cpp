@@ -51,8 +51,11 @@ SOFTWARE.
 #include <cstdint>
 #include <limits>
 #include "cpptypes.h"
+#include "expression.h"
 #include <iomanip>
 #include <functional>
+#include <utility>
+#include <mutex>
 
 #ifdef __SIZEOF_FLOAT128__
     #if JUSTC_HAS_QUADMATH
@@ -175,7 +178,7 @@ std::string Value::toString() const {
         case DataType::FUNCTION: {
             std::stringstream ae;
             bool first = true;
-            for (Value val : array_elements) {
+            for (const Value& val : array_elements()) {
                 if (!first) ae << ", ";
                 std::string td = dataTypeToTypeDecl(val.type);
                 ae << val.name;
@@ -185,11 +188,11 @@ std::string Value::toString() const {
             
             std::stringstream args;
             first = true;
-            for (size_t i = 0; i < function_info.paramNames.size(); i++) {
-                std::string arg = function_info.paramNames[i];
+            for (size_t i = 0; i < function_info().paramNames.size(); i++) {
+                std::string arg = function_info().paramNames[i];
                 if (!first) args << ", ";
-                std::string td = dataTypeToTypeDecl(function_info.paramTypes[i]);
-                Value dv = function_info.defaultValues[i];
+                std::string td = dataTypeToTypeDecl(function_info().paramTypes[i]);
+                Value dv = function_info().defaultValues[i];
 
                 args << arg;
                 if (td != "auto") args << " : " << td;
@@ -199,9 +202,9 @@ std::string Value::toString() const {
             }
 
             return std::string(
-                function_info.isIsolated ? "isolated " : ""
+                function_info().isIsolated ? "isolated " : ""
             ) + "function " + name + (
-                array_elements.size() > 0 ? " [" + ae.str() + "] " : ""
+                array_elements().size() > 0 ? " [" + ae.str() + "] " : ""
             ) + "(" + args.str() + ") {" + string_value + "}";
         }
         default:
@@ -371,7 +374,7 @@ Value Value::createOctal(double num) {
 Value Value::createBinaryData(const std::vector<unsigned char>& data) {
     Value result;
     result.type = DataType::BINARY_DATA;
-    result.binary_data = data;
+    result.mutableData().binary_data = data;
     result.name = "[BinaryData size=" + std::to_string(data.size()) + "]";
     return result;
 }
@@ -379,7 +382,7 @@ Value Value::createBinaryData(const std::vector<unsigned char>& data) {
 Value Value::createJustcObject(const std::shared_ptr<ObjectContext>& context) {
     Value result;
     result.type = DataType::JUSTC_OBJECT;
-    result.object_context = context;
+    result.mutableData().object_context = context;
     result.object_type = DataType::JUSTC_OBJECT;
     result.name = "[Object]";
     return result;
@@ -389,7 +392,7 @@ Value Value::createJsonObject(const std::unordered_map<std::string, Value>& obj)
     Value result;
     result.type = DataType::JSON_OBJECT;
     result.object_type = DataType::JSON_OBJECT;
-    result.properties = obj;
+    result.mutableData().properties = obj;
     result.name = "[Object]";
     return result;
 }
@@ -398,7 +401,7 @@ Value Value::createJsonArray(const std::vector<Value>& arr) {
     Value result;
     result.type = DataType::JSON_ARRAY;
     result.object_type = DataType::JSON_ARRAY;
-    result.array_elements = arr;
+    result.mutableData().array_elements = arr;
     result.name = "[Array]";
     return result;
 }
@@ -409,66 +412,61 @@ Value Value::createNumberWithType(T num, NumericType numType) {
     result.type = DataType::NUMBER;
     result.number_value = static_cast<double>(num);
     
-    result.numeric_data = std::make_shared<NumericValue>();
-    result.numeric_data->value = static_cast<double>(num);
-    result.numeric_data->type = numType;
+    NumericValue& numeric = result.numeric_data;
+    numeric.type = numType;
     
-    size_t size = NumericValue::getTypeSize(numType);
-    result.numeric_data->data = malloc(size);
-    if (static_cast<bool>(result.numeric_data->data)) {
-        switch (numType) {
-            case NumericType::FLOAT32:
-                *(float*)result.numeric_data->data = static_cast<float>(num);
-                break;
-            case NumericType::FLOAT64:
-                *(double*)result.numeric_data->data = static_cast<double>(num);
-                break;
-            case NumericType::BIGNUM:
-                *(long double*)result.numeric_data->data = static_cast<long double>(num);
-                break;
-            #if JUSTC_FLOAT128_SUPPORT
-            case NumericType::FLOAT128:
-                *(__float128*)result.numeric_data->data = static_cast<__float128>(num);
-                break;
-            #endif
-            case NumericType::INT8:
-                *(int8_t*)result.numeric_data->data = static_cast<int8_t>(num);
-                break;
-            case NumericType::INT16:
-                *(int16_t*)result.numeric_data->data = static_cast<int16_t>(num);
-                break;
-            case NumericType::INT32:
-                *(int32_t*)result.numeric_data->data = static_cast<int32_t>(num);
-                break;
-            case NumericType::INT64:
-                *(int64_t*)result.numeric_data->data = static_cast<int64_t>(num);
-                break;
-            #if JUSTC_INT128_SUPPORT
-            case NumericType::INT128:
-                *(__int128*)result.numeric_data->data = static_cast<__int128>(num);
-                break;
-            #endif
-            #if JUSTC_UINT128_SUPPORT
-            case NumericType::UINT128:
-                *(unsigned __int128*)result.numeric_data->data = static_cast<unsigned __int128>(num);
-                break;
-            #endif
-            case NumericType::UINT8: case NumericType::CUINT8:
-                *(uint8_t*)result.numeric_data->data = static_cast<uint8_t>(num);
-                break;
-            case NumericType::UINT16: case NumericType::CUINT16:
-                *(uint16_t*)result.numeric_data->data = static_cast<uint16_t>(num);
-                break;
-            case NumericType::UINT32: case NumericType::CUINT32:
-                *(uint32_t*)result.numeric_data->data = static_cast<uint32_t>(num);
-                break;
-            case NumericType::UINT64: case NumericType::CUINT64:
-                *(uint64_t*)result.numeric_data->data = static_cast<uint64_t>(num);
-                break;
-            default:
-                *(double*)result.numeric_data->data = static_cast<double>(num);
-                break;
-        }
+    switch (numType) {
+        case NumericType::FLOAT32:
+            numeric.store(static_cast<float>(num));
+            break;
+        case NumericType::FLOAT64:
+            numeric.store(static_cast<double>(num));
+            break;
+        case NumericType::BIGNUM:
+            numeric.store(static_cast<long double>(num));
+            break;
+        #if JUSTC_FLOAT128_SUPPORT
+        case NumericType::FLOAT128:
+            numeric.store(static_cast<__float128>(num));
+            break;
+        #endif
+        case NumericType::INT8:
+            numeric.store(static_cast<int8_t>(num));
+            break;
+        case NumericType::INT16:
+            numeric.store(static_cast<int16_t>(num));
+            break;
+        case NumericType::INT32:
+            numeric.store(static_cast<int32_t>(num));
+            break;
+        case NumericType::INT64:
+            numeric.store(static_cast<int64_t>(num));
+            break;
+        #if JUSTC_INT128_SUPPORT
+        case NumericType::INT128:
+            numeric.store(static_cast<__int128>(num));
+            break;
+        #endif
+        #if JUSTC_UINT128_SUPPORT
+        case NumericType::UINT128:
+            numeric.store(static_cast<unsigned __int128>(num));
+            break;
+        #endif
+        case NumericType::UINT8: case NumericType::CUINT8:
+            numeric.store(static_cast<uint8_t>(num));
+            break;
+        case NumericType::UINT16: case NumericType::CUINT16:
+            numeric.store(static_cast<uint16_t>(num));
+            break;
+        case NumericType::UINT32: case NumericType::CUINT32:
+            numeric.store(static_cast<uint32_t>(num));
+            break;
+        case NumericType::UINT64: case NumericType::CUINT64:
+            numeric.store(static_cast<uint64_t>(num));
+            break;
+        default:
+            numeric.store(static_cast<double>(num));
+            break;
     }
 
     result.name = result.toNumericString();
@@ -498,36 +496,37 @@ template Value Value::createNumberWithType<__float128>(__float128, NumericType);
 #endif
 
 std::string Value::toNumericString() const {
-    if (!static_cast<bool>(numeric_data)) {
+    const NumericValue& numeric = numeric_data;
+    if (!static_cast<bool>(numeric)) {
         return Utility::doubleToString(number_value);
     }
     
     std::stringstream ss;
-    switch (numeric_data->type) {
+    switch (numeric.type) {
         case NumericType::FLOAT32:
-            ss << std::setprecision(7) << *(float*)numeric_data->data;
+            ss << std::setprecision(7) << numeric.get<float>();
             break;
         case NumericType::FLOAT64:
-            ss << std::setprecision(15) << *(double*)numeric_data->data;
+            ss << std::setprecision(15) << numeric.get<double>();
             break;
         case NumericType::BIGNUM:
-            ss << std::setprecision(18) << *(long double*)numeric_data->data;
+            ss << std::setprecision(18) << numeric.get<long double>();
             break;
         case NumericType::INT8:
-            ss << (int)*(int8_t*)numeric_data->data;
+            ss << (int)numeric.get<int8_t>();
             break;
         case NumericType::INT16:
-            ss << *(int16_t*)numeric_data->data;
+            ss << numeric.get<int16_t>();
             break;
         case NumericType::INT32:
-            ss << *(int32_t*)numeric_data->data;
+            ss << numeric.get<int32_t>();
             break;
         case NumericType::INT64:
-            ss << *(int64_t*)numeric_data->data;
+            ss << numeric.get<int64_t>();
             break;
         #if JUSTC_INT128_SUPPORT
         case NumericType::INT128: {
-            __int128 val = *(const __int128*)numeric_data->data;
+            __int128 val = numeric.get<__int128>();
             if (val < 0) {
                 ss << "-";
                 val = -val;
@@ -548,7 +547,7 @@ std::string Value::toNumericString() const {
         #endif
         #if JUSTC_UINT128_SUPPORT
         case NumericType::UINT128: {
-            unsigned __int128 val = *(const unsigned __int128*)numeric_data->data;
+            unsigned __int128 val = numeric.get<unsigned __int128>();
             if (val == 0) {
                 ss << "0";
             } else {
@@ -564,30 +563,30 @@ std::string Value::toNumericString() const {
         }
         #endif
         case NumericType::UINT8: case NumericType::CUINT8:
-            ss << (unsigned int)*(uint8_t*)numeric_data->data;
+            ss << (unsigned int)numeric.get<uint8_t>();
             break;
         case NumericType::UINT16: case NumericType::CUINT16:
-            ss << *(uint16_t*)numeric_data->data;
+            ss << numeric.get<uint16_t>();
             break;
         case NumericType::UINT32: case NumericType::CUINT32:
-            ss << *(uint32_t*)numeric_data->data;
+            ss << numeric.get<uint32_t>();
             break;
         case NumericType::UINT64: case NumericType::CUINT64:
-            ss << *(uint64_t*)numeric_data->data;
+            ss << numeric.get<uint64_t>();
             break;
         case NumericType::FLOAT128: {
             #if JUSTC_FLOAT128_SUPPORT
                 char buffer[64];
                 quadmath_snprintf(buffer, sizeof(buffer), "%.20Qe", 
-                                *(const __float128*)numeric_data->data);
+                                numeric.get<__float128>());
                 ss << buffer;
             #else
-                ss << std::setprecision(18) << *(long double*)numeric_data->data;
+                ss << std::setprecision(18) << numeric.get<long double>();
             #endif
             break;
         }
         default:
-            ss << numeric_data->value;
+            ss << number_value;
             break;
     }
     return ss.str();
@@ -666,6 +665,14 @@ long getCurrentTime() {
 }
 
 void Parser::builtinObject(const std::string& name, std::unordered_map<std::string, Value> props) {
+    variables[name] = builtinObjectValue(name, std::move(props));
+    constVars[name] = true;
+}
+void Parser::builtinObject(const std::string& name) {
+    variables[name] = tables.builtinObjects.at(name);
+    constVars[name] = true;
+}
+Value Parser::builtinObjectValue(const std::string& name, std::unordered_map<std::string, Value> props) {
     auto objCtx = std::make_shared<ObjectContext>();
     std::vector<std::string> outputVars;
     for (const auto& [key, value] : props) {
@@ -673,13 +680,12 @@ void Parser::builtinObject(const std::string& name, std::unordered_map<std::stri
         outputVars.push_back(key);
     }
     objCtx->outputMode = "specified";
-    objCtx->outputVariables = outputVars;
+    objCtx->outputVariables = std::move(outputVars);
     Value objVal = Value::createJustcObject(objCtx);
     objVal.name = name;
-    objVal.properties = props;
+    objVal.mutableData().properties = std::move(props);
     objVal.type = DataType::JSON_OBJECT;
-    variables[name] = objVal;
-    constVars[name] = true;
+    return objVal;
 }
 Value Parser::builtinObjectFunction(const std::string& name) {
     Value funcVal;
@@ -691,24 +697,212 @@ Value Parser::builtinObjectFunction(const std::string& name) {
     return funcVal;
 }
 
+const RuntimeTables& RuntimeTables::getInstance() {
+    static const RuntimeTables instance = [] {
+        RuntimeTables tables;
+        tables.builtins.insert(::builtins.begin(), ::builtins.end());
+        tables.cpptypes.insert(::cpptypes.begin(), ::cpptypes.end());
+        tables.cppnumbers.insert(::cppnumbers.begin(), ::cppnumbers.end());
+        Parser::registerBuiltinFunctions(tables.builtinFunctions);
+
+        // built-in spaces / type methods
+
+        tables.typeMethods[DataType::JUSTC_OBJECT] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::NUMBER] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::STRING] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+
+            {"Reverse", "String::Reverse"},
+            {"GraphemeReverse", "String::GraphemeReverse"},
+            {"CodePointReverse", "String::CodePointReverse"},
+            {"ByteReverse", "String::ByteReverse"},
+            {"Trim", "String::Trim"},
+            {"Repeat", "String::Repeat"},
+            {"Slice", "String::Slice"},
+            {"GraphemeSlice", "String::GraphemeSlice"},
+            {"CodePointSlice", "String::CodePointSlice"},
+            {"ByteSlice", "String::ByteSlice"},
+            {"Lower", "String::Lower"},
+            {"Upper", "String::Upper"},
+            {"NormalizeNFC", "String::NormalizeNFC"},
+            {"NormalizeNFD", "String::NormalizeNFD"},
+            {"NormalizeNFKC", "String::NormalizeNFKC"},
+            {"NormalizeNFKD", "String::NormalizeNFKD"},
+            {"Length", "String::Length"},
+            {"GraphemeLength", "String::GraphemeLength"},
+            {"CodePointLength", "String::CodePointLength"},
+            {"ByteLength", "String::ByteLength"},
+            {"Size", "String::Size"},
+            {"EqualsIgnoreCase", "String::EqualsIgnoreCase"},
+            {"IsWhitespace", "String::IsWhitespace"},
+            {"StartsWith", "String::StartsWith"},
+            {"EndsWith", "String::EndsWith"},
+            {"Split", "String::Split"}
+        };
+        tables.typeMethods[DataType::LINK] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::BOOLEAN] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::JSON_OBJECT] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::JSON_ARRAY] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+
+            {"Join", "Array::Join"},
+            {"Includes", "Array::Includes"},
+            {"IndexOf", "Array::IndexOf"},
+            {"LastIndexOf", "Array::LastIndexOf"},
+            {"Reverse", "Array::Reverse"},
+            {"ForEach", "Array::ForEach"}
+        };
+        tables.typeMethods[DataType::NULL_TYPE] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::FUNCTION] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::NOT_A_NUMBER] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+        tables.typeMethods[DataType::INFINITE] = {
+            {"ToString", "String"},
+            {"ToNumber", "Number"},
+            {"ToInt", "ParseInt"},
+            {"ToLink", "Link"},
+        };
+
+        // built-in objects that do not depend on the parser
+
+        std::unordered_map<std::string, Value> justcProperties;
+        justcProperties["Version"] = Value::createString(JUSTC_VERSION);
+        justcProperties["Parse"] = Parser::builtinObjectFunction("JUSTC.Parse");
+        justcProperties["Execute"] = Parser::builtinObjectFunction("JUSTC.Execute");
+        justcProperties["Stringify"] = Parser::builtinObjectFunction("JUSTC.Stringify");
+        justcProperties["Parser"] = Parser::builtinObjectFunction("JUSTC.Parser");
+        justcProperties["Lexer"] = Parser::builtinObjectFunction("JUSTC.Lexer");
+        tables.builtinObjects["JUSTC"] = Parser::builtinObjectValue("JUSTC", std::move(justcProperties));
+
+        std::unordered_map<std::string, Value> jsonProperties;
+        jsonProperties["Parse"] = Parser::builtinObjectFunction("JSON.Parse");
+        jsonProperties["Stringify"] = Parser::builtinObjectFunction("JSON.Stringify");
+        tables.builtinObjects["JSON"] = Parser::builtinObjectValue("JSON", std::move(jsonProperties));
+
+        std::unordered_map<std::string, Value> justoProperties;
+        justoProperties["Version"] = Value::createString(JUSTC_VERSION);
+        justoProperties["Parse"] = Parser::builtinObjectFunction("JUSTO.Parse");
+        justoProperties["Stringify"] = Parser::builtinObjectFunction("JUSTO.Stringify");
+        tables.builtinObjects["JUSTO"] = Parser::builtinObjectValue("JUSTO", std::move(justoProperties));
+
+        std::unordered_map<std::string, Value> mathProperties;
+        mathProperties["Abs"]       = Parser::builtinObjectFunction("Math.Abs");
+        mathProperties["Acos"]      = Parser::builtinObjectFunction("Math.Acos");
+        mathProperties["Asin"]      = Parser::builtinObjectFunction("Math.Asin");
+        mathProperties["Atan"]      = Parser::builtinObjectFunction("Math.Atan");
+        mathProperties["Atan2"]     = Parser::builtinObjectFunction("Math.Atan2");
+        mathProperties["Ceil"]      = Parser::builtinObjectFunction("Math.Ceil");
+        mathProperties["Cos"]       = Parser::builtinObjectFunction("Math.Cos");
+        mathProperties["Clamp"]     = Parser::builtinObjectFunction("Math.Clamp");
+        mathProperties["Cube"]      = Parser::builtinObjectFunction("Math.Cube");
+        mathProperties["Double"]    = Parser::builtinObjectFunction("Math.Double");
+        mathProperties["E"]         = Parser::numberToValue(Math::E);
+        mathProperties["Exp"]       = Parser::builtinObjectFunction("Math.Exp");
+        mathProperties["Factorial"] = Parser::builtinObjectFunction("Math.Factorial");
+        mathProperties["Floor"]     = Parser::builtinObjectFunction("Math.Floor");
+        mathProperties["Hypot"]     = Parser::builtinObjectFunction("Math.Hypot");
+        mathProperties["IsPrime"]   = Parser::builtinObjectFunction("Math.IsPrime");
+        mathProperties["Lerp"]      = Parser::builtinObjectFunction("Math.Lerp");
+        mathProperties["LN2"]       = Parser::numberToValue(Math::LN2);
+        mathProperties["LN10"]      = Parser::numberToValue(Math::LN10);
+        mathProperties["Log"]       = Parser::builtinObjectFunction("Math.Log");
+        mathProperties["Log10"]     = Parser::builtinObjectFunction("Math.Log10");
+        mathProperties["LOG2E"]     = Parser::numberToValue(Math::LOG2E);
+        mathProperties["LOG10E"]    = Parser::numberToValue(Math::LOG10E);
+        mathProperties["Max"]       = Parser::builtinObjectFunction("Math.Max");
+        mathProperties["Min"]       = Parser::builtinObjectFunction("Math.Min");
+        mathProperties["PI"]        = Parser::numberToValue(Math::PI);
+        mathProperties["Pow"]       = Parser::builtinObjectFunction("Math.Pow");
+        mathProperties["Random"]    = Parser::builtinObjectFunction("Math.Random");
+        mathProperties["Round"]     = Parser::builtinObjectFunction("Math.Round");
+        mathProperties["Sign"]      = Parser::builtinObjectFunction("Math.Sign");
+        mathProperties["Sin"]       = Parser::builtinObjectFunction("Math.Sin");
+        mathProperties["Sqrt"]      = Parser::builtinObjectFunction("Math.Sqrt");
+        mathProperties["SQRT1_2"]   = Parser::numberToValue(Math::SQRT1_2);
+        mathProperties["SQRT2"]     = Parser::numberToValue(Math::SQRT2);
+        mathProperties["Square"]    = Parser::builtinObjectFunction("Math.Square");
+        mathProperties["Tan"]       = Parser::builtinObjectFunction("Math.Tan");
+        mathProperties["ToDegrees"] = Parser::builtinObjectFunction("Math.ToDegrees");
+        mathProperties["ToRadians"] = Parser::builtinObjectFunction("Math.ToRadians");
+        tables.builtinObjects["Math"] = Parser::builtinObjectValue("Math", std::move(mathProperties));
+
+        std::unordered_map<std::string, Value> httpProperties;
+        httpProperties["GET"]     = Parser::builtinObjectFunction("HTTP.GET");
+        httpProperties["POST"]    = Parser::builtinObjectFunction("HTTP.POST");
+        httpProperties["PUT"]     = Parser::builtinObjectFunction("HTTP.PUT");
+        httpProperties["PATCH"]   = Parser::builtinObjectFunction("HTTP.PATCH");
+        httpProperties["DELETE"]  = Parser::builtinObjectFunction("HTTP.DELETE");
+        httpProperties["HEAD"]    = Parser::builtinObjectFunction("HTTP.HEAD");
+        httpProperties["OPTIONS"] = Parser::builtinObjectFunction("HTTP.OPTIONS");
+        tables.builtinObjects["HTTP"] = Parser::builtinObjectValue("HTTP", std::move(httpProperties));
+
+        return tables;
+    }();
+    return instance;
+}
+
 Parser::Parser(
-    const std::vector<ParserToken>& tokens, bool doExecute, bool runAsync, const std::string& input, const bool allowJavaScript,
-    const bool canAllowJS, const std::string scriptName, const std::string scriptType, const bool allowLuau, const bool canAllowLuau,
+    std::vector<ParserToken> tokens, bool doExecute, bool runAsync, SourceBuffer source, const bool allowJavaScript,
+    const bool canAllowJS, const std::string& scriptName, const std::string& scriptType, const bool allowLuau, const bool canAllowLuau,
     const bool isFunction, const std::unordered_map<std::string, Value>* initialContext, const CharType chartype
 ) :
-    tokens(tokens), input(input), position(0), outputMode("everything"), allowJavaScript(allowJavaScript), globalScope(false),
-    strictMode(false), hasLogFile(false), allowLuau(allowLuau), canAllowLuau(canAllowLuau), doExecute(doExecute), runAsync(runAsync),
-    canAllowJS(allowJavaScript ? true : canAllowJS), scriptName(scriptName), scriptType(scriptType), asJSON(false), isJSONArray(false),
-    endOfScript("."), returnValue(DataType::UNKNOWN), isFunction(isFunction), chartype(chartype), currentScope(0), rootIndex(0)
+    doExecute(doExecute), runAsync(runAsync), tokens(std::move(tokens)), position(0), source(std::move(source)), input(*this->source),
+    returnValue(DataType::UNKNOWN), outputMode("everything"), allowJavaScript(allowJavaScript), globalScope(false), strictMode(false),
+    canAllowJS(allowJavaScript ? true : canAllowJS), allowLuau(allowLuau), canAllowLuau(canAllowLuau), hasLogFile(false),
+    scriptName(scriptName), scriptType(scriptType), asJSON(false), isJSONArray(false), endOfScript(TokenKind::DOT), isFunction(isFunction),
+    chartype(chartype), userFunctions(std::make_shared<FunctionRegistry>()), constantFolds(std::make_shared<ConstantFolds>()),
+    currentScope(0), rootIndex(0), tables(RuntimeTables::getInstance())
 {
-    initializeCPPTypes();
-    initializeBuiltIns();
-
     rootIndex = incrementRootCounter();
     currentScope = rootIndex;
     
-    localScopes[rootIndex] = std::unordered_map<std::string, Value>();
-    localConstVars[rootIndex] = std::unordered_map<std::string, bool>();
+    localScopes.try_emplace(rootIndex);
+    localConstVars.try_emplace(rootIndex);
 
     if (initialContext) {
         for (const auto& [key, value] : *initialContext) {
@@ -718,124 +912,10 @@ Parser::Parser(
         }
     }
 
-    // built-in spaces / type methods
-
-    typeMethods[DataType::JUSTC_OBJECT] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::NUMBER] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::STRING] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-
-        {"Reverse", "String::Reverse"},
-        {"GraphemeReverse", "String::GraphemeReverse"},
-        {"CodePointReverse", "String::CodePointReverse"},
-        {"ByteReverse", "String::ByteReverse"},
-        {"Trim", "String::Trim"},
-        {"Repeat", "String::Repeat"},
-        {"Slice", "String::Slice"},
-        {"GraphemeSlice", "String::GraphemeSlice"},
-        {"CodePointSlice", "String::CodePointSlice"},
-        {"ByteSlice", "String::ByteSlice"},
-        {"Lower", "String::Lower"},
-        {"Upper", "String::Upper"},
-        {"NormalizeNFC", "String::NormalizeNFC"},
-        {"NormalizeNFD", "String::NormalizeNFD"},
-        {"NormalizeNFKC", "String::NormalizeNFKC"},
-        {"NormalizeNFKD", "String::NormalizeNFKD"},
-        {"Length", "String::Length"},
-        {"GraphemeLength", "String::GraphemeLength"},
-        {"CodePointLength", "String::CodePointLength"},
-        {"ByteLength", "String::ByteLength"},
-        {"Size", "String::Size"},
-        {"EqualsIgnoreCase", "String::EqualsIgnoreCase"},
-        {"IsWhitespace", "String::IsWhitespace"},
-        {"StartsWith", "String::StartsWith"},
-        {"EndsWith", "String::EndsWith"},
-        {"Split", "String::Split"}
-    };
-    typeMethods[DataType::LINK] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::BOOLEAN] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::JSON_OBJECT] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::JSON_ARRAY] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-
-        {"Join", "Array::Join"},
-        {"Includes", "Array::Includes"},
-        {"IndexOf", "Array::IndexOf"},
-        {"LastIndexOf", "Array::LastIndexOf"},
-        {"Reverse", "Array::Reverse"},
-        {"ForEach", "Array::ForEach"}
-    };
-    typeMethods[DataType::NULL_TYPE] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::FUNCTION] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::NOT_A_NUMBER] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-    typeMethods[DataType::INFINITE] = {
-        {"ToString", "String"},
-        {"ToNumber", "Number"},
-        {"ToInt", "ParseInt"},
-        {"ToLink", "Link"},
-    };
-
     // built-in variables
 
-    std::unordered_map<std::string, Value> justcProperties;
-    justcProperties["Version"] = Value::createString(JUSTC_VERSION);
-    justcProperties["Parse"] = builtinObjectFunction("JUSTC.Parse");
-    justcProperties["Execute"] = builtinObjectFunction("JUSTC.Execute");
-    justcProperties["Stringify"] = builtinObjectFunction("JUSTC.Stringify");
-    justcProperties["Parser"] = builtinObjectFunction("JUSTC.Parser");
-    justcProperties["Lexer"] = builtinObjectFunction("JUSTC.Lexer");
-    builtinObject("JUSTC", justcProperties);
-
-    std::unordered_map<std::string, Value> jsonProperties;
-    jsonProperties["Parse"] = builtinObjectFunction("JSON.Parse");
-    jsonProperties["Stringify"] = builtinObjectFunction("JSON.Stringify");
-    builtinObject("JSON", jsonProperties);
+    builtinObject("JUSTC");
+    builtinObject("JSON");
 
     std::unordered_map<std::string, Value> jsProperties;
     jsProperties["Execute"] = builtinObjectFunction("JavaScript.Execute");
@@ -848,7 +928,7 @@ Parser::Parser(
     );
     jsProperties["IsAllowed"] = builtinObjectFunction("JavaScript.IsAllowed");
     jsProperties["CanAllow"] = booleanToValue(canAllowJS);
-    builtinObject("JavaScript", jsProperties);
+    builtinObject("JavaScript", std::move(jsProperties));
 
     std::unordered_map<std::string, Value> luauProperties;
     luauProperties["Execute"] = builtinObjectFunction("Luau.Execute");
@@ -856,64 +936,11 @@ Parser::Parser(
     luauProperties["Available"] = booleanToValue(doExecute);
     luauProperties["IsAllowed"] = builtinObjectFunction("Luau.IsAllowed");
     luauProperties["CanAllow"] = booleanToValue(canAllowLuau);
-    builtinObject("Luau", luauProperties);
-
-    std::unordered_map<std::string, Value> justoProperties;
-    justoProperties["Version"] = Value::createString(JUSTC_VERSION);
-    justoProperties["Parse"] = builtinObjectFunction("JUSTO.Parse");
-    justoProperties["Stringify"] = builtinObjectFunction("JUSTO.Stringify");
-    builtinObject("JUSTO", justoProperties);
-
-    std::unordered_map<std::string, Value> mathProperties;
-    mathProperties["Abs"]       = builtinObjectFunction("Math.Abs");
-    mathProperties["Acos"]      = builtinObjectFunction("Math.Acos");
-    mathProperties["Asin"]      = builtinObjectFunction("Math.Asin");
-    mathProperties["Atan"]      = builtinObjectFunction("Math.Atan");
-    mathProperties["Atan2"]     = builtinObjectFunction("Math.Atan2");
-    mathProperties["Ceil"]      = builtinObjectFunction("Math.Ceil");
-    mathProperties["Cos"]       = builtinObjectFunction("Math.Cos");
-    mathProperties["Clamp"]     = builtinObjectFunction("Math.Clamp");
-    mathProperties["Cube"]      = builtinObjectFunction("Math.Cube");
-    mathProperties["Double"]    = builtinObjectFunction("Math.Double");
-    mathProperties["E"]         = numberToValue(Math::E);
-    mathProperties["Exp"]       = builtinObjectFunction("Math.Exp");
-    mathProperties["Factorial"] = builtinObjectFunction("Math.Factorial");
-    mathProperties["Floor"]     = builtinObjectFunction("Math.Floor");
-    mathProperties["Hypot"]     = builtinObjectFunction("Math.Hypot");
-    mathProperties["IsPrime"]   = builtinObjectFunction("Math.IsPrime");
-    mathProperties["Lerp"]      = builtinObjectFunction("Math.Lerp");
-    mathProperties["LN2"]       = numberToValue(Math::LN2);
-    mathProperties["LN10"]      = numberToValue(Math::LN10);
-    mathProperties["Log"]       = builtinObjectFunction("Math.Log");
-    mathProperties["Log10"]     = builtinObjectFunction("Math.Log10");
-    mathProperties["LOG2E"]     = numberToValue(Math::LOG2E);
-    mathProperties["LOG10E"]    = numberToValue(Math::LOG10E);
-    mathProperties["Max"]       = builtinObjectFunction("Math.Max");
-    mathProperties["Min"]       = builtinObjectFunction("Math.Min");
-    mathProperties["PI"]        = numberToValue(Math::PI);
-    mathProperties["Pow"]       = builtinObjectFunction("Math.Pow");
-    mathProperties["Random"]    = builtinObjectFunction("Math.Random");
-    mathProperties["Round"]     = builtinObjectFunction("Math.Round");
-    mathProperties["Sign"]      = builtinObjectFunction("Math.Sign");
-    mathProperties["Sin"]       = builtinObjectFunction("Math.Sin");
-    mathProperties["Sqrt"]      = builtinObjectFunction("Math.Sqrt");
-    mathProperties["SQRT1_2"]   = numberToValue(Math::SQRT1_2);
-    mathProperties["SQRT2"]     = numberToValue(Math::SQRT2);
-    mathProperties["Square"]    = builtinObjectFunction("Math.Square");
-    mathProperties["Tan"]       = builtinObjectFunction("Math.Tan");
-    mathProperties["ToDegrees"] = builtinObjectFunction("Math.ToDegrees");
-    mathProperties["ToRadians"] = builtinObjectFunction("Math.ToRadians");
-    builtinObject("Math", mathProperties);
-
-    std::unordered_map<std::string, Value> httpProperties;
-    httpProperties["GET"]     = builtinObjectFunction("HTTP.GET");
-    httpProperties["POST"]    = builtinObjectFunction("HTTP.POST");
-    httpProperties["PUT"]     = builtinObjectFunction("HTTP.PUT");
-    httpProperties["PATCH"]   = builtinObjectFunction("HTTP.PATCH");
-    httpProperties["DELETE"]  = builtinObjectFunction("HTTP.DELETE");
-    httpProperties["HEAD"]    = builtinObjectFunction("HTTP.HEAD");
-    httpProperties["OPTIONS"] = builtinObjectFunction("HTTP.OPTIONS");
-    builtinObject("HTTP", httpProperties);
+    builtinObject("Luau", std::move(luauProperties));
+
+    builtinObject("JUSTO");
+    builtinObject("Math");
+    builtinObject("HTTP");
 
     std::unordered_map<std::string, Value> scriptProperties;
     scriptProperties["Name"] = stringToValue(scriptName);
@@ -958,7 +985,7 @@ Parser::Parser(
     scriptProperties["int128"] = booleanToValue(JUSTC_INT128_SUPPORT);
     scriptProperties["uint128"] = booleanToValue(JUSTC_UINT128_SUPPORT);
     scriptProperties["float128"] = booleanToValue(JUSTC_FLOAT128_SUPPORT);
-    builtinObject("Script", scriptProperties);
+    builtinObject("Script", std::move(scriptProperties));
 
     Value chartypeValue;
     chartypeValue.type = DataType::STRING;
@@ -974,10 +1001,35 @@ Parser::Parser(
             break;
     }
     chartypeValue.name = "CharType";
-    variables["CharType"] = chartypeValue;
+    variables["CharType"] = std::move(chartypeValue);
     constVars["CharType"] = false;
 }
 
+Parser::Parser(
+    std::vector<ParserToken> tokens, bool doExecute, bool runAsync, const std::string& input, const bool allowJavaScript,
+    const bool canAllowJS, const std::string& scriptName, const std::string& scriptType, const bool allowLuau, const bool canAllowLuau,
+    const bool isFunction, const std::unordered_map<std::string, Value>* initialContext, const CharType chartype
+) : Parser(
+    std::move(tokens), doExecute, runAsync, std::make_shared<const std::string>(input), allowJavaScript,
+    canAllowJS, scriptName, scriptType, allowLuau, canAllowLuau, isFunction, initialContext, chartype
+) {}
+
+const LineIndex& Parser::lineIndex() const {
+    std::shared_ptr<const LineIndex> index = std::atomic_load(&lines);
+    if (!index) {
+        std::shared_ptr<const LineIndex> expected;
+        index = std::make_shared<const LineIndex>(input);
+        if (!std::atomic_compare_exchange_strong(&lines, &expected, index)) {
+            index = expected;
+        }
+    }
+    return *index;
+}
+
+std::string Parser::sourcePosition(size_t pos) const {
+    return lineIndex().position(pos);
+}
+
 std::string Parser::getCurrentTimestamp() {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
@@ -1018,16 +1070,26 @@ void Parser::addImportLog(const std::string& path, const std::string& script, co
     importLogs.push_back(log);
 }
 
-ParserToken Parser::currentToken() const {
+namespace {
+    const ParserToken endOfFile{TokenKind::END_OF_FILE, "", 0};
+
+    // the value itself, or the HTTP response it stands for once that has arrived
+    Value joined(const Value& value) {
+        const auto& response = value.response();
+        return response ? response->get() : value;
+    }
+}
+
+const ParserToken& Parser::currentToken() const {
     if (position >= tokens.size()) {
-        return {"EOF", "", 0};
+        return endOfFile;
     }
     return tokens[position];
 }
 
-ParserToken Parser::peekToken(size_t offset) const {
+const ParserToken& Parser::peekToken(size_t offset) const {
     if (position + offset >= tokens.size()) {
-        return {"EOF", "", 0};
+        return endOfFile;
     }
     return tokens[position + offset];
 }
@@ -1038,12 +1100,13 @@ void Parser::advance() {
     }
 }
 
-bool Parser::match(const std::string& type) const {
-    return currentToken().type == type;
+bool Parser::match(TokenKind kind) const {
+    return currentToken().kind == kind;
 }
 
-bool Parser::match(const std::string& type, const std::string& value) const {
-    return currentToken().type == type && currentToken().value == value;
+bool Parser::match(TokenKind kind, const std::string& value) const {
+    const ParserToken& token = currentToken();
+    return token.kind == kind && token.value == value;
 }
 
 bool Parser::isEnd() const {
@@ -1051,7 +1114,7 @@ bool Parser::isEnd() const {
 }
 
 void Parser::skipCommas() {
-    while (match(",") || match(";")) advance();
+    while (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
 }
 
 bool Parser::isInBracketedExpression() {
@@ -1065,25 +1128,25 @@ bool Parser::isInBracketedExpression() {
     while (currentPos < tokens.size()) {
         const auto& token = tokens[currentPos];
         
-        if ((token.type == ";" || token.type == "," || token.type == ".") && 
+        if ((token.kind == TokenKind::SEMICOLON || token.kind == TokenKind::COMMA || token.kind == TokenKind::DOT) && 
             parenCount == 0 && bracketCount == 0 && braceCount == 0) {
             if (currentPos > 0) {
                 const auto& prevToken = tokens[currentPos - 1];
-                if (prevToken.type == ")" || prevToken.type == "]" || prevToken.type == "}") {
+                if (prevToken.kind == TokenKind::RIGHT_PAREN || prevToken.kind == TokenKind::RIGHT_BRACKET || prevToken.kind == TokenKind::RIGHT_BRACE) {
                     return true;
                 }
             }
             return false;
         }
         
-        if (token.type == "(") parenCount++;
-        else if (token.type == ")") parenCount--;
-        else if (token.type == "[") bracketCount++;
-        else if (token.type == "]") bracketCount--;
-        else if (token.type == "{") braceCount++;
-        else if (token.type == "}") braceCount--;
+        if (token.kind == TokenKind::LEFT_PAREN) parenCount++;
+        else if (token.kind == TokenKind::RIGHT_PAREN) parenCount--;
+        else if (token.kind == TokenKind::LEFT_BRACKET) bracketCount++;
+        else if (token.kind == TokenKind::RIGHT_BRACKET) bracketCount--;
+        else if (token.kind == TokenKind::LEFT_BRACE) braceCount++;
+        else if (token.kind == TokenKind::RIGHT_BRACE) braceCount--;
         
-        if (token.type == "EOF") break;
+        if (token.kind == TokenKind::END_OF_FILE) break;
         
         currentPos++;
     }
@@ -1094,8 +1157,6 @@ bool Parser::isInBracketedExpression() {
 ParseResult Parser::parse(bool doExecute) {
     ParseResult result;
 
-    result.variables = std::make_shared<std::unordered_map<std::string, Value>>(variables);
-    result.constants = std::make_shared<std::unordered_map<std::string, bool>>(constVars);
     result.dependencies = std::make_shared<std::unordered_map<std::string, std::vector<std::string>>>(dependencies);
 
     try {
@@ -1103,18 +1164,18 @@ ParseResult Parser::parse(bool doExecute) {
             skipCommas();
             if (isEnd()) break;
 
-            if ((match("{") || match("[")) && position == 0) {
-                if (match("[")) {
+            if ((match(TokenKind::LEFT_BRACE) || match(TokenKind::LEFT_BRACKET)) && position == 0) {
+                if (match(TokenKind::LEFT_BRACKET)) {
                     isJSONArray = true;
                     result.array = true;
-                    endOfScript = "]";
+                    endOfScript = TokenKind::RIGHT_BRACKET;
                 } else {
-                    endOfScript = "}";
+                    endOfScript = TokenKind::RIGHT_BRACE;
                 }
                 advance();
                 asJSON = true;
-            } else if (match("keyword")) {
-                std::string keyword = currentToken().value;
+            } else if (match(TokenKind::KEYWORD)) {
+                std::string keyword = currentToken().value.str();
 
                 if (keyword == "scope") {
                     ast.push_back(parseScopeCommand());
@@ -1127,7 +1188,7 @@ ParseResult Parser::parse(bool doExecute) {
                 } else if (keyword == "import") {
                     ast.push_back(parseImportCommand());
                 } else if (keyword == "if" || keyword == "while" || keyword == "for" || (
-                    keyword == "isolated" && peekToken().type == "keyword" && (
+                    keyword == "isolated" && peekToken().kind == TokenKind::KEYWORD && (
                         peekToken().value == "if" || peekToken().value == "while" || peekToken().value == "for"
                     )
                 )) {
@@ -1138,17 +1199,17 @@ ParseResult Parser::parse(bool doExecute) {
                 } else {
                     ast.push_back(parseStatement(doExecute));
                 }
-            } else if ((match("identifier") || ((match("string") || match("number")) && !isJSONArray)) && !isInBracketedExpression()) {
-                std::string identifier = currentToken().value;
+            } else if ((match(TokenKind::IDENTIFIER) || ((match(TokenKind::STRING) || match(TokenKind::NUMBER)) && !isJSONArray)) && !isInBracketedExpression()) {
+                std::string identifier = currentToken().value.str();
                 bool isIdentifier = true;
                 size_t originalPos = position;
 
-                if (match("string") || match("number")) {
+                if (match(TokenKind::STRING) || match(TokenKind::NUMBER)) {
                     isIdentifier = false;
                     Value exprValue = parseExpression(doExecute, true);
                     identifier = exprValue.toString();
 
-                    ParserToken parsedToken = {"string", identifier, currentToken().start};
+                    ParserToken parsedToken = {TokenKind::STRING, identifier, currentToken().start};
 
                     std::vector<ParserToken> newTokens;
                     for (size_t i = 0; i < originalPos; i++) {
@@ -1162,29 +1223,29 @@ ParseResult Parser::parse(bool doExecute) {
                     tokens = newTokens;
 
                     position = originalPos;
-                } else if (doExecute && match(":")) {
+                } else if (doExecute && match(TokenKind::COLON)) {
                     advance();
                     Value var = resolveVariableValue(identifier, false);
-                    auto it = typeMethods.find(var.type);
+                    auto it = tables.typeMethods.find(var.type);
 
-                    if (var.type != DataType::UNKNOWN && it != typeMethods.end()) {
-                        std::string funcName = (match("identifier") ? getIdentifier() : parseExpression(doExecute, true, false)).toIdentifier();
-                        auto itFunc = typeMethods[var.type].find(funcName);
+                    if (var.type != DataType::UNKNOWN && it != tables.typeMethods.end()) {
+                        std::string funcName = (match(TokenKind::IDENTIFIER) ? getIdentifier() : parseExpression(doExecute, true, false)).toIdentifier();
+                        auto itFunc = it->second.find(funcName);
 
-                        if (itFunc != typeMethods[var.type].end() && match("(")) {
+                        if (itFunc != it->second.end() && match(TokenKind::LEFT_PAREN)) {
                             checkVariableNameAvailable(identifier);
 
                             std::vector<Value> args = {var};
                             std::vector<Value> additionalArgs = parseArguments(doExecute);
-                            args.insert(args.end(), additionalArgs.begin(), additionalArgs.end());
-                            Value result = executeFunction(typeMethods[var.type][funcName], args, currentToken().start);
+                            args.insert(args.end(), std::make_move_iterator(additionalArgs.begin()), std::make_move_iterator(additionalArgs.end()));
+                            Value result = executeFunction(itFunc->second, args, currentToken().start);
 
                             ASTNode node("VARIABLE_DECLARATION", var.isVariable ? var.variable : result.name, currentToken().start);
                             node.value = result;
-                            if (var.isVariable) assign(var, result, " at " + Utility::position(currentToken().start, input) + ".");
+                            if (var.isVariable) assign(var, result, currentToken().start);
                             else variables[result.name] = result;
 
-                            ast.push_back(node);
+                            ast.push_back(std::move(node));
                             skipCommas();
                             continue;
                         }
@@ -1200,20 +1261,20 @@ ParseResult Parser::parse(bool doExecute) {
                 } else {
                     ASTNode item("ARRAY_ITEM", "", position);
                     item.value = Value::createString(identifier);
-                    ast.push_back(item);
                     arrayItems.push_back(item.value);
+                    ast.push_back(std::move(item));
                 }
             } else if (match(endOfScript)) {
                 advance();
                 if (!isEnd()) {
-                    throw std::runtime_error("After end of script - Unexpected token \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+                    throw std::runtime_error("After end of script - Unexpected token \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
                 }
                 break;
-            } else if (match("JavaScript")) {
+            } else if (match(TokenKind::JAVASCRIPT)) {
                 if (doExecute && allowJavaScript) {
                     #ifdef __EMSCRIPTEN__
 
-                    Value result = runJavaScript(currentToken().value, Utility::position(currentToken().start, input), false);
+                    Value result = runJavaScript(currentToken().value.str(), sourcePosition(currentToken().start), false);
                     addLog("JAVASCRIPT", Utility::value2string(result), position);
                     if (result.type != DataType::NULL_TYPE) {
                         std::cout << Utility::value2string(result) << std::endl;
@@ -1221,9 +1282,9 @@ ParseResult Parser::parse(bool doExecute) {
 
                     #elif !defined(_MSC_VER)
 
-                    std::pair<std::string, bool> jsresult = JavaScript::Eval(currentToken().value);
+                    std::pair<std::string, bool> jsresult = JavaScript::Eval(currentToken().value.str());
                     if (jsresult.second) {
-                        throw std::runtime_error("JavaScript error at " + Utility::position(currentToken().start, input) + ":\n" + jsresult.first);
+                        throw std::runtime_error("JavaScript error at " + sourcePosition(currentToken().start) + ":\n" + jsresult.first);
                     } else {
                         addLog("JAVASCRIPT", jsresult.first, position);
                         std::cout << jsresult.first << std::endl;
@@ -1232,55 +1293,53 @@ ParseResult Parser::parse(bool doExecute) {
                     #endif
                 } else if (!allowJavaScript) {
                     #ifdef __EMSCRIPTEN__
-                    warn_js_disabled_by_justc(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
+                    warn_js_disabled_by_justc(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
                     #endif
                 }
                 ast.push_back(ASTNode("JAVASCRIPT"));
                 advance();
-            } else if (match("Luau")) {
+            } else if (match(TokenKind::LUAU)) {
                 if (doExecute && allowLuau) {
-                    RunLuau::runScript(currentToken().value);
+                    RunLuau::runScript(currentToken().value.str());
                 } else if (!allowLuau) {
                     #ifdef __EMSCRIPTEN__
-                    warn_luau_disabled_by_justc(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
+                    warn_luau_disabled_by_justc(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
                     #endif
                 }
                 ast.push_back(ASTNode("LUAU"));
                 advance();
             } else if (isJSONArray) {
                 try {
-                    Value itemVal = parseBitwiseOR(doExecute);
+                    Value itemVal = parseBinary(BITWISE_OR, doExecute);
                     ASTNode item("ARRAY_ITEM", "", position);
-                    item.value = itemVal;
-                    ast.push_back(item);
                     arrayItems.push_back(itemVal);
+                    item.value = std::move(itemVal);
+                    ast.push_back(std::move(item));
                 } catch (...) {
-                    throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+                    throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
                 }
             } else if (position == 0 || (
-                tokens[position - 1].type == "," || tokens[position - 1].type == ";"
+                tokens[position - 1].kind == TokenKind::COMMA || tokens[position - 1].kind == TokenKind::SEMICOLON
             )) {
                 try {
                     parseExpression(doExecute);
                 } catch (...) {
-                    throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+                    throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
                 }
-            } else if (match("(")) {
+            } else if (match(TokenKind::LEFT_PAREN)) {
                 parseExpression(doExecute);
-            } else throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+            } else throw std::runtime_error("Unexpected token \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
 
             skipCommas();
         }
         position -= 1;
 
+        joinResponses();
         buildDependencyGraph();
-
-        if (detectCycles()) {
-            throw std::runtime_error("Circular dependency detected");
-        }
-
         evaluateAllVariables();
         removeBuiltinVariablesFromOutput();
+        result.variables = std::make_shared<std::unordered_map<std::string, Value>>(variables);
+        result.constants = std::make_shared<std::unordered_map<std::string, bool>>(constVars);
 
         if (isJSONArray) {
             for (size_t i = 0; i < arrayItems.size(); i++) {
@@ -1307,20 +1366,18 @@ ParseResult Parser::parse(bool doExecute) {
                         }
                     }
                 } else if (returnValue.type != DataType::UNKNOWN) {
-                    Value finalValue = returnValue;
-
-                    if (finalValue.type == DataType::VARIABLE) {
-                        finalValue = resolveVariableValue(finalValue.string_value, true);
-                    }
+                    const Value finalValue = returnValue.type == DataType::VARIABLE
+                        ? resolveVariableValue(returnValue.string_value, true)
+                        : returnValue;
 
                     if (finalValue.type == DataType::JUSTC_OBJECT ||
                         finalValue.type == DataType::JSON_OBJECT) {
-                        for (const auto& [key, val] : finalValue.properties) {
+                        for (const auto& [key, val] : finalValue.properties()) {
                             result.returnValues[key] = convertToDecimal(val);
                         }
                     } else if (finalValue.type == DataType::JSON_ARRAY) {
-                        for (size_t i = 0; i < finalValue.array_elements.size(); i++) {
-                            result.returnValues[std::to_string(i)] = convertToDecimal(finalValue.array_elements[i]);
+                        for (size_t i = 0; i < finalValue.array_elements().size(); i++) {
+                            result.returnValues[std::to_string(i)] = convertToDecimal(finalValue.array_elements()[i]);
                         }
                     } else {
                         result.returnValues["return"] = convertToDecimal(finalValue);
@@ -1356,11 +1413,13 @@ ParseResult Parser::parse(bool doExecute) {
         result.importLogs = importLogs;
 
     } catch (const std::exception& e) {
-        std::pair<size_t, size_t> pos = Utility::pos(currentToken().start, input);
+        std::pair<size_t, size_t> pos = lineIndex().pos(currentToken().start);
         std::string err = std::string(e.what()) + "\n    at " + scriptName + ":" + std::to_string(pos.first) + ":" + std::to_string(pos.second);
 
         result.error = err;
         addLog("ERROR", err, currentToken().start);
+        result.variables = std::make_shared<std::unordered_map<std::string, Value>>(variables);
+        result.constants = std::make_shared<std::unordered_map<std::string, bool>>(constVars);
     }
 
     return result;
@@ -1379,15 +1438,15 @@ Value Parser::convertToDecimal(const Value& value) {
     return value;
 }
 
-void Parser::parseScopeCommandError(const std::string scope) {
-    throw std::runtime_error("Expected scope mode keyword, got \"" + scope + "\" at " + Utility::position(currentToken().start, input) + ". Scope mode keywords are: \"global\", \"local\", \"strict\".");
+void Parser::parseScopeCommandError(const std::string& scope) {
+    throw std::runtime_error("Expected scope mode keyword, got \"" + scope + "\" at " + sourcePosition(currentToken().start) + ". Scope mode keywords are: \"global\", \"local\", \"strict\".");
 }
 ASTNode Parser::parseScopeCommand() {
     ASTNode node("SCOPE_COMMAND", "", currentToken().start);
     advance();
 
-    if (match("keyword")) {
-        std::string type = currentToken().value;
+    if (match(TokenKind::KEYWORD)) {
+        std::string type = currentToken().value.str();
         if (type == "global") {
             globalScope = true;
         } else if (type == "local") {
@@ -1402,15 +1461,15 @@ ASTNode Parser::parseScopeCommand() {
     return node;
 }
 
-void Parser::parseOutputCommandError(const std::string mode) {
-    throw std::runtime_error("Expected output mode keyword, got \"" + mode + "\" at " + Utility::position(currentToken().start, input) + ". Output mode keywords are: \"specified\", \"everything\", \"disabled\".");
+void Parser::parseOutputCommandError(const std::string& mode) {
+    throw std::runtime_error("Expected output mode keyword, got \"" + mode + "\" at " + sourcePosition(currentToken().start) + ". Output mode keywords are: \"specified\", \"everything\", \"disabled\".");
 }
 ASTNode Parser::parseOutputCommand() {
     ASTNode node("OUTPUT_COMMAND", "", currentToken().start);
     advance();
 
-    if (match("keyword")) {
-        std::string mode = currentToken().value;
+    if (match(TokenKind::KEYWORD)) {
+        std::string mode = currentToken().value.str();
         if (mode == "specified" || mode == "everything" || mode == "disabled") {
             outputMode = mode;
             node.value = stringToValue(outputMode);
@@ -1419,7 +1478,7 @@ ASTNode Parser::parseOutputCommand() {
             parseOutputCommandError(mode);
         }
     } else {
-        parseOutputCommandError(currentToken().value);
+        parseOutputCommandError(currentToken().value.str());
     }
 
     return node;
@@ -1444,27 +1503,27 @@ ASTNode Parser::parseReturnCommand() {
 }
 
 void Parser::parseAllowCommandError() {
-    throw std::runtime_error("Expected language name, got \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ". Supported languages are: \"JavaScript\", \"Luau\".");
+    throw std::runtime_error("Expected language name, got \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ". Supported languages are: \"JavaScript\", \"Luau\".");
 }
 ASTNode Parser::parseAllowCommand() {
     ASTNode node("ALLOW_COMMAND", "", currentToken().start);
-    std::string command = currentToken().value;
+    std::string command = currentToken().value.str();
     advance();
 
-    if (match("keyword", "JavaScript")) {
+    if (match(TokenKind::KEYWORD, "JavaScript")) {
         if (!canAllowJS && command == "allow") {
             #ifdef __EMSCRIPTEN__
-            warn_cant_enable_js(Utility::position(currentToken().start, input).c_str(), getCurrentTimestamp().c_str(), scriptName.c_str(), scriptType.c_str());
+            warn_cant_enable_js(sourcePosition(currentToken().start).c_str(), getCurrentTimestamp().c_str(), scriptName.c_str(), scriptType.c_str());
             #endif
-            addLog("WARN", "Attempt to allow JavaScript at <import " + scriptType + " \"" + scriptName + "\"> at " + Utility::position(currentToken().start, input) + ".", currentToken().start);
+            addLog("WARN", "Attempt to allow JavaScript at <import " + scriptType + " \"" + scriptName + "\"> at " + sourcePosition(currentToken().start) + ".", currentToken().start);
         } else allowJavaScript = (command == "allow");
         node.value = booleanToValue(allowJavaScript);
-    } else if (match("keyword", "Luau")) {
+    } else if (match(TokenKind::KEYWORD, "Luau")) {
         if (!canAllowLuau && command == "allow") {
             #ifdef __EMSCRIPTEN__
-            warn_cant_enable_luau(Utility::position(currentToken().start, input).c_str(), getCurrentTimestamp().c_str(), scriptName.c_str(), scriptType.c_str());
+            warn_cant_enable_luau(sourcePosition(currentToken().start).c_str(), getCurrentTimestamp().c_str(), scriptName.c_str(), scriptType.c_str());
             #endif
-            addLog("WARN", "Attempt to allow Luau at <import " + scriptType + " \"" + scriptName + "\"> at " + Utility::position(currentToken().start, input) + ".", currentToken().start);
+            addLog("WARN", "Attempt to allow Luau at <import " + scriptType + " \"" + scriptName + "\"> at " + sourcePosition(currentToken().start) + ".", currentToken().start);
         } else allowLuau = (command == "allow");
         node.value = booleanToValue(allowLuau);
     } else parseAllowCommandError();
@@ -1475,16 +1534,16 @@ ASTNode Parser::parseAllowCommand() {
 
 std::string Parser::readVariableName() {
     std::stringstream name;
-    while (!isEnd() && (match("identifier") || match("string") || match("minus") || match("-"))) {
-        name << currentToken().value;
+    while (!isEnd() && (match(TokenKind::IDENTIFIER) || match(TokenKind::STRING) || match(TokenKind::MINUS) || match(TokenKind::DASH))) {
+        name << currentToken().value.view();
         advance();
     }
     return name.str();
 }
-void Parser::checkVariableNameAvailable(std::string name) {
+void Parser::checkVariableNameAvailable(const std::string& name) {
     auto constIt = constVars.find(name);
     if (constIt != constVars.end() && constIt->second) {
-        throw new std::runtime_error("Assignment to constant variable \"" + name + "\" at " + Utility::position(currentToken().start, input) + ".");
+        throw new std::runtime_error("Assignment to constant variable \"" + name + "\" at " + sourcePosition(currentToken().start) + ".");
     }
 }
 
@@ -1498,24 +1557,24 @@ ASTNode Parser::parseImportCommand() {
     bool rename = false;
     bool single = false;
 
-    if (match("identifier")) {
+    if (match(TokenKind::IDENTIFIER)) {
         imports.push_back(readVariableName());
         single = true;
-    } else if (!match("keyword", "as") && !match("keyword", "from")) {
-        Value exprValue = parseExpression(doExecute, true);
+    } else if (!match(TokenKind::KEYWORD, "as") && !match(TokenKind::KEYWORD, "from")) {
+        const Value exprValue = parseExpression(doExecute, true);
         switch (exprValue.type) {
             case DataType::JSON_OBJECT:
             case DataType::JUSTC_OBJECT: {
                 rename = true;
-                for (const auto& [key, value] : exprValue.properties) {
+                for (const auto& [key, value] : exprValue.properties()) {
                     imports.push_back(value.toString());
                     renames.push_back(key);
                 }
                 break;
             }
             case DataType::JSON_ARRAY: {
-                for (size_t i = 0; i < exprValue.array_elements.size(); i++) {
-                    imports.push_back(exprValue.array_elements[i].toString());
+                for (size_t i = 0; i < exprValue.array_elements().size(); i++) {
+                    imports.push_back(exprValue.array_elements()[i].toString());
                 }
                 break;
             }
@@ -1527,18 +1586,18 @@ ASTNode Parser::parseImportCommand() {
         importAll = true;
     }
 
-    if (match("keyword", "as")) {
+    if (match(TokenKind::KEYWORD, "as")) {
         single = false;
         if (rename) renames.clear();
         rename = true;
-        if (match("identifier")) {
+        if (match(TokenKind::IDENTIFIER)) {
             renames.push_back(readVariableName());
         } else {
-            Value exprValue = parseExpression(doExecute, true);
+            const Value exprValue = parseExpression(doExecute, true);
             switch (exprValue.type) {
                 case DataType::JSON_ARRAY: {
-                    for (size_t i = 0; i < exprValue.array_elements.size(); i++) {
-                        imports.push_back(exprValue.array_elements[i].toString());
+                    for (size_t i = 0; i < exprValue.array_elements().size(); i++) {
+                        imports.push_back(exprValue.array_elements()[i].toString());
                     }
                     break;
                 }
@@ -1547,14 +1606,14 @@ ASTNode Parser::parseImportCommand() {
             }
         }
     }
-    if (!match("keyword", "from")) throw new std::runtime_error("Expected keyword \"from\" at " + Utility::position(currentToken().start, input) + ".");
+    if (!match(TokenKind::KEYWORD, "from")) throw new std::runtime_error("Expected keyword \"from\" at " + sourcePosition(currentToken().start) + ".");
     advance();
 
     std::string importType = parseExpression(doExecute).toString();
     if (importType == "JUSTC") {
         int importStringType = 0; // 0 = link module; 1 = path module; 2 = string module; 3 = link script; 4 = path script; 5 = string script
         bool typeDeclared = false;
-        if (match(":")) {
+        if (match(TokenKind::COLON)) {
             typeDeclared = true;
             std::string typeDeclaration = parseExpression(doExecute).toString();
             if (typeDeclaration == "webmodule") {
@@ -1570,7 +1629,7 @@ ASTNode Parser::parseImportCommand() {
             } else if (typeDeclaration == "strscript") {
                 importStringType = 5;
             } else {
-                throw std::runtime_error("Invalid JUSTC import type \"" + typeDeclaration + "\" at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Invalid JUSTC import type \"" + typeDeclaration + "\" at " + sourcePosition(currentToken().start) + ".");
             }
         }
 
@@ -1589,11 +1648,11 @@ ASTNode Parser::parseImportCommand() {
         bool importExecute = doExecute;
         bool importJavaScript = doExecute && allowJavaScript;
         bool importLuau = doExecute && allowLuau;
-        if (match("keyword", "options")) {
+        if (match(TokenKind::KEYWORD, "options")) {
             advance();
             Value optionsVal = parseExpression(doExecute);
             if (optionsVal.type != DataType::JSON_OBJECT && optionsVal.type != DataType::JUSTC_OBJECT) {
-                throw std::runtime_error("Expected object for import options at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected object for import options at " + sourcePosition(currentToken().start) + ".");
             }
 
             bool optionsExecute     = optionsVal.getProperty("Execute",     booleanToValue(importExecute)).toBoolean();
@@ -1601,13 +1660,13 @@ ASTNode Parser::parseImportCommand() {
             bool optionsLuau        = optionsVal.getProperty("Luau",        booleanToValue(importLuau)).toBoolean();
 
             if (!importExecute && optionsExecute) {
-                throw std::runtime_error("Attempt to execute JUSTC at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Attempt to execute JUSTC at " + sourcePosition(currentToken().start) + ".");
             }
             if (!importJavaScript && optionsJavaScript) {
-                throw std::runtime_error("Attempt to allow JavaScript at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Attempt to allow JavaScript at " + sourcePosition(currentToken().start) + ".");
             }
             if (!importLuau && optionsLuau) {
-                throw std::runtime_error("Attempt to allow Luau at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Attempt to allow Luau at " + sourcePosition(currentToken().start) + ".");
             }
 
             importExecute = optionsExecute;
@@ -1643,11 +1702,11 @@ ASTNode Parser::parseImportCommand() {
                 throw std::runtime_error("Unknown JUSTC import type.");
         }
         try {
-            imported = Import::JUSTC(location, Utility::position(currentToken().start, input), importExecute, runAsync, importJavaScript, mode, importLuau, isLink, isString);
+            imported = Import::JUSTC(location, sourcePosition(currentToken().start), importExecute, runAsync, importJavaScript, mode, importLuau, isLink, isString);
         } catch (const std::exception& e) {
-            throw std::runtime_error(std::string(e.what()) + "\n    at <import JUSTC " + importedType + " \"" + location + "\"> at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error(std::string(e.what()) + "\n    at <import JUSTC " + importedType + " \"" + location + "\"> at " + sourcePosition(currentToken().start) + ".");
         } catch (...) {
-            throw std::runtime_error("Invalid import JUSTC \"" + location + "\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Invalid import JUSTC \"" + location + "\" at " + sourcePosition(currentToken().start) + ".");
         }
 
         addImportLog(location, imported.second, "JUSTC " + importedType);
@@ -1670,10 +1729,10 @@ ASTNode Parser::parseImportCommand() {
                 outputVars.push_back(key);
             }
             objCtx->outputMode = "specified";
-            objCtx->outputVariables = outputVars;
+            objCtx->outputVariables = std::move(outputVars);
             Value objVal = Value::createJustcObject(objCtx);
             objVal.name = name;
-            objVal.properties = imported.first.returnValues;
+            objVal.mutableData().properties = imported.first.returnValues;
             objVal.type = DataType::JSON_OBJECT;
 
             ASTNode node("VARIABLE_DECLARATION", name, position);
@@ -1709,13 +1768,13 @@ ASTNode Parser::parseImportCommand() {
                 variables[key] = pair.second;
                 constVars[key] = true;
                 node.value = pair.second;
-                ast.push_back(node);
+                ast.push_back(std::move(node));
             }
         }
     } else if (importType == "JUSTO") {
         int importStringType = 0; // 0 = link; 1 = path; 2 = string
         bool typeDeclared = false;
-        if (match(":")) {
+        if (match(TokenKind::COLON)) {
             typeDeclared = true;
             std::string typeDeclaration = parseExpression(doExecute).toString();
             if (typeDeclaration == "web") {
@@ -1725,7 +1784,7 @@ ASTNode Parser::parseImportCommand() {
             } else if (typeDeclaration == "string") {
                 importStringType = 2;
             } else {
-                throw std::runtime_error("Invalid JUSTO import type \"" + typeDeclaration + "\" at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Invalid JUSTO import type \"" + typeDeclaration + "\" at " + sourcePosition(currentToken().start) + ".");
             }
         }
 
@@ -1742,29 +1801,29 @@ ASTNode Parser::parseImportCommand() {
         };
 
         std::unordered_map<std::string, Value> justoPointers;
-        if (match("keyword", "options")) {
+        if (match(TokenKind::KEYWORD, "options")) {
             advance();
-            Value optionsVal = parseExpression(doExecute);
+            const Value optionsVal = parseExpression(doExecute);
             if (optionsVal.type != DataType::JSON_OBJECT && optionsVal.type != DataType::JUSTC_OBJECT) {
-                throw std::runtime_error("Expected object for import options at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected object for import options at " + sourcePosition(currentToken().start) + ".");
             }
 
-            auto nanIt = optionsVal.properties.find("nan");
-            auto infIt = optionsVal.properties.find("inf");
-            if (nanIt != optionsVal.properties.end() || infIt != optionsVal.properties.end()) {
-                throw std::runtime_error("Attempt to redefine built-in JUSTO pointer at " + Utility::position(currentToken().start, input) + ".");
+            auto nanIt = optionsVal.properties().find("nan");
+            auto infIt = optionsVal.properties().find("inf");
+            if (nanIt != optionsVal.properties().end() || infIt != optionsVal.properties().end()) {
+                throw std::runtime_error("Attempt to redefine built-in JUSTO pointer at " + sourcePosition(currentToken().start) + ".");
             }
 
-            justoPointers = optionsVal.properties;
+            justoPointers = optionsVal.properties();
         }
 
         std::pair<Value, std::string> imported;
         try {
-            imported = Import::JUSTO(location, Utility::position(currentToken().start, input), importStringType == 0, importStringType == 2, justoPointers);
+            imported = Import::JUSTO(location, sourcePosition(currentToken().start), importStringType == 0, importStringType == 2, std::move(justoPointers));
         } catch (const std::exception& e) {
-            throw std::runtime_error(std::string(e.what()) + "\n    at <import JUSTO object \"" + location + "\"> at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error(std::string(e.what()) + "\n    at <import JUSTO object \"" + location + "\"> at " + sourcePosition(currentToken().start) + ".");
         } catch (...) {
-            throw std::runtime_error("Invalid import JUSTO \"" + location + "\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Invalid import JUSTO \"" + location + "\" at " + sourcePosition(currentToken().start) + ".");
         }
         addImportLog(location, imported.second, "JUSTO object");
         if (single) {
@@ -1776,10 +1835,10 @@ ASTNode Parser::parseImportCommand() {
             variables[name] = imported.first;
             constVars[name] = true;
             node.value = imported.first;
-            ast.push_back(node);
+            ast.push_back(std::move(node));
         } else {
             size_t i = 0;
-            for (const auto& [keyRaw, value] : imported.first.properties) {
+            for (const auto& [keyRaw, value] : std::as_const(imported.first).properties()) {
                 std::string key = keyRaw;
 
                 auto constIt = constVars.find(key);
@@ -1805,18 +1864,18 @@ ASTNode Parser::parseImportCommand() {
                 variables[key] = value;
                 constVars[key] = true;
                 node.value = value;
-                ast.push_back(node);
+                ast.push_back(std::move(node));
             }
         }
     } else {
-        throw std::runtime_error("Cannot import from \"" + importType + "\" at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Cannot import from \"" + importType + "\" at " + sourcePosition(currentToken().start) + ".");
     }
 
     return node;
 }
 
 ASTNode Parser::parseStatement(bool doExecute) {
-    std::string keyword = currentToken().value;
+    std::string keyword = currentToken().value.str();
 
     if (keyword == "function" || keyword == "isolated") {
         Value funcValue = parseFunctionDeclaration(doExecute);
@@ -1832,44 +1891,44 @@ ASTNode Parser::parseStatement(bool doExecute) {
 
     } else if (keyword == "echo" || keyword == "log" || keyword == "logfile") {
         return parseCommand(doExecute);
-    } else if ((match("identifier") || match("string") || isCPPType()) && !isJSONArray) {
+    } else if ((match(TokenKind::IDENTIFIER) || match(TokenKind::STRING) || isCPPType()) && !isJSONArray) {
         return parseVariableDeclaration(doExecute);
-    } else if (match("keyword", "const") && !isJSONArray) {
+    } else if (match(TokenKind::KEYWORD, "const") && !isJSONArray) {
         advance();
         bool isLocal = false;
-        if (match("keyword", "global")) {
+        if (match(TokenKind::KEYWORD, "global")) {
             advance();
             return parseGlobal(doExecute, true);
-        } else if (match("keyword", "local")) {
+        } else if (match(TokenKind::KEYWORD, "local")) {
             advance();
             isLocal = true;
         }
         return parseVariableDeclaration(doExecute, true, isLocal);
-    } else if (match("keyword", "var") && !isJSONArray) {
+    } else if (match(TokenKind::KEYWORD, "var") && !isJSONArray) {
         advance();
         bool isLocal = false;
-        if (match("keyword", "global")) {
+        if (match(TokenKind::KEYWORD, "global")) {
             advance();
             return parseGlobal(doExecute);
-        } else if (match("keyword", "local")) {
+        } else if (match(TokenKind::KEYWORD, "local")) {
             advance();
             isLocal = true;
         }
         return parseVariableDeclaration(doExecute, false, isLocal);
-    } else if (match("keyword", "global") && !isJSONArray) {
+    } else if (match(TokenKind::KEYWORD, "global") && !isJSONArray) {
         advance();
         bool isConst = false;
-        if (match("keyword", "var")) advance();
-        else if (match("keyword", "const")) {
+        if (match(TokenKind::KEYWORD, "var")) advance();
+        else if (match(TokenKind::KEYWORD, "const")) {
             advance();
             isConst = true;
         }
         return parseGlobal(doExecute, isConst);
-    } else if (match("keyword", "local") && !isJSONArray) {
+    } else if (match(TokenKind::KEYWORD, "local") && !isJSONArray) {
         advance();
         bool isConst = false;
-        if (match("keyword", "var")) advance();
-        else if (match("keyword", "const")) {
+        if (match(TokenKind::KEYWORD, "var")) advance();
+        else if (match(TokenKind::KEYWORD, "const")) {
             advance();
             isConst = true;
         }
@@ -1879,8 +1938,8 @@ ASTNode Parser::parseStatement(bool doExecute) {
     }
 }
 ASTNode Parser::parseGlobal(bool doExecute, bool constant) {
-    ASTNode global("GLOBAL", currentToken().value, currentToken().start);
-    if (match("keyword", "function") || match("keyword", "isolated")) {
+    ASTNode global("GLOBAL", currentToken().value.str(), currentToken().start);
+    if (match(TokenKind::KEYWORD, "function") || match(TokenKind::KEYWORD, "isolated")) {
         Value funcValue = parseFunctionDeclaration(doExecute);
         global.value = funcValue;
         global.identifier = funcValue.name;
@@ -1894,26 +1953,26 @@ ASTNode Parser::parseGlobal(bool doExecute, bool constant) {
 }
 
 bool Parser::CanIgnoreNoAssigmentOperator() {
-    return (match("string") || match("number") || match("null") || match("path") || match("link") ||
-            match("hex") || match("binary") || match("boolean") || match("identifier") || match("|") ||
-            match("JavaScript") || match("Luau") || match(endOfScript) || match(".") || match(",") ||
-            match("{") || match("["));
+    return (match(TokenKind::STRING) || match(TokenKind::NUMBER) || match(TokenKind::NULL_VALUE) || match(TokenKind::PATH) || match(TokenKind::LINK) ||
+            match(TokenKind::HEX) || match(TokenKind::BINARY) || match(TokenKind::BOOLEAN) || match(TokenKind::IDENTIFIER) || match(TokenKind::PIPE) ||
+            match(TokenKind::JAVASCRIPT) || match(TokenKind::LUAU) || match(endOfScript) || match(TokenKind::DOT) || match(TokenKind::COMMA) ||
+            match(TokenKind::LEFT_BRACE) || match(TokenKind::LEFT_BRACKET));
 }
 ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool local, bool global) {
     std::string cpptype = "default";
     if (isCPPType()) {
-        cpptype = currentToken().value;
+        cpptype = currentToken().value.str();
         advance();
     }
 
-    std::string identifier = currentToken().value;
+    std::string identifier = currentToken().value.str();
     ASTNode node("VARIABLE_DECLARATION", identifier, currentToken().start);
     node.constant = constant;
     node.local = local;
     advance();
 
     // handle dashes in variable names
-    if (match("-") || match("minus")) {
+    if (match(TokenKind::DASH) || match(TokenKind::MINUS)) {
         size_t originalPos = position;
         size_t lookaheadPos = position;
         std::string potentialIdentifier = identifier;
@@ -1922,21 +1981,21 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
         size_t tokensConsumed = 0;
 
         while (lookaheadPos < tokens.size() &&
-            (tokens[lookaheadPos].type == "minus" || tokens[lookaheadPos].value == "-") &&
+            (tokens[lookaheadPos].kind == TokenKind::MINUS || tokens[lookaheadPos].value == "-") &&
             runs < 128) {
             runs++;
 
-            if (lookaheadPos + 1 < tokens.size() && tokens[lookaheadPos + 1].type == "identifier") {
-                std::string nextType = tokens[lookaheadPos].type;
-                std::string nextValue = tokens[lookaheadPos].value;
+            if (lookaheadPos + 1 < tokens.size() && tokens[lookaheadPos + 1].kind == TokenKind::IDENTIFIER) {
+                TokenKind nextType = tokens[lookaheadPos].kind;
+                std::string nextValue = tokens[lookaheadPos].value.str();
 
-                if (nextType == "=" || nextType == ":" ||
-                    (nextType == "keyword" && (nextValue == "is" || nextValue == "isn't" || nextValue == "isif")) ||
+                if (nextType == TokenKind::EQUAL || nextType == TokenKind::COLON ||
+                    (nextType == TokenKind::KEYWORD && (nextValue == "is" || nextValue == "isn't" || nextValue == "isif")) ||
                     nextValue == "?" || nextValue == "!=") {
                     isVarWithDashes = false;
                     break;
                 }
-                else if (nextType == "minus" || nextValue == "-") {
+                else if (nextType == TokenKind::MINUS || nextValue == "-") {
                     potentialIdentifier += "-" + tokens[lookaheadPos + 1].value;
                     lookaheadPos += 2;
                     tokensConsumed += 2;
@@ -1966,10 +2025,10 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
 
     std::string assignOp;
     std::string typeDecl;
-    if (match(":")) {
+    if (match(TokenKind::COLON)) {
         advance();
-        typeDecl = currentToken().value;
-        if (!match("identifier") && !match("string") && !match("link")) {
+        typeDecl = currentToken().value.str();
+        if (!match(TokenKind::IDENTIFIER) && !match(TokenKind::STRING) && !match(TokenKind::LINK)) {
             // then `:` and `=` are the same
             Value exprValue = applyCPPTypeDeclaration(parseExpression(doExecute), cpptype, DataType::UNKNOWN);
             node.value = exprValue;
@@ -1989,7 +2048,7 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
             return node;
         }
         try {
-            node.typeDeclaration = Utility::typeDeclaration2dataType(typeDecl, Utility::position(currentToken().start, input) + ".");
+            node.typeDeclaration = Utility::typeDeclaration2dataType(typeDecl, sourcePosition(currentToken().start) + ".");
         } catch (...) {
             // then `:` and `=` are the same
             Value exprValue = applyCPPTypeDeclaration(parseExpression(doExecute), cpptype, DataType::UNKNOWN);
@@ -2012,16 +2071,20 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
         advance();
     }
 
-    if (match("keyword", "is") || match("=") || match("-") || match("minus")) {
-        assignOp = currentToken().value;
+    if (match(TokenKind::KEYWORD, "is") || match(TokenKind::EQUAL) || match(TokenKind::DASH) || match(TokenKind::MINUS)) {
+        assignOp = currentToken().value.str();
         advance();
 
+        size_t outerResponseAt = deferredResponseAt;
+        bool plain = !global && cpptype == "default" && node.typeDeclaration == DataType::UNKNOWN && !isBuiltinVariable(identifier);
+        deferredResponseAt = plain ? wholeResponseCall() : std::string::npos;
         Value exprValue = applyCPPTypeDeclaration(parseExpression(doExecute), cpptype, node.typeDeclaration);
+        deferredResponseAt = outerResponseAt;
         node.value = exprValue;
         extractReferences(exprValue, node.references);
     }
-    else if (match("keyword", "isn't") || match("!=")) {
-        assignOp = currentToken().value;
+    else if (match(TokenKind::KEYWORD, "isn't") || match(TokenKind::BANG_EQUAL)) {
+        assignOp = currentToken().value.str();
         advance();
 
         Value exprValue = applyCPPTypeDeclaration(parseExpression(doExecute), cpptype, node.typeDeclaration);
@@ -2029,7 +2092,7 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
         node.value = exprValue;
         extractReferences(exprValue, node.references);
     }
-    else if (match("keyword", "isif") || match("?")) {
+    else if (match(TokenKind::KEYWORD, "isif") || match(TokenKind::QUESTION)) {
         advance();
         Value conditionalValue = parseConditional(doExecute);
         node.value = conditionalValue;
@@ -2043,51 +2106,51 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
         position -= 2;
         parseCommand(doExecute);
     }
-    else if (match("--") || match("++") || match("#") || match("!") || match("~")) { // unary assignment
+    else if (match(TokenKind::MINUS_MINUS) || match(TokenKind::PLUS_PLUS) || match(TokenKind::HASH) || match(TokenKind::BANG) || match(TokenKind::TILDE)) { // unary assignment
         Value var = resolveVariableValue(identifier, false);
-        if (var.type == DataType::UNKNOWN) throw std::runtime_error("Assignment to undefined variable at " + Utility::position(currentToken().start, input) + ".");
+        if (var.type == DataType::UNKNOWN) throw std::runtime_error("Assignment to undefined variable at " + sourcePosition(currentToken().start) + ".");
         
         Value val = var;
-        if (match("--") || match("++")) {
+        if (match(TokenKind::MINUS_MINUS) || match(TokenKind::PLUS_PLUS)) {
             val = Value::createNumber(var.toNumber() + (
-                match("++") ? 1 : -1
+                match(TokenKind::PLUS_PLUS) ? 1 : -1
             ));
-        } else if (match("#")) {
+        } else if (match(TokenKind::HASH)) {
             val = evaluateLengthOperator(var);
-        } else if (match("!")) {
+        } else if (match(TokenKind::BANG)) {
             val = booleanToValue(!var.toBoolean());
-        } else if (match("~")) {
+        } else if (match(TokenKind::TILDE)) {
             if (Utility::checkNumber(var)) {
                 int num = static_cast<int>(var.toNumber());
                 val = numberToValue(~num);
             } else if (var.type == DataType::STRING) {
                 val = stringToValue(Utility::stringNot(var.toString()));
             } else {
-                throw std::runtime_error("Expected number or string for bitwise NOT operation at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected number or string for bitwise NOT operation at " + sourcePosition(currentToken().start) + ".");
             }
         }
         
         advance();
         node.value = val;
-        if (var.isVariable) assign(var, val, " at " + Utility::position(currentToken().start, input) + ".");
+        if (var.isVariable) assign(var, val, currentToken().start);
     }
     else {
         if (isEnd()) {
-            throw std::runtime_error("Expected assignment operator at " + Utility::position(currentToken().start, input) + ", got EOF.");
+            throw std::runtime_error("Expected assignment operator at " + sourcePosition(currentToken().start) + ", got EOF.");
         } else if (CanIgnoreNoAssigmentOperator()) {
             Value exprValue = applyCPPTypeDeclaration(parseExpression(doExecute), cpptype, node.typeDeclaration);
             node.value = exprValue;
             extractReferences(exprValue, node.references);
-        } else throw std::runtime_error("Expected assignment operator at " + Utility::position(currentToken().start, input) + ", got \"" + currentToken().value +"\".");
+        } else throw std::runtime_error("Expected assignment operator at " + sourcePosition(currentToken().start) + ", got \"" + currentToken().value +"\".");
     }
 
     if (node.value.type == DataType::FUNCTION) {
-        if (userFunctions.find(identifier) != userFunctions.end() && userFunctionsConst.find(identifier)->second) {
-            throw std::runtime_error("Assignment to constant function \"" + identifier + "\" at " + Utility::position(currentToken().start, input) + ".");
+        if (userFunctions->functions.find(identifier) != userFunctions->functions.end()) {
+            if (userFunctions->constants[identifier]) {
+                throw std::runtime_error("Assignment to constant function \"" + identifier + "\" at " + sourcePosition(currentToken().start) + ".");
+            }
+            ownUserFunctions().functions.erase(identifier);
         }
-        try {
-            userFunctions.erase(identifier);
-        } catch (...) {}
     }
 
     if (node.local) {
@@ -2122,381 +2185,71 @@ ASTNode Parser::parseVariableDeclaration(bool doExecute, bool constant, bool loc
 }
 
 Value Parser::parseExpression(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    if (match("keyword", "function") || match("keyword", "isolated")) {
+    if (match(TokenKind::KEYWORD, "function") || match(TokenKind::KEYWORD, "isolated")) {
         std::string funcName = std::to_string(position);
         bool gotName = false;
         size_t offset = 1;
         while (!gotName && (
             position - offset >= 0
         )) {
-            ParserToken currToken = tokens[position - offset];
-            if (currToken.type == "identifier") {
+            const ParserToken& currToken = tokens[position - offset];
+            if (currToken.kind == TokenKind::IDENTIFIER) {
                 gotName = true;
-                funcName = currToken.value;
+                funcName = currToken.value.str();
             }
             ++offset;
         }
         return parseFunctionDeclaration(doExecute, funcName, false);
     }
-    Value result = parseConditional(doExecute, identifierMode, doFunctionCall, ignoreColon);
 
-    if (match("--") || match("++") || match("#") || match("!") || match("~")) { // unary assignment
+    Value result;
+    if (!identifierMode && doFunctionCall && foldedConstant(ignoreColon, result)) {
+        return result;
+    }
+    result = parseConditional(doExecute, identifierMode, doFunctionCall, ignoreColon);
+
+    if (match(TokenKind::MINUS_MINUS) || match(TokenKind::PLUS_PLUS) || match(TokenKind::HASH) || match(TokenKind::BANG) || match(TokenKind::TILDE)) { // unary assignment
         Value val = result;
-        if (match("--") || match("++")) {
+        if (match(TokenKind::MINUS_MINUS) || match(TokenKind::PLUS_PLUS)) {
             val = Value::createNumber(result.toNumber() + (
-                match("++") ? 1 : -1
+                match(TokenKind::PLUS_PLUS) ? 1 : -1
             ));
-        } else if (match("#")) {
+        } else if (match(TokenKind::HASH)) {
             val = evaluateLengthOperator(result);
-        } else if (match("!")) {
+        } else if (match(TokenKind::BANG)) {
             val = booleanToValue(!result.toBoolean());
-        } else if (match("~")) {
+        } else if (match(TokenKind::TILDE)) {
             if (Utility::checkNumber(result)) {
                 int num = static_cast<int>(result.toNumber());
                 val = numberToValue(~num);
             } else if (result.type == DataType::STRING) {
                 val = stringToValue(Utility::stringNot(result.toString()));
             } else {
-                throw std::runtime_error("Expected number or string for bitwise NOT operation at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected number or string for bitwise NOT operation at " + sourcePosition(currentToken().start) + ".");
             }
         }
-        if (result.isVariable) assign(result, val, " at " + Utility::position(currentToken().start, input) + ".");
+        if (result.isVariable) assign(result, val, currentToken().start);
     }
 
     return result;
 }
 
-Value Parser::parseConditional(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value condition = parseBitwiseOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    if (!identifierMode) {
-        if (match("keyword", "then") || match("?")) {
-            std::string thenOp = currentToken().value;
-            advance();
-
-            Value thenValue = parseExpression(doExecute, identifierMode, doFunctionCall, true);
-
-            if (match("keyword", "else") || match(":")) {
-                std::string elseOp = currentToken().value;
-                advance();
-
-                Value elseValue = parseExpression(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-                return handleConditional(condition, thenValue, elseValue, thenOp, elseOp);
-            } else {
-                throw std::runtime_error("Expected 'else' after 'then'");
-            }
-        }
-
-        if (match("keyword", "elseif")) {
-            std::string elseifOp = currentToken().value;
-            advance();
-
-            Value elseifCondition = parseExpression(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-            if (match("keyword", "then") || match("?")) {
-                std::string thenOp = currentToken().value;
-                advance();
-
-                Value thenValue = parseExpression(doExecute, identifierMode, doFunctionCall, true);
-
-                if (match("keyword", "else") || match(":")) {
-                    std::string elseOp = currentToken().value;
-                    advance();
-
-                    Value elseValue = parseExpression(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-                    Value nestedConditional = handleConditional(elseifCondition, thenValue, elseValue, thenOp, elseOp);
-                    return handleConditional(condition, thenValue, nestedConditional, thenOp, elseOp);
-                } else {
-                    throw std::runtime_error("Expected 'else' after 'then' in elseif");
-                }
-            } else {
-                throw std::runtime_error("Expected 'then' after 'elseif'");
-            }
-        }
-    }
-
-    return condition;
-}
-
 Value Parser::getIdentifier() {
-    Value result = stringToValue(currentToken().value);
+    Value result = stringToValue(currentToken().value.str());
     advance();
     return result;
 }
 
-Value Parser::parseBitwiseOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseBitwiseXOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "OR") || match("|")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseBitwiseXOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-Value Parser::parseBitwiseXOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseBitwiseAND(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "XOR") || match("^")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseBitwiseAND(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-Value Parser::parseBitwiseAND(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseBitwiseNOT(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "AND") || match("&")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseBitwiseNOT(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-Value Parser::parseBitwiseSHIFT(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parsePipelineOrMethodCall(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("<<") || match(">>")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parsePipelineOrMethodCall(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseBitwiseNOT(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    if (match("keyword", "NOT") || match("~")) {
-        Value left;
-
-        while (match("keyword", "NOT") || match("~")) {
-            std::string op = currentToken().value;
-            advance();
-
-            Value right = parseBitwiseSHIFT(doExecute, identifierMode, doFunctionCall, ignoreColon);
-            left = evaluateExpression(left, op, right, doExecute);
-        }
-
-        return left;
-    }
-    else return parseBitwiseSHIFT(doExecute, identifierMode, doFunctionCall, ignoreColon);
-}
-
-Value Parser::parsePipelineOrMethodCall(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseElvisOrNullCoalescing(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("|>") || (
-        left.type != DataType::VARIABLE && left.type != DataType::UNKNOWN && (match("[") ||
-            (match(".") && position + 1 < tokens.size() && ((position - 1 >= 0 && tokens[position - 1].type != "keyword") || !(position - 1 >= 0)))
-        )
-    )) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = op == "." && match("identifier") ? getIdentifier() : parseElvisOrNullCoalescing(doExecute, true, false, true);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseElvisOrNullCoalescing(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseLogicalOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("?:") || match("??")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseLogicalOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseLogicalOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseLogicalXOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "or") || match("||") ||
-           match("keyword", "orn't") || match("!|") ||
-           match("keyword", "nor")
-        ) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseLogicalXOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseLogicalXOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseLogicalAND(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "xor") || match("keyword", "xnor")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseLogicalAND(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseLogicalAND(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseLogicalIMPLY(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "and") || match("&&") ||
-           match("keyword", "andn't") || match("!&") ||
-           match("keyword", "nand")
-        ) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseLogicalIMPLY(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseLogicalIMPLY(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseEquality(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("keyword", "imply") || match("keyword", "nimply")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseEquality(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseEquality(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseComparison(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    if (!identifierMode) {
-        while (match("keyword", "is") || match("==") ||
-            match("keyword", "isn't") || match("!=") ||
-            match("~=") || match("=")
-        ) {
-            std::string op = currentToken().value;
-            advance();
-
-            Value right = parseComparison(doExecute, identifierMode, doFunctionCall, ignoreColon);
-            left = evaluateExpression(left, op, right, doExecute);
-        }
-    }
-
-    return left;
-}
-
-Value Parser::parseComparison(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseTerm(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("<") || match(">") || match("<=") || match(">=")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseTerm(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseTerm(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseFactor(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("+") || match("minus") || match("..")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseFactor(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseFactor(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parsePower(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("*") || match("/") || match("%") || (match(":") && !(identifierMode || ignoreColon))) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = op == ":" && !Utility::checkNumber(right) ? (
-            match("identifier") ? getIdentifier() : parsePower(doExecute, true, false, true) // method call
-        ) : parsePower(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parsePower(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    Value left = parseUnary(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-    while (match("**")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseUnary(doExecute, identifierMode, doFunctionCall, ignoreColon);
-        left = evaluateExpression(left, op, right, doExecute);
-    }
-
-    return left;
-}
-
-Value Parser::parseUnary(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon) {
-    if ((match("minus") && !identifierMode) || match("+") || match("!") ||
-        (match("-") && !identifierMode) || match("#")) {
-        std::string op = currentToken().value;
-        advance();
-
-        Value right = parseUnary(doExecute, identifierMode, doFunctionCall, ignoreColon);
-
-        if (op == "#") {
-            return evaluateLengthOperator(right);
-        }
-
-        return evaluateExpression(Value(), op, right, doExecute);
-    }
-
-    if (
-        match("**") || match("*") || match("/") || match("%") || match("..") || (!identifierMode && (
-            match(":") || match("=") || match("!=") || match("keyword", "is") || match("keyword", "isn't")
-        )) || match("keyword", "imply") || match("keyword", "nimply") || match("&&") || match("!&") ||
-        match("keyword", "and") || match("keyword", "nand") || match("keyword", "andn't") ||
-        match("keyword", "xor") || match("keyword", "xnor") || match("||") || match("!|") ||
-        match("keyword", "or") || match("keyword", "nor") || match("keyword", "orn't") || match("~") ||
-        match("keyword", "NOT") || match("<<") || match(">>") || match("keyword", "AND") || match("&") ||
-        match("keyword", "XOR") || match("^") || match("keyword", "OR") || match("|")
-    ) {
-        return parseBitwiseOR(doExecute, identifierMode, doFunctionCall, ignoreColon);
-    }
-
-    return parsePrimary(doExecute, doFunctionCall);
+bool Parser::isOperatorStart(bool identifierMode) const {
+    return
+        match(TokenKind::STAR_STAR) || match(TokenKind::STAR) || match(TokenKind::SLASH) || match(TokenKind::PERCENT) || match(TokenKind::DOT_DOT) || (!identifierMode && (
+            match(TokenKind::COLON) || match(TokenKind::EQUAL) || match(TokenKind::BANG_EQUAL) || match(TokenKind::KEYWORD, "is") || match(TokenKind::KEYWORD, "isn't")
+        )) || match(TokenKind::KEYWORD, "imply") || match(TokenKind::KEYWORD, "nimply") || match(TokenKind::AMP_AMP) || match(TokenKind::BANG_AMP) ||
+        match(TokenKind::KEYWORD, "and") || match(TokenKind::KEYWORD, "nand") || match(TokenKind::KEYWORD, "andn't") ||
+        match(TokenKind::KEYWORD, "xor") || match(TokenKind::KEYWORD, "xnor") || match(TokenKind::PIPE_PIPE) || match(TokenKind::BANG_PIPE) ||
+        match(TokenKind::KEYWORD, "or") || match(TokenKind::KEYWORD, "nor") || match(TokenKind::KEYWORD, "orn't") || match(TokenKind::TILDE) ||
+        match(TokenKind::KEYWORD, "NOT") || match(TokenKind::LESS_LESS) || match(TokenKind::GREATER_GREATER) || match(TokenKind::KEYWORD, "AND") || match(TokenKind::AMP) ||
+        match(TokenKind::KEYWORD, "XOR") || match(TokenKind::CARET) || match(TokenKind::KEYWORD, "OR") || match(TokenKind::PIPE);
 }
 
 Value Parser::evaluateLengthOperator(const Value& value) {
@@ -2525,20 +2278,20 @@ Value Parser::evaluateLengthOperator(const Value& value) {
 
         case DataType::JSON_ARRAY:
             result.type = DataType::NUMBER;
-            result.number_value = static_cast<double>(value.array_elements.size());
-            result.name = std::to_string(value.array_elements.size());
+            result.number_value = static_cast<double>(value.array_elements().size());
+            result.name = std::to_string(value.array_elements().size());
             break;
 
         case DataType::JSON_OBJECT:
             result.type = DataType::NUMBER;
-            result.number_value = static_cast<double>(value.properties.size());
-            result.name = std::to_string(value.properties.size());
+            result.number_value = static_cast<double>(value.properties().size());
+            result.name = std::to_string(value.properties().size());
             break;
 
         case DataType::BINARY_DATA:
             result.type = DataType::NUMBER;
-            result.number_value = static_cast<double>(value.binary_data.size());
-            result.name = std::to_string(value.binary_data.size());
+            result.number_value = static_cast<double>(value.binary_data().size());
+            result.name = std::to_string(value.binary_data().size());
             break;
 
         case DataType::NUMBER: {
@@ -2553,7 +2306,7 @@ Value Parser::evaluateLengthOperator(const Value& value) {
         }
 
         default:
-            throw std::runtime_error("Cannot apply length operator to type " + dataTypeToString(value.type) + " at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Cannot apply length operator to type " + dataTypeToString(value.type) + " at " + sourcePosition(currentToken().start) + ".");
     }
 
     return result;
@@ -2572,8 +2325,8 @@ Value Parser::astNodeToValue(const ASTNode& node) {
 }
 
 Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
-    if (match("number")) {
-        std::string numStr = currentToken().value;
+    if (match(TokenKind::NUMBER)) {
+        std::string numStr = currentToken().value.str();
         double num = parseNumber(numStr);
         advance();
         Value result = numberToValue(num);
@@ -2586,27 +2339,27 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
 
         return result;
     }
-    else if (match("hex")) {
-        std::string hexStr = currentToken().value;
+    else if (match(TokenKind::HEX)) {
+        std::string hexStr = currentToken().value.str();
         advance();
         return hexToValue(hexStr);
     }
-    else if (match("binary")) {
-        std::string binStr = currentToken().value;
+    else if (match(TokenKind::BINARY)) {
+        std::string binStr = currentToken().value.str();
         advance();
         return binaryToValue(binStr);
     }
-    else if (match("string")) {
-        std::string str = currentToken().value;
+    else if (match(TokenKind::STRING)) {
+        std::string str = currentToken().value.str();
         advance();
         return stringToValue(str);
     }
-    else if (match("link")) {
-        std::string link = currentToken().value;
+    else if (match(TokenKind::LINK)) {
+        std::string link = currentToken().value.str();
         advance();
         return linkToValue(link);
     }
-    else if (match("boolean")) {
+    else if (match(TokenKind::BOOLEAN)) {
         auto toLower = [](const std::string& str) {
             std::string result = str;
             std::transform(result.begin(), result.end(), result.begin(),
@@ -2614,23 +2367,23 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
             return result;
         };
 
-        std::string tokenValue = currentToken().value;
+        std::string tokenValue = currentToken().value.str();
         bool b = (toLower(tokenValue) == "true" ||
                   toLower(tokenValue) == "yes" ||
                   toLower(tokenValue) == "y");
         advance();
         return booleanToValue(b);
     }
-    else if (match("null")) {
+    else if (match(TokenKind::NULL_VALUE)) {
         Value result;
         result.type = DataType::NULL_TYPE;
         result.name = "null";
         advance();
         return result;
     }
-    else if (match("identifier")) {
-        std::string varName = currentToken().value;
-        if ((peekToken().type == "." && position + 2 < tokens.size()) || peekToken().type == "[") {
+    else if (match(TokenKind::IDENTIFIER)) {
+        std::string varName = currentToken().value.str();
+        if ((peekToken().kind == TokenKind::DOT && position + 2 < tokens.size()) || peekToken().kind == TokenKind::LEFT_BRACKET) {
             return parseObjectPropertyAccess(doExecute);
         }
 
@@ -2643,9 +2396,9 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
             return executeFunction(varName.substr(1), {}, currentToken().start);
         }
 
-        if (peekToken().type == "(") {
+        if (peekToken().kind == TokenKind::LEFT_PAREN) {
             return parseFunctionCall(doExecute, doFunctionCall);
-        } else if (peekToken().type == "::") {
+        } else if (peekToken().kind == TokenKind::COLON_COLON) {
             return parseSpaceCall(doExecute, doFunctionCall);
         }
 
@@ -2659,55 +2412,55 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
             return result;
         }
     }
-    else if (match("keyword") && peekToken().type == "(") {
+    else if (match(TokenKind::KEYWORD) && peekToken().kind == TokenKind::LEFT_PAREN) {
         return parseFunctionCall(doExecute, doFunctionCall);
     }
-    else if (match("(")) {
+    else if (match(TokenKind::LEFT_PAREN)) {
         advance();
         Value result = parseExpression(doExecute, false, doFunctionCall);
-        if (!match(")")) {
-            throw std::runtime_error("Expected \")\" at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::RIGHT_PAREN)) {
+            throw std::runtime_error("Expected \")\" at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
         return result;
     }
     else if ((
-        (endOfScript == "." && match(".") && tokens[position + 1].type != "number") ||
-        (endOfScript != "." && match(endOfScript))
-    ) || (match(",") && tokens[position + 1].type != "number") || match(";")) {
+        (endOfScript == TokenKind::DOT && match(TokenKind::DOT) && tokens[position + 1].kind != TokenKind::NUMBER) ||
+        (endOfScript != TokenKind::DOT && match(endOfScript))
+    ) || (match(TokenKind::COMMA) && tokens[position + 1].kind != TokenKind::NUMBER) || match(TokenKind::SEMICOLON)) {
         Value result;
         result.type = DataType::NULL_TYPE;
         result.string_value = "null";
         result.name = "null";
         return result;
     }
-    else if (match("keyword") || match("?") || match("!=") || match("=")) {
+    else if (match(TokenKind::KEYWORD) || match(TokenKind::QUESTION) || match(TokenKind::BANG_EQUAL) || match(TokenKind::EQUAL)) {
         return astNodeToValue(parseStatement(doExecute));
     }
-    else if ((match(".") || match(",")) && position + 1 < tokens.size() && tokens[position + 1].type == "number") {
+    else if ((match(TokenKind::DOT) || match(TokenKind::COMMA)) && position + 1 < tokens.size() && tokens[position + 1].kind == TokenKind::NUMBER) {
         advance();
         double num = parseNumber("0." + currentToken().value);
         advance();
         return numberToValue(num);
     }
-    else if (match("|")) {
+    else if (match(TokenKind::PIPE)) {
         return parseJustcObject(doExecute);
     }
-    else if (match("{")) {
+    else if (match(TokenKind::LEFT_BRACE)) {
         size_t savedPos = position;
         return parseJsonObject(doExecute);
     }
-    else if (match("[")) {
+    else if (match(TokenKind::LEFT_BRACKET)) {
         return parseJsonArray(doExecute);
     }/*
-    else if (match("|")) {
+    else if (match(TokenKind::PIPE)) {
         advance();
         std::stringstream object;
-        while (!match(".")) {
+        while (!match(TokenKind::DOT)) {
             object << currentToken().value;
             advance();
             if (isEnd()) {
-                throw std::runtime_error("Expected \".\" to close object, got EOF at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected \".\" to close object, got EOF at " + sourcePosition(currentToken().start) + ".");
             }
         }
         object << ".";
@@ -2718,10 +2471,10 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
         result.name = objectstr;
         return result;
     }*/
-    else if (match("JavaScript") && doExecute && allowJavaScript) {
+    else if (match(TokenKind::JAVASCRIPT) && doExecute && allowJavaScript) {
         #ifdef __EMSCRIPTEN__
 
-        Value result = runJavaScript(currentToken().value, Utility::position(currentToken().start, input), true);
+        Value result = runJavaScript(currentToken().value.str(), sourcePosition(currentToken().start), true);
         addLog("JAVASCRIPT", Utility::value2string(result), currentToken().start);
         advance();
         result.name = "{{" + currentToken().value + "}}";
@@ -2729,9 +2482,9 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
 
         #elif !defined(_MSC_VER)
 
-        std::pair<std::string, bool> jsresult = JavaScript::Eval(currentToken().value);
+        std::pair<std::string, bool> jsresult = JavaScript::Eval(currentToken().value.str());
         if (jsresult.second) {
-            throw std::runtime_error("JavaScript error at " + Utility::position(currentToken().start, input) + ":\n" + jsresult.first);
+            throw std::runtime_error("JavaScript error at " + sourcePosition(currentToken().start) + ":\n" + jsresult.first);
         } else {
             addLog("JAVASCRIPT", jsresult.first, currentToken().start);
         }
@@ -2742,16 +2495,16 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
 
         #endif
     }
-    else if (match("JavaScript")) {
+    else if (match(TokenKind::JAVASCRIPT)) {
         #ifdef __EMSCRIPTEN__
-        if (!allowJavaScript) warn_js_disabled_by_justc(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
-        else warn_js_disabled(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
+        if (!allowJavaScript) warn_js_disabled_by_justc(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
+        else warn_js_disabled(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
         #endif
         advance();
         return Value::createNull();
     }
-    else if (match("Luau") && doExecute && allowLuau) {
-        std::pair<std::string, int> luauresult = RunLuau::runScriptWithResult(currentToken().value);
+    else if (match(TokenKind::LUAU) && doExecute && allowLuau) {
+        std::pair<std::string, int> luauresult = RunLuau::runScriptWithResult(currentToken().value.str());
         Value result;
 
         switch (luauresult.second) {
@@ -2782,34 +2535,34 @@ Value Parser::parsePrimary(bool doExecute, bool doFunctionCall) {
         result.name = "<<" + currentToken().value + ">>";
         return result;
     }
-    else if (match("Luau")) {
+    else if (match(TokenKind::LUAU)) {
         #ifdef __EMSCRIPTEN__
-        if (!allowLuau) warn_luau_disabled_by_justc(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
-        else warn_luau_disabled(Utility::position(currentToken().start, input).c_str(), currentToken().value.c_str(), getCurrentTimestamp().c_str());
+        if (!allowLuau) warn_luau_disabled_by_justc(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
+        else warn_luau_disabled(sourcePosition(currentToken().start).c_str(), currentToken().value.str().c_str(), getCurrentTimestamp().c_str());
         #endif
         advance();
         return Value::createNull();
     }
-    else if (match("jsx_element")) {
-        std::string jsxStr = currentToken().value;
+    else if (match(TokenKind::JSX_ELEMENT)) {
+        std::string jsxStr = currentToken().value.str();
         advance();
         return parseJSXElement(jsxStr);
     }
 
-    throw std::runtime_error("Invalid or unexpected token \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+    throw std::runtime_error("Invalid or unexpected token \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
 }
 
 Value Parser::parseFunctionCall(bool doExecute, bool doFunctionCall) {
-    std::string funcName = currentToken().value;
+    std::string funcName = currentToken().value.str();
     size_t startPos = currentToken().start;
 
-    while (peekToken().type == "." && position + 2 < tokens.size()) {
+    while (peekToken().kind == TokenKind::DOT && position + 2 < tokens.size()) {
         advance();
-        if (match("identifier") || match("keyword")) {
+        if (match(TokenKind::IDENTIFIER) || match(TokenKind::KEYWORD)) {
             funcName += "." + currentToken().value;
             advance();
         } else {
-            throw std::runtime_error("Unexpected end of script at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected end of script at " + sourcePosition(currentToken().start) + ".");
         }
     }
 
@@ -2818,37 +2571,37 @@ Value Parser::parseFunctionCall(bool doExecute, bool doFunctionCall) {
     if (!doFunctionCall) return funcValue;
     
     if (funcValue.type == DataType::FUNCTION) {
-        if (!match("(")) {
-            throw std::runtime_error("Expected '(' after function name at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::LEFT_PAREN)) {
+            throw std::runtime_error("Expected '(' after function name at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
 
         std::vector<Value> args;
-        while (!match(")") && !isEnd()) {
+        while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
             args.push_back(parseExpression(doExecute));
-            if (match(",") || match(";")) advance();
+            if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
         }
 
-        if (!match(")")) {
-            throw std::runtime_error("Expected ')' after function arguments at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::RIGHT_PAREN)) {
+            throw std::runtime_error("Expected ')' after function arguments at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
 
         return callFunction(funcValue, args, currentToken().start, doExecute);
     } else {
-        if (!match("(")) {
-            throw std::runtime_error("Expected '(' after function name at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::LEFT_PAREN)) {
+            throw std::runtime_error("Expected '(' after function name at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
 
         std::vector<Value> args;
-        while (!match(")") && !isEnd()) {
+        while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
             args.push_back(parseExpression(doExecute));
-            if (match(",") || match(";")) advance();
+            if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
         }
 
-        if (!match(")")) {
-            throw std::runtime_error("Expected ')' after function arguments at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::RIGHT_PAREN)) {
+            throw std::runtime_error("Expected ')' after function arguments at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
 
@@ -2856,11 +2609,11 @@ Value Parser::parseFunctionCall(bool doExecute, bool doFunctionCall) {
     }
 }
 Value Parser::parseSpaceCall(bool doExecute, bool doFunctionCall) {
-    std::string spaceName = currentToken().value;
+    std::string spaceName = currentToken().value.str();
     advance();
 
-    if (!match("::")) {
-        throw std::runtime_error("Expected \"::\" after space name at " + Utility::position(currentToken().start, input) + ".");
+    if (!match(TokenKind::COLON_COLON)) {
+        throw std::runtime_error("Expected \"::\" after space name at " + sourcePosition(currentToken().start) + ".");
     }
     advance();
 
@@ -2869,16 +2622,16 @@ Value Parser::parseSpaceCall(bool doExecute, bool doFunctionCall) {
 }
 
 ASTNode Parser::parseCommand(bool doExecute) {
-    ASTNode node("COMMAND", currentToken().value, currentToken().start);
-    std::string command = currentToken().value;
+    ASTNode node("COMMAND", currentToken().value.str(), currentToken().start);
+    std::string command = currentToken().value.str();
     advance();
     std::vector<Value> args;
 
-    if (doExecute && (command == "echo" || command == "logfile" || command == "log") && !match("(")) {
-        while (!match(",") && !match(";") && !match(endOfScript) && !isEnd()) {
+    if (doExecute && (command == "echo" || command == "logfile" || command == "log") && !match(TokenKind::LEFT_PAREN)) {
+        while (!match(TokenKind::COMMA) && !match(TokenKind::SEMICOLON) && !match(endOfScript) && !isEnd()) {
             args.push_back(parseExpression(doExecute));
         }
-        if (match(",") || match(";")) advance();
+        if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
 
         if (command == "echo") {
             for (const auto& arg : args) {
@@ -2911,13 +2664,13 @@ ASTNode Parser::parseCommand(bool doExecute) {
         return node;
     }
 
-    if (match("(")) {
+    if (match(TokenKind::LEFT_PAREN)) {
         advance();
-        while (!match(")") && !isEnd()) {
+        while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
             args.push_back(parseExpression(doExecute));
-            if (match(",") || match(";")) advance();
+            if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
         }
-        if (match(")")) advance();
+        if (match(TokenKind::RIGHT_PAREN)) advance();
     }
 
     if (doExecute) {
@@ -2954,9 +2707,9 @@ ASTNode Parser::parseCommand(bool doExecute) {
     return node;
 }
 
-Value Parser::onExecDisabled(size_t startPos, std::string name) {
+Value Parser::onExecDisabled(size_t startPos, const std::string& name) {
     #ifdef __EMSCRIPTEN__
-    warn_exec_disabled(Utility::position(startPos, input).c_str(), name.c_str(), getCurrentTimestamp().c_str());
+    warn_exec_disabled(sourcePosition(startPos).c_str(), name.c_str(), getCurrentTimestamp().c_str());
     #endif
 
     Value result;
@@ -2967,264 +2720,280 @@ Value Parser::onExecDisabled(size_t startPos, std::string name) {
 }
 
 Value Parser::executeFunction(const std::string& funcName, const std::vector<Value>& args, size_t startPos) {
+    return executeFunction(funcName, args, startPos, findBuiltinFunction(funcName));
+}
+Value Parser::executeFunction(const std::string& funcName, const std::vector<Value>& args, size_t startPos, const BuiltinFunction* builtin) {
     if (!doExecute) {
         return onExecDisabled(startPos, funcName);
     }
 
-    auto customIt = userFunctions.find(funcName);
-    if (customIt != userFunctions.end()) {
+    auto customIt = userFunctions->functions.find(funcName);
+    if (customIt != userFunctions->functions.end()) {
         try {
             return customIt->second(args);
         } catch (const std::exception& e) {
-            throw std::runtime_error(std::string(e.what()) + " at " + Utility::position(startPos, input));
+            throw std::runtime_error(std::string(e.what()) + " at " + sourcePosition(startPos));
         }
     }
 
-    if (funcName == "TIME") {
-        long timestamp = getCurrentTime();
-        return numberToValue(timestamp);
-    }
-    else if (funcName == "Math.PI") {
-        return numberToValue(Math::PI);
-    }
-    else if (funcName == "Backslash") {
-        return stringToValue("\\");
-    }
-    else if (funcName == "Version" || funcName == "JUSTC.Version" || funcName == "JUSTO.Version") {
-        return stringToValue(JUSTC_VERSION);
-    }
-    else if (funcName == "Math.E") {
-        return numberToValue(Math::E);
-    }
-    else if (funcName == "Math.LN2") {
-        return numberToValue(Math::LN2);
-    }
-    else if (funcName == "Math.LN10") {
-        return numberToValue(Math::LN10);
-    }
-    else if (funcName == "Math.SQRT2") {
-        return numberToValue(Math::SQRT2);
+    if (!builtin || args.size() < builtin->minArgs) {
+        if (args.empty()) {
+            throw std::runtime_error("Expected at least one argument, got 0 at " + sourcePosition(startPos) + ".");
+        }
+        throw std::runtime_error("\"" + funcName + "\" is not a function.");
     }
-    else if (funcName == "Math.SQRT1_2") {
-        return numberToValue(Math::SQRT1_2);
+    if (!builtin->wrapErrors) {
+        return callBuiltin(builtin->id, funcName, args, startPos);
     }
-    else if (funcName == "Math.LOG2E") {
-        return numberToValue(Math::LOG2E);
+    try {
+        return callBuiltin(builtin->id, funcName, args, startPos);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string(e.what()) + " at " + sourcePosition(startPos) + ".");
     }
-    else if (funcName == "Math.LOG10E") {
-        return numberToValue(Math::LOG10E);
+}
+const BuiltinFunction* Parser::findBuiltinFunction(const std::string& funcName) const {
+    auto it = tables.builtinFunctions.find(funcName);
+    return it != tables.builtinFunctions.end() ? &it->second : nullptr;
+}
+namespace {
+    bool isPureBuiltin(Builtin id) {
+        switch (id) {
+            case Builtin::MATH_PI: case Builtin::MATH_E: case Builtin::MATH_LN2: case Builtin::MATH_LN10:
+            case Builtin::MATH_SQRT2: case Builtin::MATH_SQRT1_2: case Builtin::MATH_LOG2E: case Builtin::MATH_LOG10E:
+            case Builtin::MATH_ABS: case Builtin::MATH_ACOS: case Builtin::MATH_ASIN: case Builtin::MATH_ATAN:
+            case Builtin::MATH_ATAN2: case Builtin::MATH_CEIL: case Builtin::MATH_COS: case Builtin::MATH_CLAMP:
+            case Builtin::MATH_CUBE: case Builtin::MATH_DOUBLE: case Builtin::MATH_EXP: case Builtin::MATH_FACTORIAL:
+            case Builtin::MATH_FLOOR: case Builtin::MATH_HYPOT: case Builtin::MATH_IS_PRIME: case Builtin::MATH_LERP:
+            case Builtin::MATH_LOG: case Builtin::MATH_LOG10: case Builtin::MATH_MAX: case Builtin::MATH_MIN:
+            case Builtin::MATH_POW: case Builtin::MATH_ROUND: case Builtin::MATH_SIGN: case Builtin::MATH_SIN:
+            case Builtin::MATH_SQRT: case Builtin::MATH_SQUARE: case Builtin::MATH_TAN: case Builtin::MATH_TO_DEGREES:
+            case Builtin::MATH_TO_RADIANS:
+                return true;
+            default:
+                return false;
+        }
     }
+}
 
-    // built-in
-    if (funcName == "valueof") return functionVALUE(args);
-    if (funcName == "String") return functionSTRING(args);
-    if (funcName == "Link") return functionLINK(args);
-    if (funcName == "Binary") return functionBINARY(args);
-    if (funcName == "Octal") return functionOCTAL(args);
-    if (funcName == "Hexadecimal") return functionHEXADECIMAL(args);
-    if (funcName == "typeid") return functionTYPEID(args);
-    if (funcName == "typeof") return functionTYPEOF(args);
-    if (funcName == "echo") return functionECHO(args);
-    if (funcName == "Number") {
-        if (args.empty()) return numberToValue(0.0);
-        return numberToValue(args[0].toNumber());
-    }
-    if (funcName == "JSON") return functionJSON(args);
-    if (funcName == "HTTP.GET") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "GET", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "GET", args);
-    }
-    if (funcName == "HTTP.POST") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "POST", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "POST", args);
-    }
-    if (funcName == "HTTP.PUT") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "PUT", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "PUT", args);
-    }
-    if (funcName == "HTTP.PATCH") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "PATCH", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "PATCH", args);
-    }
-    if (funcName == "HTTP.DELETE") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "DELETE", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "DELETE", args);
-    }
-    if (funcName == "HTTP.HEAD") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "HEAD", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "HEAD", args);
-    }
-    if (funcName == "HTTP.OPTIONS") {
-        if (runAsync) {
-            auto future = functionHTTPAsync(startPos, "OPTIONS", args);
-            return future.get();
-        }
-        return functionHTTP(startPos, "OPTIONS", args);
-    }
-    if (funcName == "JUSTC") return functionJUSTC(args, startPos);
-    if (funcName == "file") {
-        if (runAsync) {
-            auto future = functionFILEAsync(args);
-            return future.get();
+void Parser::registerBuiltinFunctions(std::unordered_map<std::string, BuiltinFunction>& functions) {
+    auto add = [&functions](std::initializer_list<const char*> names, Builtin id, size_t minArgs, bool wrapErrors) {
+        for (const char* name : names) {
+            functions.emplace(name, BuiltinFunction{id, minArgs, wrapErrors, isPureBuiltin(id)});
         }
-        return functionFILE(args);
-    }
-    if (funcName == "size") return functionSTAT(args);
-    if (funcName == "env") return functionENV(args);
-    if (funcName == "config") return functionCONFIG(args);
+    };
 
-    if (funcName == "JavaScript.IsAllowed") {
-        return booleanToValue(allowJavaScript);
-    }
-    if (funcName == "Luau.IsAllowed") {
-        return booleanToValue(allowLuau);
-    }
+    add({"TIME"}, Builtin::TIME, 0, false);
+    add({"Math.PI"}, Builtin::MATH_PI, 0, false);
+    add({"Backslash"}, Builtin::BACKSLASH, 0, false);
+    add({"Version", "JUSTC.Version", "JUSTO.Version"}, Builtin::VERSION, 0, false);
+    add({"Math.E"}, Builtin::MATH_E, 0, false);
+    add({"Math.LN2"}, Builtin::MATH_LN2, 0, false);
+    add({"Math.LN10"}, Builtin::MATH_LN10, 0, false);
+    add({"Math.SQRT2"}, Builtin::MATH_SQRT2, 0, false);
+    add({"Math.SQRT1_2"}, Builtin::MATH_SQRT1_2, 0, false);
+    add({"Math.LOG2E"}, Builtin::MATH_LOG2E, 0, false);
+    add({"Math.LOG10E"}, Builtin::MATH_LOG10E, 0, false);
+
+    // built-in
+    add({"valueof"}, Builtin::VALUEOF, 0, false);
+    add({"String"}, Builtin::STRING, 0, false);
+    add({"Link"}, Builtin::LINK, 0, false);
+    add({"Binary"}, Builtin::BINARY, 0, false);
+    add({"Octal"}, Builtin::OCTAL, 0, false);
+    add({"Hexadecimal"}, Builtin::HEXADECIMAL, 0, false);
+    add({"typeid"}, Builtin::TYPEID, 0, false);
+    add({"typeof"}, Builtin::TYPEOF, 0, false);
+    add({"echo"}, Builtin::ECHO, 0, false);
+    add({"Number"}, Builtin::NUMBER, 0, false);
+    add({"JSON"}, Builtin::JSON, 0, false);
+    add({"HTTP.GET", "HTTP.POST", "HTTP.PUT", "HTTP.PATCH", "HTTP.DELETE", "HTTP.HEAD", "HTTP.OPTIONS"}, Builtin::HTTP, 0, false);
+    add({"JUSTC"}, Builtin::JUSTC, 0, false);
+    add({"file"}, Builtin::FILE, 0, false);
+    add({"size"}, Builtin::SIZE, 0, false);
+    add({"env"}, Builtin::ENV, 0, false);
+    add({"config"}, Builtin::CONFIG, 0, false);
+    add({"JavaScript.IsAllowed"}, Builtin::JAVASCRIPT_IS_ALLOWED, 0, false);
+    add({"Luau.IsAllowed"}, Builtin::LUAU_IS_ALLOWED, 0, false);
 
     // math and binary
-    if (args.empty() && funcName != "Math.Random") {
-        if (funcName == "JUSTC.Parse" || funcName == "JUSTC.Execute") {
-            return emptyJUSTC();
-        }
-        if (funcName == "JUSTO.Stringify") {
-            return stringToValue("");
-        }
-        if (funcName == "JUSTC.Stringify") {
-            return stringToValue("return.");
-        }
-        throw std::runtime_error("Expected at least one argument, got 0 at " + Utility::position(startPos, input) + ".");
-    }
-    double inpnum = args[0].number_value;
-    try {
-        if (funcName == "Binary::ToText") {
-            return Binary::ToText(args);
-        }
-        if (funcName == "Binary::FromText") {
-            return Binary::FromText(args);
-        }
-        if (funcName == "Binary::ToDataURL") {
-            return Binary::ToDataURL(args);
-        }
-        if (funcName == "Binary::FromDataURL") {
-            return Binary::FromDataURL(args);
-        }
-        if (funcName == "Binary::Data") {
-            return Binary::Data(args);
-        }
-        if (funcName == "Math.Abs") {
-            return Value::createNumber(Math::Abs(inpnum));
-        }
-        if (funcName == "Math.Acos") {
-            return Value::createNumber(Math::Acos(inpnum));
-        }
-        if (funcName == "Math.Asin") {
-            return Value::createNumber(Math::Asin(inpnum));
-        }
-        if (funcName == "Math.Atan") {
-            return Value::createNumber(Math::Atan(inpnum));
-        }
-        if (funcName == "Math.Atan2") {
-            return Value::createNumber(Math::Atan2(inpnum, args[1].number_value));
-        }
-        if (funcName == "Math.Ceil") {
-            return Value::createNumber(Math::Ceil(inpnum));
-        }
-        if (funcName == "Math.Cos") {
-            return Value::createNumber(Math::Cos(inpnum));
-        }
-        if (funcName == "Math.Clamp") {
-            return Value::createNumber(Math::Clamp(inpnum, args[1].number_value, args[2].number_value));
-        }
-        if (funcName == "Math.Cube") {
-            return Value::createNumber(inpnum * inpnum * inpnum);
-        }
-        if (funcName == "Math.Double") {
-            return Value::createNumber(inpnum * 2);
-        }
-        if (funcName == "Math.Exp") {
-            return Value::createNumber(Math::Exp(inpnum));
-        }
-        if (funcName == "Math.Factorial") {
+    add({"Binary::ToText"}, Builtin::BINARY_TO_TEXT, 1, true);
+    add({"Binary::FromText"}, Builtin::BINARY_FROM_TEXT, 1, true);
+    add({"Binary::ToDataURL"}, Builtin::BINARY_TO_DATA_URL, 1, true);
+    add({"Binary::FromDataURL"}, Builtin::BINARY_FROM_DATA_URL, 1, true);
+    add({"Binary::Data"}, Builtin::BINARY_DATA, 1, true);
+    add({"Math.Abs"}, Builtin::MATH_ABS, 1, true);
+    add({"Math.Acos"}, Builtin::MATH_ACOS, 1, true);
+    add({"Math.Asin"}, Builtin::MATH_ASIN, 1, true);
+    add({"Math.Atan"}, Builtin::MATH_ATAN, 1, true);
+    add({"Math.Atan2"}, Builtin::MATH_ATAN2, 1, true);
+    add({"Math.Ceil"}, Builtin::MATH_CEIL, 1, true);
+    add({"Math.Cos"}, Builtin::MATH_COS, 1, true);
+    add({"Math.Clamp"}, Builtin::MATH_CLAMP, 1, true);
+    add({"Math.Cube"}, Builtin::MATH_CUBE, 1, true);
+    add({"Math.Double"}, Builtin::MATH_DOUBLE, 1, true);
+    add({"Math.Exp"}, Builtin::MATH_EXP, 1, true);
+    add({"Math.Factorial"}, Builtin::MATH_FACTORIAL, 1, true);
+    add({"Math.Floor"}, Builtin::MATH_FLOOR, 1, true);
+    add({"Math.Hypot"}, Builtin::MATH_HYPOT, 1, true);
+    add({"Math.IsPrime"}, Builtin::MATH_IS_PRIME, 1, true);
+    add({"Math.Lerp"}, Builtin::MATH_LERP, 1, true);
+    add({"Math.Log"}, Builtin::MATH_LOG, 1, true);
+    add({"Math.Log10"}, Builtin::MATH_LOG10, 1, true);
+    add({"Math.Max"}, Builtin::MATH_MAX, 1, true);
+    add({"Math.Min"}, Builtin::MATH_MIN, 1, true);
+    add({"Math.Pow"}, Builtin::MATH_POW, 1, true);
+    add({"Math.Random"}, Builtin::MATH_RANDOM, 0, true);
+    add({"Math.Round"}, Builtin::MATH_ROUND, 1, true);
+    add({"Math.Sign"}, Builtin::MATH_SIGN, 1, true);
+    add({"Math.Sin"}, Builtin::MATH_SIN, 1, true);
+    add({"Math.Sqrt"}, Builtin::MATH_SQRT, 1, true);
+    add({"Math.Square"}, Builtin::MATH_SQUARE, 1, true);
+    add({"Math.Tan"}, Builtin::MATH_TAN, 1, true);
+    add({"Math.ToDegrees"}, Builtin::MATH_TO_DEGREES, 1, true);
+    add({"Math.ToRadians"}, Builtin::MATH_TO_RADIANS, 1, true);
+    add({"ParseNum", "ParseInt"}, Builtin::PARSE_NUMBER, 1, true);
+
+    // strings
+    add({"String::Reverse"}, Builtin::STRING_REVERSE, 1, true);
+    add({"String::GraphemeReverse"}, Builtin::STRING_GRAPHEME_REVERSE, 1, true);
+    add({"String::CodePointReverse"}, Builtin::STRING_CODEPOINT_REVERSE, 1, true);
+    add({"String::ByteReverse"}, Builtin::STRING_BYTE_REVERSE, 1, true);
+    add({"String::Trim"}, Builtin::STRING_TRIM, 1, true);
+    add({"String::Repeat"}, Builtin::STRING_REPEAT, 1, true);
+    add({"String::Slice"}, Builtin::STRING_SLICE, 1, true);
+    add({"String::GraphemeSlice"}, Builtin::STRING_GRAPHEME_SLICE, 1, true);
+    add({"String::CodePointSlice"}, Builtin::STRING_CODEPOINT_SLICE, 1, true);
+    add({"String::ByteSlice"}, Builtin::STRING_BYTE_SLICE, 1, true);
+    add({"String::StartsWith"}, Builtin::STRING_STARTS_WITH, 1, true);
+    add({"String::EndsWith"}, Builtin::STRING_ENDS_WITH, 1, true);
+    add({"String::Split"}, Builtin::STRING_SPLIT, 1, true);
+    add({"String::Lower"}, Builtin::STRING_LOWER, 1, true);
+    add({"String::Upper"}, Builtin::STRING_UPPER, 1, true);
+    add({"String::NormalizeNFC"}, Builtin::STRING_NORMALIZE_NFC, 1, true);
+    add({"String::NormalizeNFD"}, Builtin::STRING_NORMALIZE_NFD, 1, true);
+    add({"String::NormalizeNFKC"}, Builtin::STRING_NORMALIZE_NFKC, 1, true);
+    add({"String::NormalizeNFKD"}, Builtin::STRING_NORMALIZE_NFKD, 1, true);
+    add({"String::Length"}, Builtin::STRING_LENGTH, 1, true);
+    add({"String::GraphemeLength"}, Builtin::STRING_GRAPHEME_LENGTH, 1, true);
+    add({"String::CodePointLength"}, Builtin::STRING_CODEPOINT_LENGTH, 1, true);
+    add({"String::Size", "String::ByteLength"}, Builtin::STRING_BYTE_LENGTH, 1, true);
+    add({"String::EqualsIgnoreCase"}, Builtin::STRING_EQUALS_IGNORE_CASE, 1, true);
+    add({"String::IsWhitespace"}, Builtin::STRING_IS_WHITESPACE, 1, true);
+
+    // formats and embedded languages
+    add({"JUSTC.Parse"}, Builtin::JUSTC_PARSE, 0, true);
+    add({"JUSTC.Execute"}, Builtin::JUSTC_EXECUTE, 0, true);
+    add({"JSON.Parse"}, Builtin::JSON_PARSE, 1, true);
+    add({"JavaScript", "JavaScript.Execute"}, Builtin::JAVASCRIPT, 1, true);
+    add({"Luau", "Luau.Execute"}, Builtin::LUAU, 1, true);
+    add({"JUSTO", "JUSTO.Parse"}, Builtin::JUSTO_PARSE, 1, true);
+    add({"JUSTO.Stringify"}, Builtin::JUSTO_STRINGIFY, 0, true);
+    add({"JUSTC.Stringify"}, Builtin::JUSTC_STRINGIFY, 0, true);
+    add({"Luau.Compile"}, Builtin::LUAU_COMPILE, 1, true);
+
+    // arrays
+    add({"Array::Join"}, Builtin::ARRAY_JOIN, 1, true);
+    add({"Array::Includes"}, Builtin::ARRAY_INCLUDES, 1, true);
+    add({"Array::IndexOf"}, Builtin::ARRAY_INDEX_OF, 1, true);
+    add({"Array::LastIndexOf"}, Builtin::ARRAY_LAST_INDEX_OF, 1, true);
+    add({"Array::Reverse"}, Builtin::ARRAY_REVERSE, 1, true);
+    add({"Array::ForEach"}, Builtin::ARRAY_FOR_EACH, 1, true);
+    add({"Array::Filter"}, Builtin::ARRAY_FILTER, 1, true);
+
+    add({"RenderJSX"}, Builtin::RENDER_JSX, 1, true);
+}
+Value Parser::callBuiltin(Builtin id, const std::string& funcName, const std::vector<Value>& args, size_t startPos) {
+    double inpnum = args.empty() ? 0.0 : args[0].number_value;
+
+    switch (id) {
+        case Builtin::TIME: {
+            long timestamp = getCurrentTime();
+            return numberToValue(timestamp);
+        }
+        case Builtin::MATH_PI: return numberToValue(Math::PI);
+        case Builtin::BACKSLASH: return stringToValue("\\");
+        case Builtin::VERSION: return stringToValue(JUSTC_VERSION);
+        case Builtin::MATH_E: return numberToValue(Math::E);
+        case Builtin::MATH_LN2: return numberToValue(Math::LN2);
+        case Builtin::MATH_LN10: return numberToValue(Math::LN10);
+        case Builtin::MATH_SQRT2: return numberToValue(Math::SQRT2);
+        case Builtin::MATH_SQRT1_2: return numberToValue(Math::SQRT1_2);
+        case Builtin::MATH_LOG2E: return numberToValue(Math::LOG2E);
+        case Builtin::MATH_LOG10E: return numberToValue(Math::LOG10E);
+
+        // built-in
+        case Builtin::VALUEOF: return functionVALUE(args);
+        case Builtin::STRING: return functionSTRING(args);
+        case Builtin::LINK: return functionLINK(args);
+        case Builtin::BINARY: return functionBINARY(args);
+        case Builtin::OCTAL: return functionOCTAL(args);
+        case Builtin::HEXADECIMAL: return functionHEXADECIMAL(args);
+        case Builtin::TYPEID: return functionTYPEID(args);
+        case Builtin::TYPEOF: return functionTYPEOF(args);
+        case Builtin::ECHO: return functionECHO(args);
+        case Builtin::NUMBER: {
+            if (args.empty()) return numberToValue(0.0);
+            return numberToValue(args[0].toNumber());
+        }
+        case Builtin::JSON: return functionJSON(args);
+        case Builtin::HTTP: return functionHTTP(startPos, funcName.substr(5), args);
+        case Builtin::JUSTC: return functionJUSTC(args, startPos);
+        case Builtin::FILE: return functionFILEAsync(args).get();
+        case Builtin::SIZE: return functionSTAT(args);
+        case Builtin::ENV: return functionENV(args);
+        case Builtin::CONFIG: return functionCONFIG(args);
+        case Builtin::JAVASCRIPT_IS_ALLOWED: return booleanToValue(allowJavaScript);
+        case Builtin::LUAU_IS_ALLOWED: return booleanToValue(allowLuau);
+
+        // math and binary
+        case Builtin::BINARY_TO_TEXT: return Binary::ToText(args);
+        case Builtin::BINARY_FROM_TEXT: return Binary::FromText(args);
+        case Builtin::BINARY_TO_DATA_URL: return Binary::ToDataURL(args);
+        case Builtin::BINARY_FROM_DATA_URL: return Binary::FromDataURL(args);
+        case Builtin::BINARY_DATA: return Binary::Data(args);
+        case Builtin::MATH_ABS: return Value::createNumber(Math::Abs(inpnum));
+        case Builtin::MATH_ACOS: return Value::createNumber(Math::Acos(inpnum));
+        case Builtin::MATH_ASIN: return Value::createNumber(Math::Asin(inpnum));
+        case Builtin::MATH_ATAN: return Value::createNumber(Math::Atan(inpnum));
+        case Builtin::MATH_ATAN2: return Value::createNumber(Math::Atan2(inpnum, args[1].number_value));
+        case Builtin::MATH_CEIL: return Value::createNumber(Math::Ceil(inpnum));
+        case Builtin::MATH_COS: return Value::createNumber(Math::Cos(inpnum));
+        case Builtin::MATH_CLAMP: return Value::createNumber(Math::Clamp(inpnum, args[1].number_value, args[2].number_value));
+        case Builtin::MATH_CUBE: return Value::createNumber(inpnum * inpnum * inpnum);
+        case Builtin::MATH_DOUBLE: return Value::createNumber(inpnum * 2);
+        case Builtin::MATH_EXP: return Value::createNumber(Math::Exp(inpnum));
+        case Builtin::MATH_FACTORIAL: {
             int intValue = static_cast<int>(std::round(inpnum));
             long long res = Math::Factorial(intValue);
             double outVal = static_cast<double>(res);
             return Value::createNumber(outVal);
         }
-        if (funcName == "Math.Floor") {
-            return Value::createNumber(Math::Floor(inpnum));
-        }
-        if (funcName == "Math.Hypot") {
-            return Value::createNumber(Math::Hypot(inpnum, args[1].number_value));
-        }
-        if (funcName == "Math.IsPrime") {
+        case Builtin::MATH_FLOOR: return Value::createNumber(Math::Floor(inpnum));
+        case Builtin::MATH_HYPOT: return Value::createNumber(Math::Hypot(inpnum, args[1].number_value));
+        case Builtin::MATH_IS_PRIME: {
             int intValue = static_cast<int>(std::round(inpnum));
             return Value::createBoolean(Math::IsPrime(intValue));
         }
-        if (funcName == "Math.Lerp") {
-            return Value::createNumber(Math::Lerp(inpnum, args[1].number_value, args[2].number_value));
-        }
-        if (funcName == "Math.Log") {
-            return Value::createNumber(Math::Log(inpnum));
-        }
-        if (funcName == "Math.Log10") {
-            return Value::createNumber(Math::Log10(inpnum));
-        }
-        if (funcName == "Math.Max") {
-            return Value::createNumber(Math::Max(values2numbers(args)));
-        }
-        if (funcName == "Math.Min") {
-            return Value::createNumber(Math::Min(values2numbers(args)));
-        }
-        if (funcName == "Math.Pow") {
-            return Value::createNumber(Math::Pow(inpnum, args[1].number_value));
-        }
-        if (funcName == "Math.Random") {
+        case Builtin::MATH_LERP: return Value::createNumber(Math::Lerp(inpnum, args[1].number_value, args[2].number_value));
+        case Builtin::MATH_LOG: return Value::createNumber(Math::Log(inpnum));
+        case Builtin::MATH_LOG10: return Value::createNumber(Math::Log10(inpnum));
+        case Builtin::MATH_MAX: return Value::createNumber(Math::Max(values2numbers(args)));
+        case Builtin::MATH_MIN: return Value::createNumber(Math::Min(values2numbers(args)));
+        case Builtin::MATH_POW: return Value::createNumber(Math::Pow(inpnum, args[1].number_value));
+        case Builtin::MATH_RANDOM: {
             if (args.empty()) return Value::createNumber(Math::Random());
             if (args.size() == 1) return Value::createNumber(Math::Random(0, inpnum));
             return Value::createNumber(Math::Random(inpnum, args[1].number_value));
         }
-        if (funcName == "Math.Round") {
-            return Value::createNumber(Math::Round(inpnum));
-        }
-        if (funcName == "Math.Sign") {
-            return Value::createNumber(Math::Sign(inpnum));
-        }
-        if (funcName == "Math.Sin") {
-            return Value::createNumber(Math::Sin(inpnum));
-        }
-        if (funcName == "Math.Sqrt") {
-            return Value::createNumber(Math::Sqrt(inpnum));
-        }
-        if (funcName == "Math.Square") {
-            return Value::createNumber(inpnum * inpnum);
-        }
-        if (funcName == "Math.Tan") {
-            return Value::createNumber(Math::Tan(inpnum));
-        }
-        if (funcName == "Math.ToDegrees") {
-            return Value::createNumber(Math::ToDegrees(inpnum));
-        }
-        if (funcName == "Math.ToRadians") {
-            return Value::createNumber(Math::ToRadians(inpnum));
-        }
-        if (funcName == "ParseNum" || funcName == "ParseInt") {
+        case Builtin::MATH_ROUND: return Value::createNumber(Math::Round(inpnum));
+        case Builtin::MATH_SIGN: return Value::createNumber(Math::Sign(inpnum));
+        case Builtin::MATH_SIN: return Value::createNumber(Math::Sin(inpnum));
+        case Builtin::MATH_SQRT: return Value::createNumber(Math::Sqrt(inpnum));
+        case Builtin::MATH_SQUARE: return Value::createNumber(inpnum * inpnum);
+        case Builtin::MATH_TAN: return Value::createNumber(Math::Tan(inpnum));
+        case Builtin::MATH_TO_DEGREES: return Value::createNumber(Math::ToDegrees(inpnum));
+        case Builtin::MATH_TO_RADIANS: return Value::createNumber(Math::ToRadians(inpnum));
+        case Builtin::PARSE_NUMBER: {
             std::string str = args[0].toString();
             int radix = 10;
 
@@ -3248,15 +3017,20 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
                 throw std::runtime_error(funcName + ": " + std::string(e.what()));
             }
         }
-        if (funcName == "String::GraphemeReverse" || (
-            chartype == CharType::GRAPHEME && funcName == "String::Reverse"
-        )) {
-            return stringToValue(Unicode::GraphemeReverse(args[0].toString()));
-        }
-        if (funcName == "String::Trim") {
-            return stringToValue(String::Trim(args[0].toString()));
-        }
-        if (funcName == "String::Repeat") {
+
+        // strings
+        case Builtin::STRING_REVERSE:
+            switch (chartype) {
+                case CharType::GRAPHEME:  return stringToValue(Unicode::GraphemeReverse(args[0].toString()));
+                case CharType::CODEPOINT: return stringToValue(Unicode::CodePointReverse(args[0].toString()));
+                case CharType::BYTE:      return stringToValue(Unicode::ByteReverse(args[0].toString()));
+            }
+            break;
+        case Builtin::STRING_GRAPHEME_REVERSE: return stringToValue(Unicode::GraphemeReverse(args[0].toString()));
+        case Builtin::STRING_CODEPOINT_REVERSE: return stringToValue(Unicode::CodePointReverse(args[0].toString()));
+        case Builtin::STRING_BYTE_REVERSE: return stringToValue(Unicode::ByteReverse(args[0].toString()));
+        case Builtin::STRING_TRIM: return stringToValue(String::Trim(args[0].toString()));
+        case Builtin::STRING_REPEAT: {
             size_t count = 1;
             if (args.size() > 1) {
                 count = static_cast<size_t>(args[1].toNumber());
@@ -3264,9 +3038,10 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
 
             return stringToValue(String::Repeat(args[0].toString(), count));
         }
-        if (funcName == "String::GraphemeSlice" || (
-            chartype == CharType::GRAPHEME && funcName == "String::Slice"
-        )) {
+        case Builtin::STRING_SLICE:
+        case Builtin::STRING_GRAPHEME_SLICE:
+        case Builtin::STRING_CODEPOINT_SLICE:
+        case Builtin::STRING_BYTE_SLICE: {
             std::string str = args[0].toString();
             int64_t start = 0;
             int64_t end = static_cast<int64_t>(str.length());
@@ -3278,21 +3053,27 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
                 }
             }
 
-            return stringToValue(Unicode::GraphemeSlice(str, start, end));
+            if (id == Builtin::STRING_GRAPHEME_SLICE || (id == Builtin::STRING_SLICE && chartype == CharType::GRAPHEME)) {
+                return stringToValue(Unicode::GraphemeSlice(str, start, end));
+            }
+            if (id == Builtin::STRING_CODEPOINT_SLICE || (id == Builtin::STRING_SLICE && chartype == CharType::CODEPOINT)) {
+                return stringToValue(Unicode::CodePointSlice(str, start, end));
+            }
+            return stringToValue(Unicode::ByteSlice(str, start, end));
         }
-        if (funcName == "String::StartsWith") {
+        case Builtin::STRING_STARTS_WITH: {
             if (args.size() < 2) {
                 return booleanToValue(false);
             }
             return booleanToValue(String::StartsWith(args[0].toString(), args[1].toString()));
         }
-        if (funcName == "String::EndsWith") {
+        case Builtin::STRING_ENDS_WITH: {
             if (args.size() < 2) {
                 return booleanToValue(false);
             }
             return booleanToValue(String::EndsWith(args[0].toString(), args[1].toString()));
         }
-        if (funcName == "String::Split") {
+        case Builtin::STRING_SPLIT: {
             if (args.size() < 2) {
                 std::vector<std::string> result( {args[0].toString()} );
                 return stringArray(result);
@@ -3311,82 +3092,23 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
             }
             return stringArray(String::Split(args[0].toString(), args[1].toString()));
         }
-        if (funcName == "String::CodePointReverse" || (
-            chartype == CharType::CODEPOINT && funcName == "String::Reverse"
-        )) {
-            return stringToValue(Unicode::CodePointReverse(args[0].toString()));
-        }
-        if (funcName == "String::ByteReverse" || (
-            chartype == CharType::BYTE && funcName == "String::Reverse"
-        )) {
-            return stringToValue(Unicode::ByteReverse(args[0].toString()));
-        }
-        if (funcName == "String::CodePointSlice" || (
-            chartype == CharType::CODEPOINT && funcName == "String::Slice"
-        )) {
-            std::string str = args[0].toString();
-            int64_t start = 0;
-            int64_t end = static_cast<int64_t>(str.length());
-
-            if (args.size() > 1) {
-                start = static_cast<int64_t>(args[1].toNumber());
-                if (args.size() > 2) {
-                    end = static_cast<int64_t>(args[2].toNumber());
-                }
-            }
-
-            return stringToValue(Unicode::CodePointSlice(str, start, end));
-        }
-        if (funcName == "String::ByteSlice" || (
-            chartype == CharType::BYTE && funcName == "String::Slice"
-        )) {
-            std::string str = args[0].toString();
-            int64_t start = 0;
-            int64_t end = static_cast<int64_t>(str.length());
-
-            if (args.size() > 1) {
-                start = static_cast<int64_t>(args[1].toNumber());
-                if (args.size() > 2) {
-                    end = static_cast<int64_t>(args[2].toNumber());
-                }
+        case Builtin::STRING_LOWER: return stringToValue(Unicode::Lower(args[0].toString()));
+        case Builtin::STRING_UPPER: return stringToValue(Unicode::Upper(args[0].toString()));
+        case Builtin::STRING_NORMALIZE_NFC: return stringToValue(Unicode::NormalizeNFC(args[0].toString()));
+        case Builtin::STRING_NORMALIZE_NFD: return stringToValue(Unicode::NormalizeNFD(args[0].toString()));
+        case Builtin::STRING_NORMALIZE_NFKC: return stringToValue(Unicode::NormalizeNFKC(args[0].toString()));
+        case Builtin::STRING_NORMALIZE_NFKD: return stringToValue(Unicode::NormalizeNFKD(args[0].toString()));
+        case Builtin::STRING_LENGTH:
+            switch (chartype) {
+                case CharType::GRAPHEME:  return Value::createNumber(static_cast<double>(Unicode::GraphemeLength(args[0].toString())));
+                case CharType::CODEPOINT: return Value::createNumber(static_cast<double>(Unicode::CodePointLength(args[0].toString())));
+                case CharType::BYTE:      return Value::createNumber(static_cast<double>(Unicode::ByteLength(args[0].toString())));
             }
-
-            return stringToValue(Unicode::ByteSlice(str, start, end));
-        }
-        if (funcName == "String::Lower") {
-            return stringToValue(Unicode::Lower(args[0].toString()));
-        }
-        if (funcName == "String::Upper") {
-            return stringToValue(Unicode::Upper(args[0].toString()));
-        }
-        if (funcName == "String::NormalizeNFC") {
-            return stringToValue(Unicode::NormalizeNFC(args[0].toString()));
-        }
-        if (funcName == "String::NormalizeNFD") {
-            return stringToValue(Unicode::NormalizeNFD(args[0].toString()));
-        }
-        if (funcName == "String::NormalizeNFKC") {
-            return stringToValue(Unicode::NormalizeNFKC(args[0].toString()));
-        }
-        if (funcName == "String::NormalizeNFKD") {
-            return stringToValue(Unicode::NormalizeNFKD(args[0].toString()));
-        }
-        if (funcName == "String::GraphemeLength" || (
-            chartype == CharType::GRAPHEME && funcName == "String::Length"
-        )) {
-            return Value::createNumber(static_cast<double>(Unicode::GraphemeLength(args[0].toString())));
-        }
-        if (funcName == "String::CodePointLength" || (
-            chartype == CharType::CODEPOINT && funcName == "String::Length"
-        )) {
-            return Value::createNumber(static_cast<double>(Unicode::CodePointLength(args[0].toString())));
-        }
-        if (funcName == "String::Size" || funcName == "String::ByteLength" || (
-            chartype == CharType::BYTE && funcName == "String::Length"
-        )) {
-            return Value::createNumber(static_cast<double>(Unicode::ByteLength(args[0].toString())));
-        }
-        if (funcName == "String::EqualsIgnoreCase") {
+            break;
+        case Builtin::STRING_GRAPHEME_LENGTH: return Value::createNumber(static_cast<double>(Unicode::GraphemeLength(args[0].toString())));
+        case Builtin::STRING_CODEPOINT_LENGTH: return Value::createNumber(static_cast<double>(Unicode::CodePointLength(args[0].toString())));
+        case Builtin::STRING_BYTE_LENGTH: return Value::createNumber(static_cast<double>(Unicode::ByteLength(args[0].toString())));
+        case Builtin::STRING_EQUALS_IGNORE_CASE: {
             std::string right;
             if (args.size() < 2) {
                 right = "";
@@ -3395,23 +3117,23 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
             }
             return booleanToValue(Unicode::EqualsIgnoreCase(args[0].toString(), right));
         }
-        if (funcName == "String::IsWhitespace") {
-            return booleanToValue(Unicode::IsWhitespace(args[0].toString()));
-        }
-        if (funcName == "JUSTC.Parse") {
+        case Builtin::STRING_IS_WHITESPACE: return booleanToValue(Unicode::IsWhitespace(args[0].toString()));
+
+        // formats and embedded languages
+        case Builtin::JUSTC_PARSE: {
+            if (args.empty()) return emptyJUSTC();
             return functionJUSTC2(args[0].toString(), false, startPos);
         }
-        if (funcName == "JUSTC.Execute") {
+        case Builtin::JUSTC_EXECUTE: {
+            if (args.empty()) return emptyJUSTC();
             return functionJUSTC2(args[0].toString(), true, startPos);
         }
-        if (funcName == "JSON.Parse") {
-            return functionJSON(args);
-        }
-        if (funcName == "JavaScript" || funcName == "JavaScript.Execute") {
+        case Builtin::JSON_PARSE: return functionJSON(args);
+        case Builtin::JAVASCRIPT: {
             if (allowJavaScript) {
                 #ifdef __EMSCRIPTEN__
 
-                    Value result = runJavaScript(args[0].toString(), Utility::position(startPos, input), true);
+                    Value result = runJavaScript(args[0].toString(), sourcePosition(startPos), true);
                     addLog("JAVASCRIPT", Utility::value2string(result), startPos);
                     result.name = funcName + "(...)";
                     return result;
@@ -3420,7 +3142,7 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
 
                     std::pair<std::string, bool> jsresult = JavaScript::Eval(args[0].toString());
                     if (jsresult.second) {
-                        throw std::runtime_error("JavaScript error at " + Utility::position(startPos, input) + ":\n" + jsresult.first);
+                        throw std::runtime_error("JavaScript error at " + sourcePosition(startPos) + ":\n" + jsresult.first);
                     } else {
                         addLog("JAVASCRIPT", jsresult.first, startPos);
                     }
@@ -3437,7 +3159,7 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
                 throw std::runtime_error("JavaScript disallowed - Cannot run JavaScript \"" + args[0].toString() + "\"");
             }
         }
-        if (funcName == "Luau" || funcName == "Luau.Execute") {
+        case Builtin::LUAU: {
             if (allowLuau) {
                 std::pair<std::string, int> luauresult = RunLuau::runScriptWithResult(args[0].toString());
                 Value result;
@@ -3472,18 +3194,18 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
                 throw std::runtime_error("Luau disallowed - Cannot run Luau \"" + args[0].toString() + "\"");
             }
         }
-        if (funcName == "JUSTO" || funcName == "JUSTO.Parse") {
-            return functionJUSTO(args);
-        }
-        if (funcName == "JUSTO.Stringify") {
+        case Builtin::JUSTO_PARSE: return functionJUSTO(args);
+        case Builtin::JUSTO_STRINGIFY: {
+            if (args.empty()) return stringToValue("");
             return toJUSTO(args);
         }
-        if (funcName == "JUSTC.Stringify") {
+        case Builtin::JUSTC_STRINGIFY: {
+            if (args.empty()) return stringToValue("return.");
             Value result = stringToValue(Utility::stringifyValue(args[0]));
             result.type = DataType::STRING;
             return result;
         }
-        if (funcName == "Luau.Compile") {
+        case Builtin::LUAU_COMPILE: {
             if (allowLuau) {
                 std::string error;
                 return booleanToValue(RunLuau::compileScript(args[0].toString(), error));
@@ -3491,57 +3213,59 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
                 return booleanToValue(false);
             }
         }
-        if (funcName == "Array::Join") {
+
+        // arrays
+        case Builtin::ARRAY_JOIN: {
             std::stringstream ss;
             std::string sep = ",";
             if (args.size() > 1) sep = args[1].toString();
             bool first = true;
-            for (Value val : args[0].array_elements) {
+            for (const Value& val : args[0].array_elements()) {
                 if (!first) ss << sep;
                 ss << val.toString();
                 first = false;
             }
             return stringToValue(ss.str());
         }
-        if (funcName == "Array::Includes") {
+        case Builtin::ARRAY_INCLUDES: {
             if (args.size() < 2) return booleanToValue(false);
             bool includes = false;
-            for (Value val : args[0].array_elements) {
+            for (const Value& val : args[0].array_elements()) {
                 includes = Utility::compareValues(val, args[1]);
                 if (includes) break;
             }
             return booleanToValue(includes);
         }
-        if (funcName == "Array::IndexOf") {
+        case Builtin::ARRAY_INDEX_OF: {
             if (args.size() < 2) throw std::runtime_error("Expected value");
-            for (size_t i = 0; i < args[0].array_elements.size(); i++) {
-                if (Utility::compareValues(args[0].array_elements[i], args[1])) return Value::createNumber(static_cast<double>(i));
+            for (size_t i = 0; i < args[0].array_elements().size(); i++) {
+                if (Utility::compareValues(args[0].array_elements()[i], args[1])) return Value::createNumber(static_cast<double>(i));
             }
             throw std::runtime_error("Value not found in array");
         }
-        if (funcName == "Array::LastIndexOf") {
+        case Builtin::ARRAY_LAST_INDEX_OF: {
             if (args.size() < 2) throw std::runtime_error("Expected value");
-            for (size_t i = args[0].array_elements.size() - 1; i >= 0; i--) {
-                if (Utility::compareValues(args[0].array_elements[i], args[1])) return Value::createNumber(static_cast<double>(i));
+            for (size_t i = args[0].array_elements().size() - 1; i >= 0; i--) {
+                if (Utility::compareValues(args[0].array_elements()[i], args[1])) return Value::createNumber(static_cast<double>(i));
             }
             throw std::runtime_error("Value not found in array");
         }
-        if (funcName == "Array::Reverse") {
-            std::vector<Value> arr = args[0].array_elements;
+        case Builtin::ARRAY_REVERSE: {
+            std::vector<Value> arr = args[0].array_elements();
             std::reverse(arr.begin(), arr.end());
 
             Value result = Value::createJsonArray(arr);
             result.name = "[Array]";
             return result;
         }
-        if (funcName == "Array::ForEach") {
+        case Builtin::ARRAY_FOR_EACH: {
             if (args.size() < 2 || args[1].type != DataType::FUNCTION) throw std::runtime_error("Expected function");
             Value lastResult = Value::createNull();
             lastResult.type = DataType::NULL_TYPE;
 
-            for (size_t i = 0; i < args[0].array_elements.size(); i++) {
+            for (size_t i = 0; i < args[0].array_elements().size(); i++) {
                 lastResult = callFunction(args[1], {
-                    args[0].array_elements[i], 
+                    args[0].array_elements()[i],
                     Value::createNumber(static_cast<double>(i)),
                     args[0]
                 }, startPos, doExecute);
@@ -3549,27 +3273,24 @@ Value Parser::executeFunction(const std::string& funcName, const std::vector<Val
 
             return lastResult;
         }
-        if (funcName == "Array::Filter") {
+        case Builtin::ARRAY_FILTER: {
             if (args.size() < 2 || args[1].type != DataType::FUNCTION) throw std::runtime_error("Expected function");
             std::vector<Value> arr;
-            
-            for (size_t i = 0; i < args[0].array_elements.size(); i++) {
+
+            for (size_t i = 0; i < args[0].array_elements().size(); i++) {
                 if (callFunction(args[1], {
-                    args[0].array_elements[i], 
+                    args[0].array_elements()[i],
                     Value::createNumber(static_cast<double>(i)),
                     args[0]
-                }, startPos, doExecute).toBoolean()) arr.push_back(args[0].array_elements[i]);
+                }, startPos, doExecute).toBoolean()) arr.push_back(args[0].array_elements()[i]);
             }
 
             Value result = Value::createJsonArray(arr);
             result.name = "[Array]";
             return result;
         }
-        if (funcName == "RenderJSX") {
-            return Value::createString(renderJSX(args[0]));
-        }
-    } catch (const std::exception& e) {
-        throw std::runtime_error(std::string(e.what()) + " at " + Utility::position(startPos, input) + ".");
+
+        case Builtin::RENDER_JSX: return Value::createString(renderJSX(args[0]));
     }
 
     throw std::runtime_error("\"" + funcName + "\" is not a function.");
@@ -3590,9 +3311,9 @@ Value Parser::doubleDot(const Value& left, const Value& right) {
     } else if (left.type == DataType::JSON_ARRAY && right.type == DataType::JSON_ARRAY) {
         std::vector<Value> concatenated;
 
-        const auto& leftArr = left.array_elements;
+        const auto& leftArr = left.array_elements();
         concatenated.insert(concatenated.end(), leftArr.begin(), leftArr.end());
-        const auto& rightArr = right.array_elements;
+        const auto& rightArr = right.array_elements();
         concatenated.insert(concatenated.end(), rightArr.begin(), rightArr.end());
 
         Value result = Value::createJsonArray(concatenated);
@@ -3603,10 +3324,10 @@ Value Parser::doubleDot(const Value& left, const Value& right) {
     else if (Utility::checkObjects(left, right)) {
         std::unordered_map<std::string, Value> merged;
 
-        for (const auto& [key, val] : left.properties) {
+        for (const auto& [key, val] : left.properties()) {
             merged[key] = val;
         }
-        for (const auto& [key, val] : right.properties) {
+        for (const auto& [key, val] : right.properties()) {
             merged[key] = val;
         }
 
@@ -3616,18 +3337,21 @@ Value Parser::doubleDot(const Value& left, const Value& right) {
     }
     
     else {
-        throw std::runtime_error("Cannot concatenate " + dataTypeToString(left.type) + " with " + dataTypeToString(right.type) + " at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Cannot concatenate " + dataTypeToString(left.type) + " with " + dataTypeToString(right.type) + " at " + sourcePosition(currentToken().start) + ".");
     }
 
     return result;
 }
-void Parser::assign(const Value& var, const Value& val, const std::string& pos) {
-    std::string vtype = " ";
-    if (var.varType == VariableType::GLOBAL) vtype = " global ";
-    else if (var.varType == VariableType::LOCAL) vtype = " local ";
-
-    if (var.isConst) throw std::runtime_error("Assignment to" + vtype + "constant variable \"" + var.variable + "\"" + pos);
+void Parser::assign(const Value& var, const Value& val, size_t pos) {
+    if (var.isConst) {
+        std::string vtype = " ";
+        if (var.varType == VariableType::GLOBAL) vtype = " global ";
+        else if (var.varType == VariableType::LOCAL) vtype = " local ";
+        std::string at = pos == std::string::npos ? "." : " at " + sourcePosition(pos) + ".";
+        throw std::runtime_error("Assignment to" + vtype + "constant variable \"" + var.variable + "\"" + at);
+    }
 
+    ++generation;
     variables[var.variable] = val;
     switch (var.varType) {
         case VariableType::GLOBAL:
@@ -3652,7 +3376,10 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
     bool leftBool = left.toBoolean();
     bool rightBool = right.toBoolean();
 
-    std::string errmsg = "Unexpected operator \"" + op + "\" at " + Utility::position(currentToken().start, input) + ".";
+    const size_t opPos = currentToken().start;
+    auto unexpectedOperator = [&] {
+        return std::runtime_error("Unexpected operator \"" + op + "\" at " + sourcePosition(opPos) + ".");
+    };
 
     if (op == "+") {
         if (
@@ -3671,9 +3398,9 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
                 result = stringToValue(Utility::stringAdd(left.toString(), right.toString()));
             }
         } else if (left.type == DataType::STRING) {
-            throw std::runtime_error("Cannot add string to " + Utility::value2string(right) + " at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Cannot add string to " + Utility::value2string(right) + " at " + sourcePosition(currentToken().start) + ".");
         } else if (right.type == DataType::STRING) {
-            throw std::runtime_error("Cannot add " + Utility::value2string(left) + " to string at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Cannot add " + Utility::value2string(left) + " to string at " + sourcePosition(currentToken().start) + ".");
         } else if (left.type == DataType::NUMBER && right.type == DataType::NUMBER) {
             result = numberToValue(left.toNumber() + right.toNumber());
         } else if (left.type == DataType::UNKNOWN) {
@@ -3698,7 +3425,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringSub(left.name, right.name));
         } else {
-            throw std::runtime_error("Unexpected operator \"-\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected operator \"-\" at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "*") {
@@ -3713,7 +3440,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringMul(left.name, right.name));
         } else {
-            throw std::runtime_error("Unexpected operator \"*\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected operator \"*\" at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "/" || (op == ":" && Utility::checkNumber(right))) {
@@ -3734,7 +3461,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringDiv(left.name, right.name));
         } else {
-            throw std::runtime_error("Unexpected operator \"" + op + "\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected operator \"" + op + "\" at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "**") {
@@ -3749,7 +3476,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringPow(left.name, right.name));
         } else {
-            throw std::runtime_error("Unexpected operator \"**\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected operator \"**\" at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "%") {
@@ -3764,7 +3491,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringFMod(left.name, right.name));
         } else {
-            throw std::runtime_error("Unexpected operator \"%\" at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Unexpected operator \"%\" at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "..") {
@@ -3846,7 +3573,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringXor(left.name, right.name));
         } else {
-            throw std::runtime_error("Expected numbers or strings for bitwise XOR operation at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Expected numbers or strings for bitwise XOR operation at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "~" || op == "NOT") {
@@ -3858,7 +3585,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringNot(right.name));
         } else {
-            throw std::runtime_error("Expected number or string for bitwise NOT operation at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Expected number or string for bitwise NOT operation at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == "<<") {
@@ -3875,7 +3602,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringLShift(left.name, right.name));
         } else {
-            throw std::runtime_error("Expected numbers or strings for bitwise left shift operation at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Expected numbers or strings for bitwise left shift operation at " + sourcePosition(currentToken().start) + ".");
         }
     }
     else if (op == ">>") {
@@ -3892,7 +3619,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         } else if (left.type == DataType::UNKNOWN && right.type == DataType::UNKNOWN) {
             result = stringToValue(Utility::stringRShift(left.name, right.name));
         } else {
-            throw std::runtime_error("Expected numbers or strings for bitwise right shift operation at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Expected numbers or strings for bitwise right shift operation at " + sourcePosition(currentToken().start) + ".");
         }
     }
 
@@ -3954,7 +3681,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
         std::vector<Value> args;
         args.push_back(left);
 
-        if (match("(")) {
+        if (match(TokenKind::LEFT_PAREN)) {
             std::vector<Value> additionalArgs = parseArguments(doExecute);
             args.insert(args.end(), additionalArgs.begin(), additionalArgs.end());
         }
@@ -3983,7 +3710,7 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
     }
     
     else if (op == "[" && doExecute) {
-        if (!match("]")) throw std::runtime_error("Expected \"]\" to close index access at " + Utility::position(currentToken().start, input) + ".");
+        if (!match(TokenKind::RIGHT_BRACKET)) throw std::runtime_error("Expected \"]\" to close index access at " + sourcePosition(currentToken().start) + ".");
         advance();
 
         size_t index = static_cast<size_t>(right.toNumber());
@@ -3997,44 +3724,44 @@ Value Parser::evaluateExpression(const Value& left, const std::string& op, const
                 }, currentToken().start);
                 break;
             case DataType::JSON_ARRAY: 
-                result = index < left.array_elements.size() ? left.array_elements[index] : Value::createNull();
+                result = index < left.array_elements().size() ? left.array_elements()[index] : Value::createNull();
                 break;
             default: break;
         }
     }
 
     else if ((op == ":" || op == ".") && doExecute) {
-        auto it = typeMethods.find(left.type);
+        auto it = tables.typeMethods.find(left.type);
         std::string funcName = right.toIdentifier();
-        if (it != typeMethods.end()) {
-            auto itFunc = typeMethods[left.type].find(funcName);
-            if (itFunc != typeMethods[left.type].end()) {
-                if (match("(")) {
+        if (it != tables.typeMethods.end()) {
+            auto itFunc = it->second.find(funcName);
+            if (itFunc != it->second.end()) {
+                if (match(TokenKind::LEFT_PAREN)) {
                     std::vector<Value> args = {left};
                     std::vector<Value> additionalArgs = parseArguments(doExecute);
                     args.insert(args.end(), additionalArgs.begin(), additionalArgs.end());
-                    result = executeFunction(typeMethods[left.type][funcName], args, currentToken().start);
+                    result = executeFunction(itFunc->second, args, currentToken().start);
                 }
-                else throw std::runtime_error("Expected \"(\" for function call at " + Utility::position(currentToken().start, input) + ".");
+                else throw std::runtime_error("Expected \"(\" for function call at " + sourcePosition(currentToken().start) + ".");
             } 
-            else throw std::runtime_error("<" + dataTypeToString(left.type) + ">" + op + funcName + " is not a function. Call attempt at " + Utility::position(currentToken().start, input) + ".");
+            else throw std::runtime_error("<" + dataTypeToString(left.type) + ">" + op + funcName + " is not a function. Call attempt at " + sourcePosition(currentToken().start) + ".");
         } 
-        else throw std::runtime_error(errmsg);
+        else throw unexpectedOperator();
 
         if (op == ":" && left.isVariable) {
-            assign(left, result, " at " + Utility::position(currentToken().start, input) + ".");
+            assign(left, result, currentToken().start);
         }
     }
 
     else if (op == "=") {
         result = right;
         if (left.isVariable) {
-            assign(left, right, " at " + Utility::position(currentToken().start, input) + ".");
+            assign(left, right, currentToken().start);
         }
     }
 
-    else throw std::runtime_error(errmsg);
-    if (result.type == DataType::UNKNOWN) throw std::runtime_error(errmsg);
+    else throw unexpectedOperator();
+    if (result.type == DataType::UNKNOWN) throw unexpectedOperator();
 
     return result;
 }
@@ -4063,13 +3790,7 @@ Value Parser::handleInequality(const Value& value) {
 
 Value Parser::handleConditional(const Value& condition, const Value& thenVal, const Value& elseVal,
                                const std::string& thenOp, const std::string& elseOp) {
-    bool cond = condition.toBoolean();
-
-    if (thenOp == "then't" || thenOp == "=!") {
-        cond = !cond;
-    }
-
-    if (cond) {
+    if (conditionHolds(condition, thenOp)) {
         return thenVal;
     } else {
         if (elseOp == "elsen't" || elseOp == "?!") {
@@ -4079,50 +3800,64 @@ Value Parser::handleConditional(const Value& condition, const Value& thenVal, co
     }
 }
 
+bool Parser::conditionHolds(const Value& condition, const std::string& thenOp) const {
+    bool cond = condition.toBoolean();
+
+    if (thenOp == "then't" || thenOp == "=!") {
+        cond = !cond;
+    }
+
+    return cond;
+}
+
 void Parser::buildDependencyGraph() {
     for (const auto& node : ast) {
         if (node.type == "VARIABLE_DECLARATION") {
             dependencies[node.identifier] = node.references;
         }
     }
-}
-
-bool Parser::detectCycles() {
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, bool> recStack;
-    std::vector<std::string> cyclePath;
-
-    for (const auto& pair : dependencies) {
-        if (dfsCycleDetection(pair.first, visited, recStack, cyclePath)) {
-            return true;
-        }
-    }
-
-    return false;
-}
 
-bool Parser::dfsCycleDetection(const std::string& node,
-                              std::unordered_map<std::string, bool>& visited,
-                              std::unordered_map<std::string, bool>& recStack,
-                              std::vector<std::string>& cyclePath) {
-    if (!visited[node]) {
-        visited[node] = true;
-        recStack[node] = true;
-        cyclePath.push_back(node);
+    // depth-first topological sort: every variable comes after the ones it references
+    evaluationOrder.clear();
+    // scratch for this sort only, gone when it returns
+    alignas(std::max_align_t) std::byte buffer[2048];
+    std::pmr::monotonic_buffer_resource scratch(buffer, sizeof(buffer));
+    std::pmr::unordered_map<std::string, uint8_t> marks(&scratch); // 1 - on the stack, 2 - done
+    std::pmr::vector<std::pair<const std::string*, size_t>> stack(&scratch);
 
-        for (const auto& neighbor : dependencies[node]) {
-            if (!visited[neighbor] && dfsCycleDetection(neighbor, visited, recStack, cyclePath)) {
-                return true;
-            } else if (recStack[neighbor]) {
-                cyclePath.push_back(neighbor);
-                return true;
+    for (const auto& node : ast) {
+        if (node.type != "VARIABLE_DECLARATION" || marks[node.identifier] != 0) continue;
+
+        marks[node.identifier] = 1;
+        stack.emplace_back(&node.identifier, 0);
+        while (!stack.empty()) {
+            const std::string& name = *stack.back().first;
+            auto it = dependencies.find(name);
+
+            if (it != dependencies.end() && stack.back().second < it->second.size()) {
+                const std::string& dependency = it->second[stack.back().second++];
+                uint8_t& mark = marks[dependency];
+                if (mark == 1) {
+                    std::string cycle;
+                    bool inCycle = false;
+                    for (const auto& entry : stack) {
+                        if (*entry.first == dependency) inCycle = true;
+                        if (inCycle) cycle += *entry.first + " -> ";
+                    }
+                    throw std::runtime_error("Circular dependency detected: " + cycle + dependency);
+                }
+                if (mark == 0) {
+                    mark = 1;
+                    stack.emplace_back(&dependency, 0);
+                }
+                continue;
             }
+
+            marks[name] = 2;
+            if (it != dependencies.end()) evaluationOrder.push_back(name);
+            stack.pop_back();
         }
     }
-
-    recStack[node] = false;
-    if (!cyclePath.empty()) cyclePath.pop_back();
-    return false;
 }
 
 Value Parser::resolveVariableValue(const std::string& varName, const bool unknownIsString) {
@@ -4134,6 +3869,7 @@ Value Parser::resolveVariableValue(const std::string& varName, const bool unknow
 
     auto it = variables.find(varName);
     if (it != variables.end() && it->second.type != DataType::UNKNOWN) {
+        if (it->second.response()) it->second = joined(it->second);
         Value var = it->second;
         var.isVariable = true;
         var.variable = varName;
@@ -4145,41 +3881,40 @@ Value Parser::resolveVariableValue(const std::string& varName, const bool unknow
         return var;
     }
 
-    for (const auto& node : ast) {
-        if (node.type == "VARIABLE_DECLARATION" && node.identifier == varName) {
-            auto mutatedIt = mutated.find(varName);
-            if (mutatedIt != mutated.end()) {
-                Mutated newVal = mutatedIt->second;
-                if (newVal.startPos > node.startPos) {
-                    if (newVal.value.type != DataType::UNKNOWN) {
-                        Value var = newVal.value;
-                        var.isVariable = true;
-                        var.variable = varName;
-                        var.varType = VariableType::VARIABLE;
-
-                        auto constIt = constVars.find(varName);
-                        var.isConst = (constIt != constVars.end() && constIt->second);
-
-                        return var;
-                    } else if (unknownIsString) {
-                        Value result;
-                        result.type = DataType::STRING;
-                        result.name = varName;
-                        result.string_value = newVal.value.name;
-                        return result;
-                    }
+    if (const std::pmr::vector<size_t>* declared = findDeclarations(varName)) {
+        const ASTNode& node = ast[declared->front()];
+        auto mutatedIt = mutated.find(varName);
+        if (mutatedIt != mutated.end()) {
+            Mutated newVal = mutatedIt->second;
+            if (newVal.startPos > node.startPos) {
+                if (newVal.value.type != DataType::UNKNOWN) {
+                    Value var = newVal.value;
+                    var.isVariable = true;
+                    var.variable = varName;
+                    var.varType = VariableType::VARIABLE;
+
+                    auto constIt = constVars.find(varName);
+                    var.isConst = (constIt != constVars.end() && constIt->second);
+
+                    return var;
+                } else if (unknownIsString) {
+                    Value result;
+                    result.type = DataType::STRING;
+                    result.name = varName;
+                    result.string_value = newVal.value.name;
+                    return result;
                 }
             }
-            Value var = evaluateASTNode(node);
-            var.isVariable = true;
-            var.variable = varName;
-            var.varType = VariableType::VARIABLE;
+        }
+        Value var = evaluateDeclaration(declared->front());
+        var.isVariable = true;
+        var.variable = varName;
+        var.varType = VariableType::VARIABLE;
 
-            auto constIt = constVars.find(varName);
-            var.isConst = (constIt != constVars.end() && constIt->second);
+        auto constIt = constVars.find(varName);
+        var.isConst = (constIt != constVars.end() && constIt->second);
 
-            return var;
-        }
+        return var;
     }
 
     if (unknownIsString) {
@@ -4196,21 +3931,26 @@ Value Parser::resolveVariableValue(const std::string& varName, const bool unknow
     return result;
 }
 
-void Parser::evaluateAllVariables() {
-    if (runAsync && !dependencies.empty()) {
-        evaluateAllVariablesAsync();
-    } else {
-        evaluateAllVariablesSync();
+void Parser::indexDeclarations() {
+    for (; indexedNodes < ast.size(); ++indexedNodes) {
+        if (ast[indexedNodes].type == "VARIABLE_DECLARATION") {
+            declarations[ast[indexedNodes].identifier].push_back(indexedNodes);
+        }
     }
 }
+const std::pmr::vector<size_t>* Parser::findDeclarations(const std::string& name) {
+    indexDeclarations();
+
+    auto it = declarations.find(name);
+    return it != declarations.end() ? &it->second : nullptr;
+}
 
-std::runtime_error Parser::typeDeclarationError(const DataType left, const DataType right, const ASTNode node) {
-    return std::runtime_error("Type declaration error: Cannot convert " + dataTypeToString(left) + " to " + dataTypeToString(right) + " at " + Utility::position(node.startPos, input) + ".");
+std::runtime_error Parser::typeDeclarationError(const DataType left, const DataType right, const ASTNode& node) {
+    return std::runtime_error("Type declaration error: Cannot convert " + dataTypeToString(left) + " to " + dataTypeToString(right) + " at " + sourcePosition(node.startPos) + ".");
 }
 
-Value Parser::applyTypeDeclaration(const Value value, const ASTNode node) {
+Value Parser::applyTypeDeclaration(Value result, const ASTNode& node) {
     DataType typeDeclaration = node.typeDeclaration;
-    Value result = value;
     if (typeDeclaration == result.type) return result;
     switch (typeDeclaration) {
         case DataType::UNKNOWN:
@@ -4223,7 +3963,7 @@ Value Parser::applyTypeDeclaration(const Value value, const ASTNode node) {
                 try {
                     result = Binary::Data({result});
                 } catch (const std::exception& e) {
-                    throw std::runtime_error("Type declaration error: " + std::string(e.what()) + " at " + Utility::position(node.startPos, input) + ".");
+                    throw std::runtime_error("Type declaration error: " + std::string(e.what()) + " at " + sourcePosition(node.startPos) + ".");
                 }
             }
             switch (result.type) {
@@ -4231,7 +3971,7 @@ Value Parser::applyTypeDeclaration(const Value value, const ASTNode node) {
                 case DataType::HEXADECIMAL:
                 case DataType::OCTAL:
                 case DataType::BINARY:
-                    result = Utility::convert(result, typeDeclaration);
+                    result = Utility::convert(std::move(result), typeDeclaration);
                     break;
                 default:
                     throw typeDeclarationError(result.type, typeDeclaration, node);
@@ -4239,15 +3979,15 @@ Value Parser::applyTypeDeclaration(const Value value, const ASTNode node) {
             }
             break;
         case DataType::STRING:
+            result.string_value = Utility::value2string(result);
             result.type = DataType::STRING;
-            result.string_value = Utility::value2string(value);
             break;
         case DataType::LINK:
             if (result.type == DataType::STRING) {
                 if (isValidLink(result.string_value)) {
                     result.type = DataType::LINK;
                 } else {
-                    throw std::runtime_error("Type declaration error: Invalid link: " + result.string_value + " at " + Utility::position(node.startPos, input) + ".");
+                    throw std::runtime_error("Type declaration error: Invalid link: " + result.string_value + " at " + sourcePosition(node.startPos) + ".");
                 }
             }
             break;
@@ -4257,10 +3997,10 @@ Value Parser::applyTypeDeclaration(const Value value, const ASTNode node) {
                 case DataType::HEXADECIMAL:
                 case DataType::OCTAL:
                 case DataType::BINARY:
-                    result.boolean_value = (value.number_value > 0);
+                    result.boolean_value = (result.number_value > 0);
                     break;
                 case DataType::STRING:
-                    result.boolean_value = value.toBoolean();
+                    result.boolean_value = result.toBoolean();
                     break;
                 case DataType::NULL_TYPE:
                     result.boolean_value = false;
@@ -4342,9 +4082,9 @@ __int128 Parser::parseToInt128(const std::string& str) {
         
         if (result > (__int128)std::numeric_limits<unsigned long long>::max() / base) {
             #ifdef __EMSCRIPTEN__
-                warn_int128(Utility::position(currentToken().start, input).c_str(), getCurrentTimestamp().c_str());
+                warn_int128(sourcePosition(currentToken().start).c_str(), getCurrentTimestamp().c_str());
             #else
-                std::cout << "C++ int128 overflow at " + Utility::position(currentToken().start, input) + "." << std::endl;
+                std::cout << "C++ int128 overflow at " + sourcePosition(currentToken().start) + "." << std::endl;
             #endif
         }
         result = result * base + digit;
@@ -4427,10 +4167,9 @@ __float128 Parser::parseToFloat128(const std::string& str) {
     return strtoflt128(cleaned.c_str(), nullptr);
 }
 #endif
-Value Parser::applyCPPTypeDeclaration(const Value value, const std::string& cpptype, const DataType typeDecl) {
+Value Parser::applyCPPTypeDeclaration(Value value, const std::string& cpptype, const DataType typeDecl) {
     if (cpptype == "default") return value;
 
-    Value result = value;
 
     if (isCPPNumber(cpptype)) {
         switch (typeDecl) {
@@ -4441,54 +4180,54 @@ Value Parser::applyCPPTypeDeclaration(const Value value, const std::string& cppt
             case DataType::OCTAL: {
                 std::string cleaned = stripUnderscores(value.name);
                 if (cpptype == "int8") {
-                    result = Value::createNumberWithType(static_cast<int8_t>(std::stoi(cleaned)), NumericType::INT8);
+                    value = Value::createNumberWithType(static_cast<int8_t>(std::stoi(cleaned)), NumericType::INT8);
                 } else if (cpptype == "int16") {
-                    result = Value::createNumberWithType(static_cast<int16_t>(std::stoi(cleaned)), NumericType::INT16);
+                    value = Value::createNumberWithType(static_cast<int16_t>(std::stoi(cleaned)), NumericType::INT16);
                 } else if (cpptype == "int32") {
                     int32_t num = std::stoi(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::INT32);
+                    value = Value::createNumberWithType(num, NumericType::INT32);
                 } else if (cpptype == "int64") {
                     int64_t num = std::stoll(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::INT64);
+                    value = Value::createNumberWithType(num, NumericType::INT64);
                 } else if (cpptype == "int128") {
-                    result = Value::createNumberWithType(parseToInt128(value.name), NumericType::INT128);
+                    value = Value::createNumberWithType(parseToInt128(value.name), NumericType::INT128);
                 } else if (cpptype == "uint8") {
-                    result = Value::createNumberWithType(static_cast<uint8_t>(std::stoul(cleaned)), NumericType::UINT8);
+                    value = Value::createNumberWithType(static_cast<uint8_t>(std::stoul(cleaned)), NumericType::UINT8);
                 } else if (cpptype == "uint16") {
-                    result = Value::createNumberWithType(static_cast<uint16_t>(std::stoul(cleaned)), NumericType::UINT16);
+                    value = Value::createNumberWithType(static_cast<uint16_t>(std::stoul(cleaned)), NumericType::UINT16);
                 } else if (cpptype == "uint32") {
                     uint32_t num = std::stoul(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::UINT32);
+                    value = Value::createNumberWithType(num, NumericType::UINT32);
                 } else if (cpptype == "uint64") {
                     uint64_t num = std::stoull(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::UINT64);
+                    value = Value::createNumberWithType(num, NumericType::UINT64);
                 } else if (cpptype == "uint128") {
-                    result = Value::createNumberWithType(parseToUInt128(value.name), NumericType::UINT128);
+                    value = Value::createNumberWithType(parseToUInt128(value.name), NumericType::UINT128);
                 } else if (cpptype == "cuint8") {
                     long long raw = std::stoll(cleaned);
                     uint8_t num;
                     if (raw < 0) num = 0;
                     else if (raw > 255) num = 255;
                     else num = static_cast<uint8_t>(raw);
-                    result = Value::createNumberWithType(num, NumericType::CUINT8);
+                    value = Value::createNumberWithType(num, NumericType::CUINT8);
                 } else if (cpptype == "cuint16") {
                     long long raw = std::stoll(cleaned);
                     uint16_t num;
                     if (raw < 0) num = 0;
                     else if (raw > 65535) num = 65535;
                     else num = static_cast<uint16_t>(raw);
-                    result = Value::createNumberWithType(num, NumericType::CUINT16);
+                    value = Value::createNumberWithType(num, NumericType::CUINT16);
                 } else if (cpptype == "cuint32") {
                     long long raw = std::stoll(cleaned);
                     uint32_t num;
                     if (raw < 0) num = 0;
                     else if (raw > 4294967295LL) num = 4294967295U;
                     else num = static_cast<uint32_t>(raw);
-                    result = Value::createNumberWithType(num, NumericType::CUINT32);
+                    value = Value::createNumberWithType(num, NumericType::CUINT32);
                 } else if (cpptype == "cuint64") {
                     if (!cleaned.empty() && cleaned[0] == '-') {
                         uint64_t num = 0;
-                        result = Value::createNumberWithType(num, NumericType::CUINT64);
+                        value = Value::createNumberWithType(num, NumericType::CUINT64);
                     } else {
                         if (cleaned.length() > 19 || (cleaned.length() == 19 && cleaned > "9223372036854775807")) {
                             try {
@@ -4497,56 +4236,66 @@ Value Parser::applyCPPTypeDeclaration(const Value value, const std::string& cppt
                                 if (raw_ull > 18446744073709551615ULL) {
                                     num = 18446744073709551615ULL;
                                 }
-                                result = Value::createNumberWithType(num, NumericType::CUINT64);
+                                value = Value::createNumberWithType(num, NumericType::CUINT64);
                             } catch (const std::out_of_range& e) {
                                 uint64_t num = 18446744073709551615ULL;
-                                result = Value::createNumberWithType(num, NumericType::CUINT64);
+                                value = Value::createNumberWithType(num, NumericType::CUINT64);
                             }
                         } else {
                             try {
                                 long long raw_ll = std::stoll(cleaned);
                                 if (raw_ll < 0) {
                                     uint64_t num = 0;
-                                    result = Value::createNumberWithType(num, NumericType::CUINT64);
+                                    value = Value::createNumberWithType(num, NumericType::CUINT64);
                                 } else {
                                     uint64_t num = static_cast<uint64_t>(raw_ll);
-                                    result = Value::createNumberWithType(num, NumericType::CUINT64);
+                                    value = Value::createNumberWithType(num, NumericType::CUINT64);
                                 }
                             } catch (const std::out_of_range& e) {
                                 uint64_t num = 18446744073709551615ULL;
-                                result = Value::createNumberWithType(num, NumericType::CUINT64);
+                                value = Value::createNumberWithType(num, NumericType::CUINT64);
                             }
                         }
                     }
                 } else if (cpptype == "float32") {
                     float num = std::stof(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::FLOAT32);
+                    value = Value::createNumberWithType(num, NumericType::FLOAT32);
                 } else if (cpptype == "float128") {
                     #if JUSTC_FLOAT128_SUPPORT
                         __float128 num = parseToFloat128(cleaned);
-                        result = Value::createNumberWithType(num, NumericType::FLOAT128);
+                        value = Value::createNumberWithType(num, NumericType::FLOAT128);
                     #else
                         long double num = std::stold(cleaned);
-                        result = Value::createNumberWithType(num, NumericType::BIGNUM);
+                        value = Value::createNumberWithType(num, NumericType::BIGNUM);
                     #endif
                 } else { // float64
                     double num = std::stod(cleaned);
-                    result = Value::createNumberWithType(num, NumericType::FLOAT64);
+                    value = Value::createNumberWithType(num, NumericType::FLOAT64);
                 }
                 break;
             }
             default:
-                throw std::runtime_error("C++ type declaration error: Cannot convert " + dataTypeToString(typeDecl) + " to " + cpptype + " at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("C++ type declaration error: Cannot convert " + dataTypeToString(typeDecl) + " to " + cpptype + " at " + sourcePosition(currentToken().start) + ".");
                 break;
         }
     }
 
-    return result;
+    return value;
 }
 
+Value Parser::evaluateDeclaration(size_t index) {
+    auto it = declarationMemo.find(index);
+    if (it != declarationMemo.end() && it->second.generation == generation && it->second.nodes == ast.size()) {
+        return it->second.value;
+    }
+
+    Value value = evaluateASTNode(ast[index]);
+    declarationMemo[index] = DeclarationMemo{generation, ast.size(), value};
+    return value;
+}
 Value Parser::evaluateASTNode(const ASTNode& node) {
     if (node.type == "VARIABLE_DECLARATION") {
-        Value result = node.value;
+        Value result = joined(node.value);
 
         if (result.type == DataType::VARIABLE) {
             std::string refVar = result.string_value;
@@ -4554,10 +4303,10 @@ Value Parser::evaluateASTNode(const ASTNode& node) {
                 throw std::runtime_error("Variable cannot reference itself: " + node.identifier);
             }
             Value varval = resolveVariableValue(refVar, true);
-            return applyTypeDeclaration(varval, node);
+            return applyTypeDeclaration(std::move(varval), node);
         }
 
-        return applyTypeDeclaration(result, node);
+        return applyTypeDeclaration(std::move(result), node);
     }
 
     return node.value;
@@ -4569,13 +4318,42 @@ void Parser::extractReferences(const Value& value, std::vector<std::string>& ref
     }
 }
 
-std::future<Value> Parser::functionHTTPAsync(size_t startPos, const std::string& method, const std::vector<Value>& args) {
-    return executeAsyncIfEnabled([this, startPos, method, args]() {
-        return functionHTTP(startPos, method, args);
+Deferred<Value> Parser::functionHTTPAsync(size_t startPos, const std::string& method, const std::vector<Value>& args) {
+    if (args.empty()) {
+        throw std::runtime_error("Expected one argument at function HTTPTEXT at " + sourcePosition(startPos) + ".");
+    } else if (args[0].type != DataType::LINK) {
+        throw std::runtime_error("Expected TYPEOF( argument 0 )=\"Link\" at function HTTPTEXT at " + sourcePosition(startPos) + ", got \"" + dataTypeToString(args[0].type) + "\".");
+    }
+
+    std::string url = args[0].toString();
+    std::string headersStr = args.size() > 1 ? args[1].toString() : "";
+    std::string body = args.size() > 2 ? args[2].toString() : "";
+
+    std::unordered_map<std::string, std::string> headers = Utility::ParseHeaders(headersStr);
+    if (headers.find("Accept") == headers.end()) {
+        headers["Accept"] = Utility::defaultHTTPAccept;
+    }
+
+    // only the request itself leaves this thread, the parser state is not touched by it
+    return executeAsyncIfEnabled([method, url = std::move(url), headers = std::move(headers), body = std::move(body)]() {
+        if (method == "POST") {
+            return HTTP::POST(url, headers, body);
+        } else if (method == "PUT") {
+            return HTTP::PUT(url, headers, body);
+        } else if (method == "PATCH") {
+            return HTTP::PATCH(url, headers, body);
+        } else if (method == "DELETE") {
+            return HTTP::DELETE(url, headers);
+        } else if (method == "HEAD") {
+            return HTTP::HEAD(url, headers);
+        } else if (method == "OPTIONS") {
+            return HTTP::OPTIONS(url, headers);
+        }
+        return HTTP::GET(url, headers);
     });
 }
 
-std::future<Value> Parser::functionFILEAsync(const std::vector<Value>& args) {
+Deferred<Value> Parser::functionFILEAsync(const std::vector<Value>& args) {
     return executeAsyncIfEnabled([this, args]() {
         return functionFILE(args);
     });
@@ -4681,52 +4459,64 @@ Value Parser::functionECHO(const std::vector<Value>& args) {
 Value Parser::functionJSON(const std::vector<Value>& args) { return Value(); }
 
 Value Parser::functionHTTP(size_t startPos, const std::string& method, const std::vector<Value>& args) {
-    if (args.empty()) {
-        throw std::runtime_error("Expected one argument at function HTTPTEXT at " + Utility::position(startPos, input) + ".");
-    } else if (args[0].type != DataType::LINK) {
-        throw std::runtime_error("Expected TYPEOF( argument 0 )=\"Link\" at function HTTPTEXT at " + Utility::position(startPos, input) + ", got \"" + dataTypeToString(args[0].type) + "\".");
+    Deferred<Value> response = functionHTTPAsync(startPos, method, args);
+
+    std::string funcName;
+    size_t funcPos = 0;
+    if ((match(TokenKind::DOT) || match(TokenKind::COLON)) && peekToken().kind == TokenKind::IDENTIFIER) {
+        advance();
+        funcName = currentToken().value.str();
+        advance();
+        if (currentToken().kind != TokenKind::LEFT_PAREN || peekToken().kind != TokenKind::RIGHT_PAREN) {
+            throw std::runtime_error("Expected function call at " + sourcePosition(currentToken().start) + ".");
+        }
+        position += 2;
+        funcPos = currentToken().start;
     }
 
-    std::string url = args[0].toString();
-    std::string headersStr = args[1].toString();
-    std::string body = args[2].toString();
-    std::unordered_map<std::string, std::string> headers = Utility::ParseHeaders(headersStr);
-    if (headers.find("Accept") == headers.end()) {
-        headers["Accept"] = Utility::defaultHTTPAccept;
+    if (args.size() > 2 && !args[2].toString().empty() && method != "POST" && method != "PUT" && method != "PATCH") {
+        Utility::Warn("HTTP: Cannot send body with method \"" + method + "\" at " + sourcePosition(startPos) + ".");
     }
 
-    Value result;
-    if (method == "POST") {
-        result = HTTP::POST(url, headers, body);
-    } else if (method == "PUT") {
-        result = HTTP::PUT(url, headers, body);
-    } else if (method == "PATCH") {
-        result = HTTP::PATCH(url, headers, body);
-    } else if (method == "DELETE") {
-        result = HTTP::DELETE(url, headers);
-    } else if (method == "HEAD") {
-        result = HTTP::HEAD(url, headers);
-    } else if (method == "OPTIONS") {
-        result = HTTP::OPTIONS(url, headers);
-    } else {
-        result = HTTP::GET(url, headers);
+    // `name is HTTP.GET(...)` keeps the request running while the rest of the script is parsed;
+    // the response is joined where the variable is first read, or before the output is built
+    if (funcName.empty() && position == deferredResponseAt && !response.isReady()) {
+        Value pending(DataType::JUSTC_OBJECT);
+        pending.name = "HTTP.Response";
+        pending.mutableData().response = std::make_shared<Deferred<Value>>(std::move(response));
+        return pending;
     }
-    if (!body.empty() && method != "POST" && method != "PUT" && method != "PATCH") {
-        Utility::Warn("HTTP: Cannot send body with method \"" + method + "\" at " + Utility::position(startPos, input) + ".");
+
+    Value result = response.get();
+    if (funcName.empty()) return result;
+
+    const auto& functions = std::as_const(result).object_value();
+    auto it = functions.find(funcName);
+    if (it == functions.end()) {
+        throw std::runtime_error("HTTP.Response: Unknown function \"" + funcName + "\" at " + sourcePosition(funcPos) + ".");
     }
-    if ((match(".") || match(":")) && peekToken().type == "identifier") {
-        advance();
-        std::string funcName = currentToken().value;
-        advance();
-        if (currentToken().type == "(" && peekToken().type == ")") {
-            position += 2;
-            if (result.object_value.find(funcName) != result.object_value.end()) {
-                return result.object_value[funcName];
-            } else {
-                throw std::runtime_error("HTTP.Response: Unknown function \"" + funcName + "\" at " + Utility::position(currentToken().start, input) + ".");
+    return it->second;
+}
+
+size_t Parser::wholeResponseCall() const {
+    if (position + 3 >= tokens.size() || tokens[position].kind != TokenKind::IDENTIFIER || tokens[position].value != "HTTP" ||
+        tokens[position + 1].kind != TokenKind::DOT || tokens[position + 3].kind != TokenKind::LEFT_PAREN) {
+        return std::string::npos;
+    }
+
+    size_t depth = 0;
+    for (size_t i = position + 3; i < tokens.size(); i++) {
+        if (tokens[i].kind == TokenKind::LEFT_PAREN) {
+            depth++;
+        } else if (tokens[i].kind == TokenKind::RIGHT_PAREN && --depth == 0) {
+            TokenKind next = i + 1 < tokens.size() ? tokens[i + 1].kind : TokenKind::END_OF_FILE;
+            if (next == TokenKind::COMMA || next == TokenKind::DOT || next == endOfScript || next == TokenKind::END_OF_FILE) {
+                return i + 1;
             }
-        } else throw std::runtime_error("Expected function call at " + Utility::position(currentToken().start, input) + ".");
-    } else return result;
+            break;
+        }
+    }
+    return std::string::npos;
 }
 
 Value Parser::merger(const std::vector<Value>& args) {
@@ -4735,173 +4525,255 @@ Value Parser::merger(const std::vector<Value>& args) {
     variables[key] = value;
     return Value::createNull();
 }
-Value Parser::isolated(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string name, bool merge, bool silent) {
+Value Parser::isolated(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge, bool silent) {
+    std::pair<SourceBuffer, std::vector<ParserToken>> lexerResult;
     try {
-        auto lexerResult = Lexer::parse(code);
-
-        std::string currName = "function";
-        bool isFunction = true;
-        if (context == nullptr) {
-            currName = "JUSTC";
-            isFunction = false;
-        }
-        if (name != "auto") {
-            currName = name;
-        }
-
-        Parser isolatedParser(
-            lexerResult.second,
-            doExecute && this->doExecute,
-            this->runAsync,
-            code,
-            this->allowJavaScript,
-            this->canAllowJS,
-            this->scriptName + "::" + currName,
-            currName,
-            this->allowLuau,
-            this->canAllowLuau,
-            isFunction,
-            context,
-            chartype
-        );
-
-        ParseResult result;
-
-        isolatedParser.userFunctions = this->userFunctions;
-        isolatedParser.userFunctionsConst = this->userFunctionsConst;
-
-        if (merge) {
-            isolatedParser.variableUpdateListener([this](const std::vector<Value>& args) {
-                return this->merger(args);
+        lexerResult = Lexer::parse(code);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
+    }
+    return isolated(std::move(lexerResult.second), lexerResult.first, doExecute, startPos, context, name, merge, silent);
+}
+std::unique_ptr<Parser> Parser::createIsolatedParser(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge) {
+    std::string currName = "function";
+    bool isFunction = true;
+    if (context == nullptr) {
+        currName = "JUSTC";
+        isFunction = false;
+    }
+    if (name != "auto") {
+        currName = name;
+    }
+
+    auto isolatedParser = std::make_unique<Parser>(
+        std::move(code),
+        doExecute && this->doExecute,
+        this->runAsync,
+        std::move(source),
+        this->allowJavaScript,
+        this->canAllowJS,
+        this->scriptName + "::" + currName,
+        currName,
+        this->allowLuau,
+        this->canAllowLuau,
+        isFunction,
+        context,
+        chartype
+    );
+
+    isolatedParser->userFunctions = this->userFunctions;
+    if (isolatedParser->source == this->source) {
+        isolatedParser->constantFolds = this->constantFolds;
+    }
+
+    if (merge) {
+        isolatedParser->variableUpdateListener([this](const std::vector<Value>& args) {
+            return this->merger(args);
+        });
+        if (context) {
+            isolatedParser->variableUpdateListener([this, context](const std::vector<Value>& args) {
+                if (args.size() < 2) return Value::createNull();
+                std::string key = args[0].toString();
+                Value value = args[1];
+                const_cast<std::unordered_map<std::string, Value>*>(context)->operator[](key) = value;
+                return Value::createNull();
             });
+        }
+    }
+
+    return isolatedParser;
+}
+void Parser::releaseArena() {
+    // the tables have to give their arena memory back before it is released
+    spareScopes.clear();
+    spareConstVars.clear();
+    declarations = decltype(declarations)(arena.get());
+    declarationMemo = decltype(declarationMemo)(arena.get());
+    localScopes = decltype(localScopes)(arena.get());
+    localConstVars = decltype(localConstVars)(arena.get());
+    arena.release();
+}
+void Parser::rewind(const std::vector<ParserToken>& code, const std::unordered_map<std::string, Value>* context) {
+    tokens = code;
+    position = 0;
+    ast.clear();
+    mutated.clear();
+    dependencies.clear();
+    evaluationOrder.clear();
+    indexedNodes = 0;
+    outputVariables.clear();
+    outputNames.clear();
+    returnValue = Value(DataType::UNKNOWN);
+    outputMode = "everything";
+    logs.clear();
+    importLogs.clear();
+    asJSON = false;
+    isJSONArray = false;
+    endOfScript = TokenKind::DOT;
+    arrayItems.clear();
+
+    releaseArena();
+    scopeStack.clear();
+    currentScope = rootIndex;
+    localScopes.try_emplace(rootIndex);
+    localConstVars.try_emplace(rootIndex);
+
+    variables.clear();
+    constVars.clear();
+    while (!builtinValues.empty()) {
+        variables.insert(builtinValues.extract(builtinValues.begin()));
+    }
+    while (!builtinConstVars.empty()) {
+        constVars.insert(builtinConstVars.extract(builtinConstVars.begin()));
+    }
+
+    if (context) {
+        for (const auto& [key, value] : *context) {
+            variables[key] = value;
+            constVars[key] = false;
+            setLocal(rootIndex, key, value, false);
+        }
+    }
+}
+void Parser::mergeIsolated(const ParseResult& result, size_t startPos, bool merge, const std::unordered_map<std::string, Value>* context, bool silent) {
+    if (!silent) {
+        for (const auto& log : result.logs) {
+            addLog(log.type, log.message, log.position);
+        }
+    }
+    for (const auto& importLog : result.importLogs) {
+        addImportLog(importLog[0], importLog[1], importLog[2]);
+    }
+    if (!merge) return;
+
+    ++generation;
+    if (result.variables) {
+        for (const auto& [key, value] : *result.variables) {
+            auto parentConstIt = constVars.find(key);
+            if ((parentConstIt != constVars.end() && parentConstIt->second) || isBuiltinVariable(key)) {
+                continue;
+            }
+
+            variables[key] = value;
             if (context) {
-                isolatedParser.variableUpdateListener([this, context](const std::vector<Value>& args) {
-                    if (args.size() < 2) return Value::createNull();
-                    std::string key = args[0].toString();
-                    Value value = args[1];
-                    const_cast<std::unordered_map<std::string, Value>*>(context)->operator[](key) = value;
-                    return Value::createNull();
-                });
+                const_cast<std::unordered_map<std::string, Value>*>(context)->operator[](key) = value;
+            }
+            try {
+                mutated.erase(key);
+            } catch (...) {}
+            mutated.try_emplace(key, Mutated(value, startPos));
+            if (result.constants) {
+                auto childConstIt = result.constants->find(key);
+                if (childConstIt != result.constants->end()) {
+                    constVars[key] = childConstIt->second;
+                }
+            }
+        }
+    }
+    if (result.constants) {
+        for (const auto& [key, isConst] : *result.constants) {
+            if (isBuiltinVariable(key)) {
+                continue;
             }
+            auto parentVarIt = variables.find(key);
+            if (parentVarIt != variables.end()) {
+                auto parentConstIt = constVars.find(key);
+                if (parentConstIt != constVars.end() && parentConstIt->second) {
+                    continue;
+                }
+            }
+            constVars[key] = isConst;
+        }
+    }
+}
+void Parser::mergeShared(const std::unordered_map<std::string, Value>& context) {
+    ++generation;
+    for (const auto& [key, value] : context) {
+        auto constIt = constVars.find(key);
+        if (constIt != constVars.end() && constIt->second) {
+            continue;
         }
+        if (isBuiltinVariable(key)) {
+            continue;
+        }
+
+        variables[key] = value;
 
-        result = isolatedParser.parse(doExecute);
+        if (constVars.find(key) == constVars.end()) {
+            constVars[key] = false;
+        }
+    }
+}
+Value Parser::isolated(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge, bool silent) {
+    try {
+        std::unique_ptr<Parser> isolatedParser = createIsolatedParser(std::move(code), std::move(source), doExecute, context, name, merge);
+        ParseResult result = isolatedParser->parse(doExecute);
 
         Value isolatedObject;
         isolatedObject.type = DataType::JUSTC_OBJECT;
         isolatedObject.object_type = DataType::JUSTC_OBJECT;
         isolatedObject.name = "[Object]";
 
-        if (isolatedParser.outputMode == "everything") {
-            isolatedObject.properties = result.returnValues;
-        } else if (isolatedParser.outputMode == "specified") {
-            for (size_t i = 0; i < isolatedParser.outputVariables.size(); i++) {
-                const auto& varName = isolatedParser.outputVariables[i];
-                std::string outputName = (i < isolatedParser.outputNames.size()) ? isolatedParser.outputNames[i] : varName;
+        if (isolatedParser->outputMode == "everything") {
+            isolatedObject.mutableData().properties = result.returnValues;
+        } else if (isolatedParser->outputMode == "specified") {
+            for (size_t i = 0; i < isolatedParser->outputVariables.size(); i++) {
+                const auto& varName = isolatedParser->outputVariables[i];
+                std::string outputName = (i < isolatedParser->outputNames.size()) ? isolatedParser->outputNames[i] : varName;
                 if (result.returnValues.find(varName) != result.returnValues.end()) {
                     if (outputName != "_") {
-                        isolatedObject.properties[outputName] = result.returnValues.at(varName);
+                        isolatedObject.mutableData().properties[outputName] = result.returnValues.at(varName);
                     } else {
-                        isolatedObject.properties[varName] = result.returnValues.at(varName);
+                        isolatedObject.mutableData().properties[varName] = result.returnValues.at(varName);
                     }
                 }
             }
-        } else if (isolatedParser.outputMode == "disabled" && isFunction && result.returnValues.empty()) {
-            isolatedObject.properties["return"] = Value::createNull();
+        } else if (isolatedParser->outputMode == "disabled" && isolatedParser->isFunction && result.returnValues.empty()) {
+            isolatedObject.mutableData().properties["return"] = Value::createNull();
         }
 
-        if (isolatedObject.properties.empty() && !result.returnValues.empty()) {
-            isolatedObject.properties = result.returnValues;
+        if (std::as_const(isolatedObject).properties().empty() && !result.returnValues.empty()) {
+            isolatedObject.mutableData().properties = result.returnValues;
         }
 
         auto objectContext = std::make_shared<ObjectContext>();
-        objectContext->parser = std::make_shared<Parser>(isolatedParser);
-        objectContext->variables = result.returnValues;
-        objectContext->outputMode = isolatedParser.outputMode;
-        objectContext->outputVariables = isolatedParser.outputVariables;
-        objectContext->allowJavaScript = isolatedParser.allowJavaScript;
-        objectContext->allowLuau = isolatedParser.allowLuau;
-        isolatedObject.object_context = objectContext;
-
-        if (!silent) {
-            for (const auto& log : result.logs) {
-                addLog(log.type, log.message, log.position);
-            }
-        }
-        for (const auto& importLog : result.importLogs) {
-            addImportLog(importLog[0], importLog[1], importLog[2]);
-        }
+        objectContext->variables = std::move(result.returnValues);
+        objectContext->outputMode = isolatedParser->outputMode;
+        objectContext->outputVariables = isolatedParser->outputVariables;
+        objectContext->allowJavaScript = isolatedParser->allowJavaScript;
+        objectContext->allowLuau = isolatedParser->allowLuau;
+        objectContext->parser = std::move(isolatedParser);
+        isolatedObject.mutableData().object_context = objectContext;
 
-        if (merge) {
-            if (result.variables) {
-                for (const auto& [key, value] : *result.variables) {
-                    auto parentConstIt = constVars.find(key);
-                    if ((parentConstIt != constVars.end() && parentConstIt->second) || isBuiltinVariable(key)) {
-                        continue;
-                    }
-
-                    variables[key] = value;
-                    try {
-                        mutated.erase(key);
-                    } catch (...) {}
-                    mutated.try_emplace(key, Mutated(value, startPos));
-                    if (result.constants) {
-                        auto childConstIt = result.constants->find(key);
-                        if (childConstIt != result.constants->end()) {
-                            constVars[key] = childConstIt->second;
-                        }
-                    }
-                }
-            }
-            if (result.constants) {
-                for (const auto& [key, isConst] : *result.constants) {
-                    if (isBuiltinVariable(key)) {
-                        continue;
-                    }
-                    auto parentVarIt = variables.find(key);
-                    if (parentVarIt != variables.end()) {
-                        auto parentConstIt = constVars.find(key);
-                        if (parentConstIt != constVars.end() && parentConstIt->second) {
-                            continue;
-                        }
-                    }
-                    constVars[key] = isConst;
-                }
-            }
-        }
+        mergeIsolated(result, startPos, merge, context, silent);
 
         return isolatedObject;
 
     } catch (const std::runtime_error& e) {
-        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + Utility::position(startPos, input) + ")");
+        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
+    }
+}
+Value Parser::shared(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge, bool silent) {
+    std::pair<SourceBuffer, std::vector<ParserToken>> lexerResult;
+    try {
+        lexerResult = Lexer::parse(code);
     } catch (const std::exception& e) {
-        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + Utility::position(startPos, input) + ")");
+        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
     }
+    return shared(std::move(lexerResult.second), lexerResult.first, doExecute, startPos, context, name, merge, silent);
 }
-Value Parser::shared(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string name, bool merge, bool silent) {
+Value Parser::shared(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge, bool silent) {
     std::unordered_map<std::string, Value> ctx;
     if (context) {
         ctx = *context;
     }
 
-    Value result = isolated(code, doExecute, startPos, &ctx, name, merge);
+    Value result = isolated(std::move(code), std::move(source), doExecute, startPos, &ctx, name, merge);
 
     if (merge) {
-        for (const auto& [key, value] : ctx) {
-            auto constIt = constVars.find(key);
-            if (constIt != constVars.end() && constIt->second) {
-                continue;
-            }
-            if (isBuiltinVariable(key)) {
-                continue;
-            }
-
-            variables[key] = value;
-
-            if (constVars.find(key) == constVars.end()) {
-                constVars[key] = false;
-            }
-        }
+        mergeShared(ctx);
     }
 
     return result;
@@ -4986,21 +4858,22 @@ Value Parser::toJUSTO(const std::vector<Value>& args) {
     return Value::createString(JUSTO::valueToJUSTO(args[0]));
 }
 
-Value Parser::i2v(Value fromIsolated) { // isolatedToValue
-    return fromIsolated.properties["return"];
+Value Parser::i2v(const Value& fromIsolated) { // isolatedToValue
+    auto it = fromIsolated.properties().find("return");
+    return it != fromIsolated.properties().end() ? it->second : Value();
 }
-std::string Parser::t2i(ParserToken toIsolated) { // tokenToIsolated
+std::string Parser::t2i(const ParserToken& toIsolated) { // tokenToIsolated
     std::string out;
-    if (toIsolated.type == "string") {
+    if (toIsolated.kind == TokenKind::STRING) {
         out = "\"" + toIsolated.value + "\"";
-    } else if (toIsolated.type == "link") {
+    } else if (toIsolated.kind == TokenKind::LINK) {
         out = "<" + toIsolated.value + ">";
-    } else if (toIsolated.type == "Luau") {
+    } else if (toIsolated.kind == TokenKind::LUAU) {
         out = "<<" + toIsolated.value + ">>";
-    } else if (toIsolated.type == "JavaScript") {
+    } else if (toIsolated.kind == TokenKind::JAVASCRIPT) {
         out = "{{" + toIsolated.value + "}}";
     } else {
-        out = toIsolated.value;
+        out = toIsolated.value.str();
     }
     return out + " ";
 }
@@ -5008,30 +4881,30 @@ std::string Parser::t2i(ParserToken toIsolated) { // tokenToIsolated
 Value Parser::parseCondition(bool doExecute, bool wasIsolated) {
     size_t startPos = currentToken().start;
     int conditionType = 0; // 0 = if; 1 = for; 2 = while; 3 = elseif
-    std::string errMsg = "Expected 'if'/'for'/'while' keyword at " + Utility::position(startPos, input) + ".";
     bool isIsolated = wasIsolated;
 
-    if (match("keyword", "isolated")) {
+    if (match(TokenKind::KEYWORD, "isolated")) {
         isIsolated = true;
         advance();
     }
 
-    if (match("keyword", "if")) {
+    if (match(TokenKind::KEYWORD, "if")) {
         conditionType = 0;
-    } else if (match("keyword", "for")) {
+    } else if (match(TokenKind::KEYWORD, "for")) {
         conditionType = 1;
-    } else if (match("keyword", "while")) {
+    } else if (match(TokenKind::KEYWORD, "while")) {
         conditionType = 2;
-    } else if (match("keyword", "elseif")) {
+    } else if (match(TokenKind::KEYWORD, "elseif")) {
         conditionType = 3;
     } else {
-        throw std::runtime_error(errMsg);
+        throw std::runtime_error("Expected 'if'/'for'/'while' keyword at " + sourcePosition(startPos) + ".");
     }
     advance();
 
     std::unordered_map<std::string, Value> conditionContext;
     std::unordered_map<std::string, Value> conditionBodyContext;
     for (const auto& [key, value] : this->variables) {
+        if (isBuiltinVariable(key)) continue;
         try {
             conditionContext[key] = resolveVariableValue(key, false);
         } catch (...) {
@@ -5043,12 +4916,12 @@ Value Parser::parseCondition(bool doExecute, bool wasIsolated) {
     }
 
     std::vector<Value> importedContext = parseLambda(doExecute, currentToken().start);
-    for (Value importedVar : importedContext) {
+    for (const Value& importedVar : importedContext) {
         conditionContext[importedVar.name] = importedVar;
         conditionBodyContext[importedVar.name] = importedVar;
     }
 
-    if (!match("(")) {
+    if (!match(TokenKind::LEFT_PAREN)) {
         std::string currKeyword = "if";
         switch (conditionType) {
             case 1:
@@ -5064,9 +4937,10 @@ Value Parser::parseCondition(bool doExecute, bool wasIsolated) {
                 currKeyword = "if";
                 break;
         }
-        throw std::runtime_error("Expected '(' after '" + currKeyword + "' at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Expected '(' after '" + currKeyword + "' at " + sourcePosition(currentToken().start) + ".");
     }
     advance();
+    const size_t conditionFirst = position;
 
     std::stringstream first;
     std::stringstream second;
@@ -5077,17 +4951,17 @@ Value Parser::parseCondition(bool doExecute, bool wasIsolated) {
     int braceCount2= 0;
     int braceCount3= 0;
     while (braceCount > 0 && !isEnd()) {
-        if (match("(")) braceCount++;
-        else if (match(")")) braceCount--;
+        if (match(TokenKind::LEFT_PAREN)) braceCount++;
+        else if (match(TokenKind::RIGHT_PAREN)) braceCount--;
 
         if (braceCount > 0) {
-            if (braceCount == 1 && match(";") && braceCount2 == 0 && braceCount3 == 0) {
+            if (braceCount == 1 && match(TokenKind::SEMICOLON) && braceCount2 == 0 && braceCount3 == 0) {
                 ssnum++;
             } else {
-                if (match("{")) braceCount2++;
-                else if (match("}")) braceCount2--;
-                else if (match("[")) braceCount3++;
-                else if (match("]")) braceCount3--;
+                if (match(TokenKind::LEFT_BRACE)) braceCount2++;
+                else if (match(TokenKind::RIGHT_BRACE)) braceCount2--;
+                else if (match(TokenKind::LEFT_BRACKET)) braceCount3++;
+                else if (match(TokenKind::RIGHT_BRACKET)) braceCount3--;
 
                 std::string out = t2i(currentToken());
                 switch (ssnum) {
@@ -5102,126 +4976,196 @@ Value Parser::parseCondition(bool doExecute, bool wasIsolated) {
                         break;
                 }
             }
-            if (ssnum > 3) throw std::runtime_error("Unexpected ';' at " + Utility::position(currentToken().start, input) + ".");
+            if (ssnum > 3) throw std::runtime_error("Unexpected ';' at " + sourcePosition(currentToken().start) + ".");
         }
         advance();
     }
 
     if (braceCount != 0) {
-        throw std::runtime_error("Expected ')' after condition at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Expected ')' after condition at " + sourcePosition(currentToken().start) + ".");
     }
-    std::string conditionBodyErr = "Expected '{' for condition body at " + Utility::position(currentToken().start, input) + ".";
-    if (!match("{")) {
-        throw std::runtime_error(conditionBodyErr);
+    const ExpressionPtr condition = ssnum == 1 ? compileRange(conditionFirst, position - 1) : nullptr;
+    const size_t bodyPos = currentToken().start;
+    if (!match(TokenKind::LEFT_BRACE)) {
+        throw std::runtime_error("Expected '{' for condition body at " + sourcePosition(bodyPos) + ".");
     }
     advance();
+    const size_t bodyFirst = position;
 
-    enterScope();
-    std::stringstream body;
-
-    braceCount = 1;
-    while (!isEnd() && braceCount > 0) {
-        if (match("{")) braceCount++;
-        else if (match("}")) braceCount--;
-
-        if (braceCount > 0) {
-            body << t2i(currentToken());
+    auto skipBody = [this](size_t errorPos) {
+        int depth = 1;
+        while (!isEnd() && depth > 0) {
+            if (match(TokenKind::LEFT_BRACE)) depth++;
+            else if (match(TokenKind::RIGHT_BRACE)) depth--;
+            advance();
         }
-        advance();
-    }
-
-    std::string unclosedBody = "Unclosed condition body at " + Utility::position(currentToken().start, input) + ".";
-    if (braceCount != 0) {
-        throw std::runtime_error(unclosedBody);
-    }
+        if (depth != 0) throw std::runtime_error("Unclosed condition body at " + sourcePosition(errorPos == std::string::npos ? currentToken().start : errorPos) + ".");
+    };
 
-    std::string conditionBody = body.str();
+    enterScope();
+    skipBody(std::string::npos);
+    const size_t bodyEndPos = currentToken().start;
+    const std::vector<ParserToken> conditionBody(tokens.begin() + bodyFirst, tokens.begin() + position - 1);
 
     switch (conditionType) {
         case 0: case 3: { // if/elseif
             std::string currOp = conditionType == 0 ? "if" : "elseif";
-            bool conditionResult = i2v(isolated("return " + first.str() + " .", doExecute, startPos, &conditionContext, "'" + currOp + "' condition at " + Utility::position(currentToken().start, input))).toBoolean();
+            bool conditionResult = condition ?
+                conditionHolds(*condition, doExecute, &conditionContext, startPos) :
+                i2v(isolated("return " + first.str() + " .", doExecute, startPos, &conditionContext, "'" + currOp + "' condition at " + sourcePosition(currentToken().start))).toBoolean();
             exitScope();
 
             if (conditionResult) {
-                return shared(conditionBody, doExecute, startPos, &conditionBodyContext, "'" + currOp + "' body at " + Utility::position(currentToken().start, input), !isIsolated);
-            } else if (match("keyword", "else")) {
+                Value result = shared(conditionBody, source, doExecute, startPos, &conditionBodyContext, "'" + currOp + "' body at " + sourcePosition(currentToken().start), !isIsolated);
+                while (match(TokenKind::KEYWORD, "else") || match(TokenKind::KEYWORD, "elseif")) {
+                    while (!isEnd() && !match(TokenKind::LEFT_BRACE)) advance();
+                    if (!match(TokenKind::LEFT_BRACE)) {
+                        throw std::runtime_error("Expected '{' for condition body at " + sourcePosition(bodyPos) + ".");
+                    }
+                    advance();
+                    skipBody(bodyEndPos);
+                }
+                return result;
+            } else if (match(TokenKind::KEYWORD, "else")) {
                 advance();
-                if (peekToken().type == "keyword" && peekToken().value == "if") {
+                if (match(TokenKind::KEYWORD, "if")) {
                     return parseCondition(doExecute, isIsolated);
-                } else if (!match("{")) {
-                    throw std::runtime_error(conditionBodyErr);
+                } else if (!match(TokenKind::LEFT_BRACE)) {
+                    throw std::runtime_error("Expected '{' for condition body at " + sourcePosition(bodyPos) + ".");
                 }
                 advance();
+                const size_t elseFirst = position;
+                skipBody(bodyEndPos);
 
-                std::stringstream elsebody;
-
-                int braceCount4 = 1;
-                while (!isEnd() && braceCount4 > 0) {
-                    if (match("{")) braceCount4++;
-                    else if (match("}")) braceCount4--;
-
-                    if (braceCount4 > 0) {
-                        elsebody << t2i(currentToken());
-                    }
-                    advance();
-                }
-                if (braceCount4 != 0) throw std::runtime_error(unclosedBody);
-
-                return shared(elsebody.str(), doExecute, startPos, &conditionBodyContext, "'else' body at " + Utility::position(currentToken().start, input), !isIsolated);
-            } else if (match("keyword", "elseif")) {
+                return shared(std::vector<ParserToken>(tokens.begin() + elseFirst, tokens.begin() + position - 1), source, doExecute, startPos, &conditionBodyContext, "'else' body at " + sourcePosition(currentToken().start), !isIsolated);
+            } else if (match(TokenKind::KEYWORD, "elseif")) {
                 return parseCondition(doExecute, isIsolated);
             } else return Value::createNull();
         } case 2: { // while
             std::string conditionStr = "return " + first.str() + " .";
-            bool conditionResult = i2v(isolated(conditionStr, doExecute, startPos, &conditionContext, "'while' condition at " + Utility::position(currentToken().start, input))).toBoolean();
-            while (conditionResult) {
-                shared(conditionBody, doExecute, startPos, &conditionBodyContext, "'while' body at " + Utility::position(currentToken().start, input), !isIsolated);
+            const std::string at = sourcePosition(currentToken().start);
+            const std::string conditionName = "'while' condition at " + at;
+            const std::string bodyName = "'while' body at " + at;
+            std::unordered_map<std::string, Value> importedScope;
+            for (const Value& importedVar : importedContext) {
+                importedScope[importedVar.name] = importedVar;
+            }
+            auto evaluateCondition = [&]() {
+                if (condition) return conditionHolds(*condition, doExecute, &importedScope, startPos);
+                return i2v(isolated(conditionStr, doExecute, startPos, &conditionContext, conditionName)).toBoolean();
+            };
+            auto refresh = [&](std::unordered_map<std::string, Value>& context) {
                 for (const auto& [key, value] : this->variables) {
+                    if (isBuiltinVariable(key)) continue;
                     try {
-                        conditionContext[key] = resolveVariableValue(key, false);
+                        context[key] = resolveVariableValue(key, false);
                     } catch (...) {
-                        conditionContext[key] = value;
+                        context[key] = value;
+                    }
+                }
+                for (const auto& [key, value] : importedScope) {
+                    context[key] = value;
+                }
+            };
+            bool conditionResult = evaluateCondition();
+            if (conditionResult) {
+                // the body is lexed once; every iteration rewinds the same child parser instead of building a new one
+                std::unique_ptr<Parser> body = createIsolatedParser(conditionBody, source, doExecute, &conditionBodyContext, bodyName, !isIsolated);
+                bool fresh = true;
+                while (conditionResult) {
+                    try {
+                        if (!fresh) body->rewind(conditionBody, &conditionBodyContext);
+                        fresh = false;
+                        mergeIsolated(body->parse(doExecute), startPos, !isIsolated, &conditionBodyContext, false);
+                    } catch (const std::exception& e) {
+                        throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
                     }
+                    if (!isIsolated) {
+                        mergeShared(conditionBodyContext);
+                        refresh(conditionBodyContext);
+                    }
+                    if (!condition) refresh(conditionContext);
+                    conditionResult = evaluateCondition();
                 }
-                conditionResult = i2v(isolated(conditionStr, doExecute, startPos, &conditionContext, "'while' condition at " + Utility::position(currentToken().start, input))).toBoolean();
             }
             exitScope();
             return Value::createNull();
         } default:
-            throw std::runtime_error(errMsg);
+            throw std::runtime_error("Expected 'if'/'for'/'while' keyword at " + sourcePosition(startPos) + ".");
+    }
+}
+
+bool Parser::conditionHolds(const Expression& condition, bool doExecute, const std::unordered_map<std::string, Value>* context, size_t startPos) {
+    // same outcome as i2v(isolated("return <condition> .")) without lexing and parsing it again
+    try {
+        Value result = evaluate(condition, doExecute && this->doExecute, context);
+        if (result.type == DataType::VARIABLE) {
+            result = resolveVariableValue(result.string_value, true);
+        }
+        switch (result.type) {
+            case DataType::JUSTC_OBJECT:
+            case DataType::JSON_OBJECT:
+            case DataType::JSON_ARRAY:
+            case DataType::UNKNOWN:
+                return false;
+            default:
+                return result.toBoolean();
+        }
+    } catch (const std::exception& e) {
+        std::pair<size_t, size_t> pos = lineIndex().pos(startPos);
+        addLog("ERROR", std::string(e.what()) + "\n    at " + scriptName + ":" + std::to_string(pos.first) + ":" + std::to_string(pos.second), startPos);
+        return false;
+    }
+}
+
+namespace {
+    constexpr size_t COMPILED_FUNCTIONS_LIMIT = 4096;
+
+    std::mutex compiledFunctionsMutex;
+    std::unordered_map<std::string, std::shared_ptr<const CompiledFunction>> compiledFunctions;
+
+    std::shared_ptr<const CompiledFunction> makeCompiledFunction(SourceBuffer source, std::vector<ParserToken> tokens) {
+        auto compiled = std::make_shared<CompiledFunction>();
+        for (const ParserToken& token : tokens) {
+            if (token.kind == TokenKind::IDENTIFIER) {
+                compiled->identifiers.insert(token.value.str());
+            }
+        }
+        compiled->source = std::move(source);
+        compiled->tokens = std::move(tokens);
+        return compiled;
     }
 }
 
 Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, bool requireName) {
     bool isIsolated = false;
 
-    if (match("keyword", "isolated")) {
+    if (match(TokenKind::KEYWORD, "isolated")) {
         isIsolated = true;
         advance();
     }
-    if (!match("keyword", "function")) {
-        throw std::runtime_error("Expected 'function' keyword at " + Utility::position(currentToken().start, input));
+    if (!match(TokenKind::KEYWORD, "function")) {
+        throw std::runtime_error("Expected 'function' keyword at " + sourcePosition(currentToken().start));
     }
     advance();
 
     if (requireName) {
-        if (!match("identifier")) {
-            throw std::runtime_error("Expected function name at " + Utility::position(currentToken().start, input));
+        if (!match(TokenKind::IDENTIFIER)) {
+            throw std::runtime_error("Expected function name at " + sourcePosition(currentToken().start));
         }
-        funcName = currentToken().value;
+        funcName = currentToken().value.str();
         advance();
     } else {
-        if (match("identifier")) {
-            funcName = currentToken().value;
+        if (match(TokenKind::IDENTIFIER)) {
+            funcName = currentToken().value.str();
             advance();
         }
     }
 
     std::vector<Value> importedContext = parseLambda(doExecute, currentToken().start);
 
-    if (!match("(")) {
-        throw std::runtime_error("Expected '(' after function name at " + Utility::position(currentToken().start, input));
+    if (!match(TokenKind::LEFT_PAREN)) {
+        throw std::runtime_error("Expected '(' after function name at " + sourcePosition(currentToken().start));
     }
     advance();
 
@@ -5229,21 +5173,21 @@ Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, boo
     funcInfo.isIsolated = isIsolated;
     std::vector<std::string> paramNames;
 
-    while (!match(")") && !isEnd()) {
-        if (match("identifier")) {
-            std::string paramName = currentToken().value;
+    while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
+        if (match(TokenKind::IDENTIFIER)) {
+            std::string paramName = currentToken().value.str();
             advance();
 
             DataType paramType = DataType::UNKNOWN;
             Value defaultValue;
             bool hasDefault = false;
 
-            if (match(":")) {
+            if (match(TokenKind::COLON)) {
                 advance();
-                if (match("identifier")) {
-                    std::string typeName = currentToken().value;
+                if (match(TokenKind::IDENTIFIER)) {
+                    std::string typeName = currentToken().value.str();
                     try {
-                        paramType = Utility::typeDeclaration2dataType(typeName, Utility::position(currentToken().start, input));
+                        paramType = Utility::typeDeclaration2dataType(typeName, sourcePosition(currentToken().start));
                     } catch (...) {
                         paramType = DataType::UNKNOWN;
                     }
@@ -5251,7 +5195,7 @@ Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, boo
                 }
             }
 
-            if (match("=") || match("keyword", "is")) {
+            if (match(TokenKind::EQUAL) || match(TokenKind::KEYWORD, "is")) {
                 advance();
                 defaultValue = parseExpression(doExecute);
                 hasDefault = true;
@@ -5261,30 +5205,31 @@ Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, boo
             funcInfo.paramTypes.push_back(paramType);
             funcInfo.defaultValues.push_back(hasDefault ? defaultValue : Value::createNull());
 
-            if (match(",")) {
+            if (match(TokenKind::COMMA)) {
                 advance();
             }
         } else {
-            throw std::runtime_error("Expected parameter name at " + Utility::position(currentToken().start, input));
+            throw std::runtime_error("Expected parameter name at " + sourcePosition(currentToken().start));
         }
     }
 
-    if (!match(")")) {
-        throw std::runtime_error("Expected ')' after parameters at " + Utility::position(currentToken().start, input));
+    if (!match(TokenKind::RIGHT_PAREN)) {
+        throw std::runtime_error("Expected ')' after parameters at " + sourcePosition(currentToken().start));
     }
     advance();
 
-    if (!match("{")) {
-        throw std::runtime_error("Expected '{' for function body at " + Utility::position(currentToken().start, input));
+    if (!match(TokenKind::LEFT_BRACE)) {
+        throw std::runtime_error("Expected '{' for function body at " + sourcePosition(currentToken().start));
     }
     advance();
 
     std::stringstream body;
+    const size_t bodyFirst = position;
     int braceCount = 1;
 
     while (!isEnd() && braceCount > 0) {
-        if (match("{")) braceCount++;
-        else if (match("}")) braceCount--;
+        if (match(TokenKind::LEFT_BRACE)) braceCount++;
+        else if (match(TokenKind::RIGHT_BRACE)) braceCount--;
 
         if (braceCount > 0) {
             body << t2i(currentToken());
@@ -5293,7 +5238,7 @@ Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, boo
     }
 
     if (braceCount != 0) {
-        throw std::runtime_error("Unclosed function body at " + Utility::position(currentToken().start, input));
+        throw std::runtime_error("Unclosed function body at " + sourcePosition(currentToken().start));
     }
 
     std::string functionBody = body.str();
@@ -5302,52 +5247,104 @@ Value Parser::parseFunctionDeclaration(bool doExecute, std::string funcName, boo
     result.type = DataType::FUNCTION;
     result.string_value = functionBody;
     result.name = funcName;
-    result.function_info = funcInfo;
-    result.array_elements = importedContext;
+    result.mutableData().function_info = funcInfo;
+    result.mutableData().function_info.compiled = makeCompiledFunction(source, std::vector<ParserToken>(tokens.begin() + bodyFirst, tokens.begin() + position - 1));
+    result.mutableData().array_elements = importedContext;
 
     auto closureContext = std::make_shared<ObjectContext>();
     if (!isIsolated) {
-        for (const auto& [key, value] : this->variables) {
-            closureContext->variables[key] = value;
+        std::unordered_set<std::string> names;
+        captureNames(result, names, currentToken().start);
+        for (const std::string& name : names) {
+            auto it = this->variables.find(name);
+            if (it != this->variables.end()) {
+                closureContext->variables[name] = it->second;
+            }
         }
     }
     closureContext->allowJavaScript = this->allowJavaScript;
     closureContext->allowLuau = this->allowLuau;
-    result.closure_context = closureContext;
+    result.mutableData().closure_context = closureContext;
 
     return result;
 }
 
+std::shared_ptr<const CompiledFunction> Parser::compileFunction(const Value& function, size_t startPos) {
+    std::shared_ptr<const CompiledFunction> compiled = std::atomic_load(&function.function_info().compiled);
+    if (compiled) return compiled;
+
+    {
+        std::lock_guard<std::mutex> lock(compiledFunctionsMutex);
+        auto it = compiledFunctions.find(function.string_value);
+        if (it != compiledFunctions.end()) compiled = it->second;
+    }
+    if (!compiled) {
+        std::pair<SourceBuffer, std::vector<ParserToken>> lexerResult;
+        try {
+            lexerResult = Lexer::parse(function.string_value);
+        } catch (const std::exception& e) {
+            throw std::runtime_error(std::string(e.what()) + " (at \"" + this->scriptName + "\" " + sourcePosition(startPos) + ")");
+        }
+        compiled = makeCompiledFunction(std::move(lexerResult.first), std::move(lexerResult.second));
+
+        std::lock_guard<std::mutex> lock(compiledFunctionsMutex);
+        if (compiledFunctions.size() >= COMPILED_FUNCTIONS_LIMIT) compiledFunctions.clear();
+        compiledFunctions.emplace(function.string_value, compiled);
+    }
+
+    std::atomic_store(&function.function_info().compiled, compiled);
+    return compiled;
+}
+void Parser::captureNames(const Value& function, std::unordered_set<std::string>& names, size_t startPos) {
+    for (const std::string& name : compileFunction(function, startPos)->identifiers) {
+        if (!names.insert(name).second) continue;
+        auto it = variables.find(name);
+        if (it != variables.end() && it->second.type == DataType::FUNCTION && !it->second.native) {
+            captureNames(it->second, names, startPos);
+        }
+    }
+}
+
 Value Parser::callFunction(const Value& function, const std::vector<Value>& args, size_t startPos, bool doExecute) {
     if (function.type != DataType::FUNCTION) {
-        throw std::runtime_error("Cannot call non-function value at " + Utility::position(startPos, input));
+        throw std::runtime_error("Cannot call non-function value at " + sourcePosition(startPos));
     } else if (!doExecute) {
         return onExecDisabled(startPos, function.name);
     } else if (function.native) {
         return executeFunction(function.name, args, startPos);
     }
 
-    const auto& funcInfo = function.function_info;
+    const auto& funcInfo = function.function_info();
+    std::shared_ptr<const CompiledFunction> body = compileFunction(function, startPos);
+
+    // only what the body (or a function it can reach by name or argument) refers to
+    std::unordered_set<std::string> names;
+    captureNames(function, names, startPos);
+    for (const Value& arg : args) {
+        if (arg.type == DataType::FUNCTION && !arg.native) captureNames(arg, names, startPos);
+    }
 
     std::unordered_map<std::string, Value> functionContext;
 
-    if (function.closure_context) {
-        for (const auto& [key, value] : function.closure_context->variables) {
-            functionContext[key] = value;
+    if (function.closure_context()) {
+        for (const auto& [key, value] : function.closure_context()->variables) {
+            if (names.count(key)) functionContext[key] = value;
         }
     }
 
-    if (!function.function_info.isIsolated) {
-        for (const auto& [key, value] : this->variables) {
+    if (!function.function_info().isIsolated) {
+        for (const std::string& name : names) {
+            auto it = this->variables.find(name);
+            if (it == this->variables.end()) continue;
             try {
-                functionContext[key] = resolveVariableValue(key, false);
+                functionContext[name] = resolveVariableValue(name, false);
             } catch (...) {
-                functionContext[key] = value;
+                functionContext[name] = it->second;
             }
         }
     }
 
-    for (Value importedVar : function.array_elements) {
+    for (const Value& importedVar : function.array_elements()) {
         functionContext[importedVar.name] = importedVar;
     }
 
@@ -5360,27 +5357,28 @@ Value Parser::callFunction(const Value& function, const std::vector<Value>& args
             if (funcInfo.paramTypes[i] != DataType::UNKNOWN) {
                 ASTNode typeNode("TYPE_CHECK", "", startPos);
                 typeNode.typeDeclaration = funcInfo.paramTypes[i];
-                paramValue = applyTypeDeclaration(paramValue, typeNode);
+                paramValue = applyTypeDeclaration(std::move(paramValue), typeNode);
             }
         } else if (funcInfo.defaultValues[i].type != DataType::NULL_TYPE) {
             paramValue = funcInfo.defaultValues[i];
         } else {
-            throw std::runtime_error("Missing required argument '" + funcInfo.paramNames[i] + "' for function '" + function.name + "' at " + Utility::position(startPos, input));
+            throw std::runtime_error("Missing required argument '" + funcInfo.paramNames[i] + "' for function '" + function.name + "' at " + sourcePosition(startPos));
         }
 
-        functionContext[funcInfo.paramNames[i]] = paramValue;
+        functionContext[funcInfo.paramNames[i]] = std::move(paramValue);
     }
 
-    Value result = isolated(function.string_value, true, startPos, &functionContext);
+    Value result = isolated(body->tokens, body->source, true, startPos, &functionContext);
 
-    if (!result.properties.empty()) {
-        auto it = result.properties.find("return");
-        if (it != result.properties.end()) {
+    const auto& properties = std::as_const(result).properties();
+    if (!properties.empty()) {
+        auto it = properties.find("return");
+        if (it != properties.end()) {
             return it->second;
         }
 
-        if (result.properties.size() == 1) {
-            return result.properties.begin()->second;
+        if (properties.size() == 1) {
+            return properties.begin()->second;
         }
 
         return result;
@@ -5565,115 +5563,83 @@ Value Parser::octalToValue(const std::string& octStr) {
     return result;
 }
 
-void Parser::evaluateAllVariablesSync() {
-    bool changed;
-    uint64_t passes = 0;
-    const uint64_t MAX_PASSES = std::min(
-        static_cast<uint64_t>(0xFF) * variables.size(), 
-        std::numeric_limits<uint64_t>::max()
-    );
-
-    do {
-        changed = false;
-        passes++;
-
-        for (auto& [varName, mut] : mutated) {
-            if (isBuiltinVariable(varName) || hasLocal(currentScope, varName)) {
-                continue;
-            }
-            if (mut.applied) continue;
-
-            auto constIt = constVars.find(varName);
-            if (constIt != constVars.end() && constIt->second) {
-                continue;
-            }
-
-            ASTNode* originalNode = nullptr;
-            for (auto& node : ast) {
-                if (node.type == "VARIABLE_DECLARATION" && node.identifier == varName) {
-                    originalNode = &node;
-                    break;
-                }
-            }
+void Parser::applyMutations() {
+    for (auto& [varName, mut] : mutated) {
+        if (isBuiltinVariable(varName) || hasLocal(currentScope, varName)) {
+            continue;
+        }
 
-            if (originalNode && mut.startPos > originalNode->startPos) {
-                if (variables[varName].toString() != mut.value.toString()) {
-                    variables[varName] = mut.value;
-                    constVars[varName] = false;
-                    changed = true;
-                    mut.applied = true;
-                    triggerVariableUpdate(varName, mut.value);
-                }
+        auto constIt = constVars.find(varName);
+        if (constIt != constVars.end() && constIt->second) {
+            continue;
+        }
+
+        const std::pmr::vector<size_t>* declared = findDeclarations(varName);
+        if (declared && mut.startPos > ast[declared->front()].startPos) {
+            if (variables[varName].toString() != mut.value.toString()) {
+                ++generation;
+                variables[varName] = mut.value;
+                constVars[varName] = false;
+                mut.applied = true;
+                triggerVariableUpdate(varName, mut.value);
             }
         }
+    }
+}
 
-        for (auto& node : ast) {
-            if (node.type == "VARIABLE_DECLARATION") {
-                std::string varName = node.identifier;
-                if (isBuiltinVariable(varName) || hasLocal(currentScope, varName)) {
-                    continue;
-                }
-
-                auto mutIt = mutated.find(varName);
-                if (mutIt != mutated.end() && !mutIt->second.applied) {
-                    continue;
-                }
-
-                bool isConst = node.constant;
-                auto constIt = constVars.find(varName);
-                if (constIt != constVars.end() && constIt->second && variables[varName].type != DataType::UNKNOWN) {
-                    continue;
-                }
+void Parser::evaluateVariable(const std::string& varName) {
+    if (isBuiltinVariable(varName) || hasLocal(currentScope, varName)) {
+        return;
+    }
 
-                Value newValue = evaluateASTNode(node);
+    auto mutIt = mutated.find(varName);
+    if (mutIt != mutated.end() && !mutIt->second.applied) {
+        return;
+    }
 
-                if (newValue.type == DataType::VARIABLE && newValue.string_value == varName) {
-                    throw std::runtime_error("Variable cannot reference itself: " + varName);
-                }
+    const std::pmr::vector<size_t>* declared = findDeclarations(varName);
+    if (!declared) return;
 
-                if (newValue.type != DataType::UNKNOWN) {
-                    if (variables[varName].type == DataType::UNKNOWN || variables[varName].toString() != newValue.toString()) {
-                        variables[varName] = newValue;
-                        if (isConst) constVars[varName] = true;
-                        changed = true;
-                        triggerVariableUpdate(varName, newValue);
-                    }
-                }
-            }
+    for (size_t index : *declared) {
+        const ASTNode& node = ast[index];
+        auto constIt = constVars.find(varName);
+        if (constIt != constVars.end() && constIt->second && variables[varName].type != DataType::UNKNOWN) {
+            continue;
         }
 
-    } while (changed && passes < MAX_PASSES);
+        Value newValue = evaluateDeclaration(index);
 
-    mutated.clear();
+        if (newValue.type == DataType::VARIABLE && newValue.string_value == varName) {
+            throw std::runtime_error("Variable cannot reference itself: " + varName);
+        }
 
-    if (passes >= MAX_PASSES) {
-        throw std::runtime_error("Cannot resolve variable dependencies - possible circular reference.");
+        if (newValue.type != DataType::UNKNOWN) {
+            Value& current = variables[varName];
+            if (current.type == DataType::UNKNOWN || current.toString() != newValue.toString()) {
+                ++generation;
+                current = newValue;
+                if (node.constant) constVars[varName] = true;
+                triggerVariableUpdate(varName, newValue);
+            }
+        }
     }
 }
 
-void Parser::evaluateAllVariablesAsync() {
-#ifndef __EMSCRIPTEN__
-    std::unordered_map<std::string, std::future<Value>> futures;
-
-    for (auto& node : ast) {
-        if (node.type == "VARIABLE_DECLARATION") {
-            std::string varName = node.identifier;
-            if (dependencies[varName].empty()) {
-                futures[varName] = executeAsyncIfEnabled([this, node]() {
-                    return evaluateASTNode(node);
-                });
-            }
-        }
+void Parser::joinResponses() {
+    for (auto& [name, value] : variables) {
+        if (value.response()) value = joined(value);
     }
+}
+
+void Parser::evaluateAllVariables() {
+    applyMutations();
 
-    for (auto it = futures.begin(); it != futures.end(); ++it) {
-        variables[it->first] = it->second.get();
+    // dependencies are evaluated first, so one pass in evaluationOrder is enough
+    for (const auto& varName : evaluationOrder) {
+        evaluateVariable(varName);
     }
 
-    evaluateAllVariablesSync();
-#else
-    evaluateAllVariablesSync();
-#endif
+    mutated.clear();
 }
 
 std::shared_ptr<ObjectContext> Parser::createObjectContext(bool inheritFromParent) {
@@ -5691,7 +5657,7 @@ std::shared_ptr<ObjectContext> Parser::createObjectContext(bool inheritFromParen
     return context;
 }
 Value Parser::parseJustcObject(bool doExecute) {
-    if (!match("|")) {
+    if (!match(TokenKind::PIPE)) {
         throw std::runtime_error("Expected '|' for object.");
     }
     advance();
@@ -5705,42 +5671,42 @@ Value Parser::parseJustcObject(bool doExecute) {
     char stringChar = 0;
 
     while (!isEnd() && pipeCount > 0) {
-        ParserToken current = currentToken();
-        std::string currentValue = current.value;
+        const ParserToken& current = currentToken();
+        std::string currentValue = current.value.str();
 
-        if (!inComment && current.type == "string") {
+        if (!inComment && current.kind == TokenKind::STRING) {
             inString = !inString;
         }
 
         if (!inString && !inComment) {
-            if (current.type == "|") {
+            if (current.kind == TokenKind::PIPE) {
                 pipeCount--;
                 if (pipeCount == 0) {
                     advance();
                     break;
                 }
-            } else if (current.type == "{" && peekToken().type == "{") {
+            } else if (current.kind == TokenKind::LEFT_BRACE && peekToken().kind == TokenKind::LEFT_BRACE) {
                 advance();
                 advance();
 
                 int jsBraces = 1;
                 while (!isEnd() && jsBraces > 0) {
-                    if (match("{")) jsBraces++;
-                    else if (match("}")) jsBraces--;
+                    if (match(TokenKind::LEFT_BRACE)) jsBraces++;
+                    else if (match(TokenKind::RIGHT_BRACE)) jsBraces--;
                     advance();
                 }
                 continue;
-            } else if (current.type == "<" && peekToken().type == "<") {
+            } else if (current.kind == TokenKind::LESS && peekToken().kind == TokenKind::LESS) {
                 advance();
                 advance();
 
                 int luauAngles = 1;
                 while (!isEnd() && luauAngles > 0) {
-                    if (match("<") && peekToken().type == "<") {
+                    if (match(TokenKind::LESS) && peekToken().kind == TokenKind::LESS) {
                         advance();
                         advance();
                         luauAngles++;
-                    } else if (match(">") && peekToken().type == ">") {
+                    } else if (match(TokenKind::GREATER) && peekToken().kind == TokenKind::GREATER) {
                         advance();
                         advance();
                         luauAngles--;
@@ -5749,7 +5715,7 @@ Value Parser::parseJustcObject(bool doExecute) {
                     }
                 }
                 continue;
-            } else if (current.type == "|") {
+            } else if (current.kind == TokenKind::PIPE) {
                 pipeCount++;
             }
         }
@@ -5759,7 +5725,7 @@ Value Parser::parseJustcObject(bool doExecute) {
     }
 
     if (pipeCount > 0) {
-        throw std::runtime_error("Unclosed object at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Unclosed object at " + sourcePosition(currentToken().start) + ".");
     }
 
     auto lexerResult = Lexer::parse(objectContent, false);
@@ -5774,10 +5740,10 @@ Value Parser::parseJustcObject(bool doExecute) {
     }
 
     auto objectParser = std::make_shared<Parser>(
-        lexerResult.second,
+        std::move(lexerResult.second),
         doExecute,
         runAsync,
-        objectContent,
+        lexerResult.first,
         objectContext->allowJavaScript,
         canAllowJS,
         scriptName + "::object",
@@ -5800,7 +5766,7 @@ Value Parser::parseJustcObject(bool doExecute) {
     Value result = Value::createJustcObject(objectContext);
 
     if (objectParser->outputMode == "everything") {
-        result.properties = objectResult.returnValues;
+        result.mutableData().properties = objectResult.returnValues;
     } else if (objectParser->outputMode == "specified") {
         for (size_t i = 0; i < objectParser->outputVariables.size(); i++) {
             const auto& varName = objectParser->outputVariables[i];
@@ -5809,9 +5775,9 @@ Value Parser::parseJustcObject(bool doExecute) {
 
             if (objectResult.returnValues.find(varName) != objectResult.returnValues.end()) {
                 if (outputName != "_") {
-                    result.properties[outputName] = objectResult.returnValues.at(varName);
+                    result.mutableData().properties[outputName] = objectResult.returnValues.at(varName);
                 } else {
-                    result.properties[varName] = objectResult.returnValues.at(varName);
+                    result.mutableData().properties[varName] = objectResult.returnValues.at(varName);
                 }
             }
         }
@@ -5822,7 +5788,7 @@ Value Parser::parseJustcObject(bool doExecute) {
 }
 
 Value Parser::parseJsonObject(bool doExecute) {
-    if (!match("{")) {
+    if (!match(TokenKind::LEFT_BRACE)) {
         throw std::runtime_error("Expected \"{\" for object.");
     }
     advance();
@@ -5830,7 +5796,7 @@ Value Parser::parseJsonObject(bool doExecute) {
     std::unordered_map<std::string, Value> properties;
 
     skipCommas();
-    while (!match("}") && !isEnd()) {
+    while (!match(TokenKind::RIGHT_BRACE) && !isEnd()) {
         Value keyVal = parseExpression(doExecute, true);
         std::string key;
 
@@ -5840,37 +5806,37 @@ Value Parser::parseJsonObject(bool doExecute) {
             key = keyVal.toString();
         }
 
-        if (match(":") || match("=") || match("-") || match("keyword", "is")) {
+        if (match(TokenKind::COLON) || match(TokenKind::EQUAL) || match(TokenKind::DASH) || match(TokenKind::KEYWORD, "is")) {
             advance();
         } else if (!CanIgnoreNoAssigmentOperator()) {
-            throw std::runtime_error("Expected \":\" after key in object at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Expected \":\" after key in object at " + sourcePosition(currentToken().start) + ".");
         }
 
         Value valueVal = parseExpression(doExecute);
         properties[key] = valueVal;
 
         skipCommas();
-        if (match(",")) {
+        if (match(TokenKind::COMMA)) {
             advance();
             skipCommas();
         }
     }
 
-    if (!match("}")) {
-        throw std::runtime_error("Expected \"}\" to close object at " + Utility::position(currentToken().start, input) + ".");
+    if (!match(TokenKind::RIGHT_BRACE)) {
+        throw std::runtime_error("Expected \"}\" to close object at " + sourcePosition(currentToken().start) + ".");
     }
     advance();
 
     auto jsonContext = createObjectContext(true);
 
     Value result = Value::createJsonObject(properties);
-    result.object_context = jsonContext;
+    result.mutableData().object_context = jsonContext;
     result.name = "[Object]";
 
     return result;
 }
 Value Parser::parseJsonArray(bool doExecute) {
-    if (!match("[")) {
+    if (!match(TokenKind::LEFT_BRACKET)) {
         throw std::runtime_error("Expected '[' for array.");
     }
     advance();
@@ -5878,26 +5844,26 @@ Value Parser::parseJsonArray(bool doExecute) {
     std::vector<Value> elements;
 
     skipCommas();
-    while (!match("]") && !isEnd()) {
+    while (!match(TokenKind::RIGHT_BRACKET) && !isEnd()) {
         Value element = parseExpression(doExecute);
         elements.push_back(element);
 
         skipCommas();
-        if (match(",")) {
+        if (match(TokenKind::COMMA)) {
             advance();
             skipCommas();
         }
     }
 
-    if (!match("]")) {
-        throw std::runtime_error("Expected ']' to close array at " + Utility::position(currentToken().start, input) + ".");
+    if (!match(TokenKind::RIGHT_BRACKET)) {
+        throw std::runtime_error("Expected ']' to close array at " + sourcePosition(currentToken().start) + ".");
     }
     advance();
 
     auto arrayContext = createObjectContext(true);
 
     Value result = Value::createJsonArray(elements);
-    result.object_context = arrayContext;
+    result.mutableData().object_context = arrayContext;
     result.name = "[Array]";
 
     return result;
@@ -5905,20 +5871,20 @@ Value Parser::parseJsonArray(bool doExecute) {
 Value Parser::parseObjectPropertyAccess(bool doExecute) {
     std::vector<std::variant<std::string, size_t>> accessChain;
 
-    std::string firstIdentifier = currentToken().value;
+    std::string firstIdentifier = currentToken().value.str();
     accessChain.push_back(firstIdentifier);
     advance();
 
-    while ((match(".") || match("[")) && position + 1 < tokens.size()) {
-        if (match(".")) {
+    while ((match(TokenKind::DOT) || match(TokenKind::LEFT_BRACKET)) && position + 1 < tokens.size()) {
+        if (match(TokenKind::DOT)) {
             advance();
-            if (!match("identifier") && !match("keyword") && !isEnd()) {
-                throw std::runtime_error("Expected property name after \".\" at " + Utility::position(currentToken().start, input) + ".");
+            if (!match(TokenKind::IDENTIFIER) && !match(TokenKind::KEYWORD) && !isEnd()) {
+                throw std::runtime_error("Expected property name after \".\" at " + sourcePosition(currentToken().start) + ".");
             }
-            std::string propName = currentToken().value;
+            std::string propName = currentToken().value.str();
             accessChain.push_back(propName);
             advance();
-        } else if (match("[")) {
+        } else if (match(TokenKind::LEFT_BRACKET)) {
             advance();
             Value indexVal = parseExpression(doExecute);
             if (indexVal.type == DataType::STRING) {
@@ -5926,34 +5892,38 @@ Value Parser::parseObjectPropertyAccess(bool doExecute) {
             } else if (indexVal.type == DataType::NUMBER) {
                 accessChain.push_back(static_cast<size_t>(indexVal.toNumber()));
             } else {
-                throw std::runtime_error("Expected string or numeric index in bracket access, got <" + dataTypeToString(indexVal.type) + "> at " + Utility::position(currentToken().start, input) + ".");
+                throw std::runtime_error("Expected string or numeric index in bracket access, got <" + dataTypeToString(indexVal.type) + "> at " + sourcePosition(currentToken().start) + ".");
             }
-            if (!match("]")) {
-                throw std::runtime_error("Expected \"]\" to close array access, got \"" + currentToken().value + "\" at " + Utility::position(currentToken().start, input) + ".");
+            if (!match(TokenKind::RIGHT_BRACKET)) {
+                throw std::runtime_error("Expected \"]\" to close array access, got \"" + currentToken().value + "\" at " + sourcePosition(currentToken().start) + ".");
             }
             advance();
         }
     }
 
+    return resolvePropertyAccess(accessChain, resolveVariableValue(firstIdentifier, false), match(TokenKind::LEFT_PAREN), [&]() {
+        return parseArguments(doExecute);
+    }, doExecute);
+}
+Value Parser::resolvePropertyAccess(const std::vector<std::variant<std::string, size_t>>& accessChain, Value currentValue, bool call, const std::function<std::vector<Value>()>& arguments, bool doExecute) {
     std::string rootName = std::get<std::string>(accessChain[0]);
-    Value currentValue = resolveVariableValue(rootName, false);
 
     std::string error = "\"" + rootName + "\" is not an object. Attempt to access property or index of not an object";
     auto checkTypeMethods = [&]() -> Value {
         if (doExecute) {
-            auto it = typeMethods.find(currentValue.type);
+            auto it = tables.typeMethods.find(currentValue.type);
             auto last = accessChain.back();
-            if (it != typeMethods.end() && std::holds_alternative<std::string>(last)) {
+            if (it != tables.typeMethods.end() && std::holds_alternative<std::string>(last)) {
                 std::string funcName = std::get<std::string>(last);
-                auto itFunc = typeMethods[currentValue.type].find(funcName);
-                if (itFunc != typeMethods[currentValue.type].end()) {
-                    if (match("(")) {
+                auto itFunc = it->second.find(funcName);
+                if (itFunc != it->second.end()) {
+                    if (call) {
                         std::vector<Value> args = {currentValue};
-                        std::vector<Value> additionalArgs = parseArguments(doExecute);
+                        std::vector<Value> additionalArgs = arguments();
                         args.insert(args.end(), additionalArgs.begin(), additionalArgs.end());
-                        return executeFunction(typeMethods[currentValue.type][funcName], args, currentToken().start);
+                        return executeFunction(itFunc->second, args, currentToken().start);
                     } else {
-                        return executeFunction(typeMethods[currentValue.type][funcName], {currentValue}, currentToken().start);
+                        return executeFunction(itFunc->second, {currentValue}, currentToken().start);
                     }
                 }
             }
@@ -5967,7 +5937,7 @@ Value Parser::parseObjectPropertyAccess(bool doExecute) {
                 }, currentToken().start);
             }
         }
-        throw std::runtime_error(error + " at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error(error + " at " + sourcePosition(currentToken().start) + ".");
     };
 
     if (!currentValue.isObject() && accessChain.size() > 1) return checkTypeMethods();
@@ -5987,7 +5957,7 @@ Value Parser::parseObjectPropertyAccess(bool doExecute) {
 
     auto last = accessChain.back();
 
-    if (match("(")) { // function
+    if (call) { // function
         std::string funcName;
         if (std::holds_alternative<std::string>(last)) {
             funcName = std::get<std::string>(last);
@@ -5996,9 +5966,9 @@ Value Parser::parseObjectPropertyAccess(bool doExecute) {
         Value func = accessProperty(currentValue, funcName);
 
         if (func.type == DataType::FUNCTION) { // user funciton
-            return callFunction(func, parseArguments(doExecute), currentToken().start, doExecute);
+            return callFunction(func, arguments(), currentToken().start, doExecute);
         } else { // built-in function
-            return executeFunction(funcName, parseArguments(doExecute), currentToken().start);
+            return executeFunction(funcName, arguments(), currentToken().start);
         }
     } else { // property/index
         if (std::holds_alternative<std::string>(last)) { // object
@@ -6010,90 +5980,92 @@ Value Parser::parseObjectPropertyAccess(bool doExecute) {
 }
 Value Parser::accessProperty(const Value& obj, const std::string& propName) {
     if (obj.type == DataType::JUSTC_OBJECT) {
-        if (obj.object_context && obj.object_context->parser) {
-            if (obj.object_context->parser->outputMode == "disabled") {
-                throw std::runtime_error("Attempt to access \"" + propName + "\" of a closure (Object with output mode \"disabled\") at " + Utility::position(currentToken().start, input) + ".");
+        if (obj.object_context() && obj.object_context()->parser) {
+            if (obj.object_context()->parser->outputMode == "disabled") {
+                throw std::runtime_error("Attempt to access \"" + propName + "\" of a closure (Object with output mode \"disabled\") at " + sourcePosition(currentToken().start) + ".");
             }
 
-            auto it = obj.properties.find(propName);
-            if (it != obj.properties.end()) {
+            auto it = obj.properties().find(propName);
+            if (it != obj.properties().end()) {
                 return it->second;
             }
 
-            auto& parserVars = obj.object_context->variables;
+            auto& parserVars = obj.object_context()->variables;
             auto varIt = parserVars.find(propName);
             if (varIt != parserVars.end()) {
                 return varIt->second;
             }
 
-            throw std::runtime_error("Property '" + propName + "' not found in object at " + Utility::position(currentToken().start, input) + ".");
+            throw std::runtime_error("Property '" + propName + "' not found in object at " + sourcePosition(currentToken().start) + ".");
         }
     } else if (obj.type == DataType::JSON_OBJECT) {
-        auto it = obj.properties.find(propName);
-        if (it != obj.properties.end()) {
+        auto it = obj.properties().find(propName);
+        if (it != obj.properties().end()) {
             return it->second;
         }
-        throw std::runtime_error("Property '" + propName + "' not found in object at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Property '" + propName + "' not found in object at " + sourcePosition(currentToken().start) + ".");
     } else if (obj.type == DataType::JSON_ARRAY) {
-        throw std::runtime_error("Cannot access property '" + propName + "' on array at " + Utility::position(currentToken().start, input) + ".");
+        throw std::runtime_error("Cannot access property '" + propName + "' on array at " + sourcePosition(currentToken().start) + ".");
     }
 
-    throw std::runtime_error("Cannot access property '" + propName + "' on non-object at " + Utility::position(currentToken().start, input) + ".");
+    throw std::runtime_error("Cannot access property '" + propName + "' on non-object at " + sourcePosition(currentToken().start) + ".");
 }
 Value Parser::accessIndex(const Value& arr, size_t index) {
     if (arr.type == DataType::JSON_ARRAY) {
-        if (index < arr.array_elements.size()) {
-            return arr.array_elements[index];
+        if (index < arr.array_elements().size()) {
+            return arr.array_elements()[index];
         }
         return Value::createNull();
     }
-    throw std::runtime_error("Cannot access index " + std::to_string(index) + " on non-array at " + Utility::position(currentToken().start, input) + ".");
+    throw std::runtime_error("Cannot access index " + std::to_string(index) + " on non-array at " + sourcePosition(currentToken().start) + ".");
 }
 std::vector<Value> Parser::parseArguments(bool doExecute) {
     std::vector<Value> args;
     advance();
 
-    while (!match(")") && !isEnd()) {
+    while (!match(TokenKind::RIGHT_PAREN) && !isEnd()) {
         args.push_back(parseExpression(doExecute));
-        if (match(",") || match(";")) advance();
+        if (match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) advance();
     }
 
-    if (!match(")")) {
-        throw std::runtime_error("Expected ')' after function arguments at " + Utility::position(currentToken().start, input) + ".");
+    if (!match(TokenKind::RIGHT_PAREN)) {
+        throw std::runtime_error("Expected ')' after function arguments at " + sourcePosition(currentToken().start) + ".");
     }
     advance();
 
     return args;
 }
 
-void Parser::initializeCPPTypes() {
-    cpptypes = ::cpptypes;
-    cppnumbers = ::cppnumbers;
-}
 bool Parser::isCPPType() {
-    if (!match("keyword")) return false;
-    return std::find(cpptypes.begin(), cpptypes.end(), currentToken().value) != cpptypes.end();
+    if (!match(TokenKind::KEYWORD)) return false;
+    return tables.cpptypes.count(currentToken().value.str()) != 0;
 }
 bool Parser::isCPPNumber(const std::string& cpptype) {
-    return std::find(cppnumbers.begin(), cppnumbers.end(), cpptype) != cppnumbers.end();
-}
-void Parser::initializeBuiltIns() {
-    builtins = ::builtins;
+    return tables.cppnumbers.count(cpptype) != 0;
 }
 bool Parser::isBuiltinVariable(const std::string& name) const {
-    return std::find(builtins.begin(), builtins.end(), name) != builtins.end();
+    return tables.builtins.count(name) != 0;
 }
 void Parser::handleBuiltinVariableAssignment(const std::string& name, const Value& value, size_t startPos) {
     if (name == "CharType") {
         updateCharType(value.toString(), startPos);
     } else if (name == "JUSTC") {
-        throw std::runtime_error("Attempt to redefine readonly built-in variable \"" + name + "\" at " + Utility::position(startPos, input) + ".");
+        throw std::runtime_error("Attempt to redefine readonly built-in variable \"" + name + "\" at " + sourcePosition(startPos) + ".");
     }
 }
 void Parser::removeBuiltinVariablesFromOutput() {
-    for (const auto& name : builtins) {
-        variables.erase(name);
-        constVars.erase(name);
+    // node handles move the entries without reallocating them; rewind() moves them back the same way
+    for (const auto& name : ::builtins) {
+        auto it = variables.find(name);
+        if (it != variables.end()) {
+            builtinValues.erase(name);
+            builtinValues.insert(variables.extract(it));
+        }
+        auto constIt = constVars.find(name);
+        if (constIt != constVars.end()) {
+            builtinConstVars.erase(name);
+            builtinConstVars.insert(constVars.extract(constIt));
+        }
     }
 }
 
@@ -6111,26 +6083,35 @@ void Parser::updateCharType(const std::string& newType, size_t startPos) {
     if (success) {
         addLog("CHARTYPE", newType, startPos);
     } else {
-        throw std::runtime_error("Invalid chartype: " + newType + ". Must be 'grapheme', 'codepoint', or 'byte' at " + Utility::position(startPos, input));
+        throw std::runtime_error("Invalid chartype: " + newType + ". Must be 'grapheme', 'codepoint', or 'byte' at " + sourcePosition(startPos));
     }
 }
 
+FunctionRegistry& Parser::ownUserFunctions() {
+    if (userFunctions.use_count() > 1) {
+        userFunctions = std::make_shared<FunctionRegistry>(*userFunctions);
+    }
+    return *userFunctions;
+}
 void Parser::registerFunction(const std::string& name, Function func, bool isConst) {
-    userFunctions[name] = func;
-    userFunctionsConst[name] = isConst;
+    FunctionRegistry& registry = ownUserFunctions();
+    registry.functions[name] = func;
+    registry.constants[name] = isConst;
 }
 void Parser::registerFunctions(const std::unordered_map<std::string, Function>& functions, bool isConst) {
+    FunctionRegistry& registry = ownUserFunctions();
     for (const auto& [name, func] : functions) {
-        userFunctions[name] = func;
-        userFunctionsConst[name] = isConst;
+        registry.functions[name] = func;
+        registry.constants[name] = isConst;
     }
 }
 void Parser::unregisterFunction(const std::string& name) {
-    userFunctions.erase(name);
-    userFunctionsConst.erase(name);
+    FunctionRegistry& registry = ownUserFunctions();
+    registry.functions.erase(name);
+    registry.constants.erase(name);
 }
 bool Parser::hasFunction(const std::string& name) const {
-    return userFunctions.find(name) != userFunctions.end();
+    return userFunctions->functions.find(name) != userFunctions->functions.end();
 }
 
 void Parser::variableUpdateListener(Function func) {
@@ -6148,9 +6129,9 @@ void Parser::triggerVariableUpdate(const std::string& name, const Value& value)
     }
 }
 
-ASTNode Parser::typeDeclarationNode(std::string typeDecl, size_t pos) {
+ASTNode Parser::typeDeclarationNode(const std::string& typeDecl, size_t pos) {
     ASTNode node("TYPE_CHECK", "", pos);
-    node.typeDeclaration = Utility::typeDeclaration2dataType(typeDecl, Utility::position(pos, input));
+    node.typeDeclaration = Utility::typeDeclaration2dataType(typeDecl, sourcePosition(pos));
     return node;
 }
 std::vector<Value> Parser::parseLambda(bool doExecute, size_t pos) {
@@ -6159,80 +6140,80 @@ std::vector<Value> Parser::parseLambda(bool doExecute, size_t pos) {
     std::vector<std::string> renames;
     std::vector<Value> output;
 
-    if (match("[")) {
+    if (match(TokenKind::LEFT_BRACKET)) {
         advance();
-        while ((match("identifier") || match("string")) && !isEnd()) {
-            names.push_back(currentToken().value);
+        while ((match(TokenKind::IDENTIFIER) || match(TokenKind::STRING)) && !isEnd()) {
+            names.push_back(currentToken().value.str());
             Value var = parseExpression(doExecute, true);
-            if (match(":") && !(position + 1 >= tokens.size())) {
+            if (match(TokenKind::COLON) && !(position + 1 >= tokens.size())) {
                 advance();
-                std::string typeDecl = currentToken().value;
+                std::string typeDecl = currentToken().value.str();
                 ASTNode typeNode = typeDeclarationNode(typeDecl, pos);
-                var = applyTypeDeclaration(var, typeNode);
+                var = applyTypeDeclaration(std::move(var), typeNode);
             }
-            vars.push_back(var);
-            while ((match(",") || match(";")) && !isEnd()) {
+            vars.push_back(std::move(var));
+            while ((match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) && !isEnd()) {
                 advance();
             }
         }
         if (isEnd()) {
-            throw std::runtime_error("Unclosed lambda at " + Utility::position(pos, input) + ".");
+            throw std::runtime_error("Unclosed lambda at " + sourcePosition(pos) + ".");
         }
-        if (!match("]")) {
-            throw std::runtime_error("Expected ']' to close lambda at " + Utility::position(pos, input) + ".");
+        if (!match(TokenKind::RIGHT_BRACKET)) {
+            throw std::runtime_error("Expected ']' to close lambda at " + sourcePosition(pos) + ".");
         }
         advance();
-        if (match("keyword", "as") || match(":")) {
+        if (match(TokenKind::KEYWORD, "as") || match(TokenKind::COLON)) {
             advance();
             if (isEnd()) {
-                throw std::runtime_error("Expected '[' at " + Utility::position(pos, input) + ".");
-            } else if (match("[")) {
+                throw std::runtime_error("Expected '[' at " + sourcePosition(pos) + ".");
+            } else if (match(TokenKind::LEFT_BRACKET)) {
                 advance();
-                while (!match("]") && !isEnd()) {
-                    renames.push_back(currentToken().value);
+                while (!match(TokenKind::RIGHT_BRACKET) && !isEnd()) {
+                    renames.push_back(currentToken().value.str());
                     advance();
-                    while ((match(",") || match(";")) && !isEnd()) {
+                    while ((match(TokenKind::COMMA) || match(TokenKind::SEMICOLON)) && !isEnd()) {
                         advance();
                     }
                 }
                 if (isEnd()) {
-                    throw std::runtime_error("Unclosed lambda at " + Utility::position(pos, input) + ".");
+                    throw std::runtime_error("Unclosed lambda at " + sourcePosition(pos) + ".");
                 }
-                if (!match("]")) {
-                    throw std::runtime_error("Expected ']' at " + Utility::position(pos, input) + ".");
+                if (!match(TokenKind::RIGHT_BRACKET)) {
+                    throw std::runtime_error("Expected ']' at " + sourcePosition(pos) + ".");
                 }
                 advance();
             } else {
-                Value arr = parseExpression(doExecute);
+                const Value arr = parseExpression(doExecute);
                 if (arr.type != DataType::JSON_ARRAY) {
-                    throw std::runtime_error("Expected array at " + Utility::position(pos, input) + ".");
+                    throw std::runtime_error("Expected array at " + sourcePosition(pos) + ".");
                 }
-                for (Value arrItem : arr.array_elements) {
+                for (const Value& arrItem : arr.array_elements()) {
                     renames.push_back(arrItem.toString());
                 }
             }
         }
-    } else if (match("identifier") || match("string")) {
-        names.push_back(currentToken().value);
+    } else if (match(TokenKind::IDENTIFIER) || match(TokenKind::STRING)) {
+        names.push_back(currentToken().value.str());
         Value var = parseExpression(doExecute, true);
-        if (match(":") && !(position + 1 >= tokens.size())) {
+        if (match(TokenKind::COLON) && !(position + 1 >= tokens.size())) {
             advance();
-            std::string typeDecl = currentToken().value;
+            std::string typeDecl = currentToken().value.str();
             ASTNode typeNode = typeDeclarationNode(typeDecl, pos);
-            var = applyTypeDeclaration(var, typeNode);
+            var = applyTypeDeclaration(std::move(var), typeNode);
         }
-        vars.push_back(var);
-        if ((match("keyword", "as") || match(":")) && (peekToken().type == "identifier" || peekToken().type == "string")) {
+        vars.push_back(std::move(var));
+        if ((match(TokenKind::KEYWORD, "as") || match(TokenKind::COLON)) && (peekToken().kind == TokenKind::IDENTIFIER || peekToken().kind == TokenKind::STRING)) {
             advance();
-            renames.push_back(currentToken().value);
+            renames.push_back(currentToken().value.str());
             advance();
         }
-    } else if (match("keyword", "lambda")) {
+    } else if (match(TokenKind::KEYWORD, "lambda")) {
         advance();
-        Value obj = parseExpression(doExecute);
+        const Value obj = parseExpression(doExecute);
         switch (obj.type) {
             case DataType::JSON_ARRAY: {
-                for (Value arrItem : obj.array_elements) {
+                for (const Value& arrItem : obj.array_elements()) {
                     names.push_back(arrItem.name);
                     vars.push_back(arrItem);
                 }
@@ -6240,14 +6221,14 @@ std::vector<Value> Parser::parseLambda(bool doExecute, size_t pos) {
             }
             case DataType::JSON_OBJECT:
             case DataType::JUSTC_OBJECT: {
-                for (const auto& [key, value] : obj.properties) {
+                for (const auto& [key, value] : obj.properties()) {
                     names.push_back(key);
                     vars.push_back(value);
                 }
                 break;
             }
             default:
-                throw std::runtime_error("Expected array or object for lambda at " + Utility::position(pos, input) + ".");
+                throw std::runtime_error("Expected array or object for lambda at " + sourcePosition(pos) + ".");
         }
     }
 
@@ -6264,13 +6245,12 @@ std::vector<Value> Parser::parseLambda(bool doExecute, size_t pos) {
 }
 
 void Parser::clearUserFunctions() {
-    userFunctions.clear();
-    userFunctionsConst.clear();
+    userFunctions = std::make_shared<FunctionRegistry>();
 }
 
 void Parser::registerGlobal(const std::string& name, const Value& value, bool isConst, bool isJUSTC) {
     if (isGlobalConst(name) && !(!isGlobalJUSTC(name) && !isJUSTC)) {
-        if (isJUSTC) throw std::runtime_error("Assignment to global constant variable \"" + name + "\" at " + Utility::position(currentToken().start, input) + ".");
+        if (isJUSTC) throw std::runtime_error("Assignment to global constant variable \"" + name + "\" at " + sourcePosition(currentToken().start) + ".");
         else throw std::runtime_error("Attempt to re-register global constant variable \"" + name + "\".");
     }
     setGlobal(name, value, isConst, isJUSTC);
@@ -6299,6 +6279,26 @@ std::string Parser::getCurrentScopeName() const {
     }
     return "scope_" + std::to_string(currentScope);
 }
+namespace {
+    // nodes parked by exitScope() are handed back out here, so scopes coming and going
+    // reuse their tables instead of taking new arena memory each time
+    template<class Table>
+    void reuseScope(Table& table, std::vector<typename Table::node_type>& spare, uint64_t scope) {
+        if (!spare.empty()) {
+            typename Table::node_type node = std::move(spare.back());
+            spare.pop_back();
+            node.key() = scope;
+            node.mapped().clear();
+            if (table.insert(std::move(node)).inserted) return;
+        }
+        table[scope].clear();
+    }
+    template<class Table>
+    void parkScope(Table& table, std::vector<typename Table::node_type>& spare, uint64_t scope) {
+        typename Table::node_type node = table.extract(scope);
+        if (!node.empty()) spare.push_back(std::move(node));
+    }
+}
 void Parser::enterScope() {
     static uint64_t scopeIdCounter = 0;
     uint64_t newScope = ++scopeIdCounter;
@@ -6306,13 +6306,13 @@ void Parser::enterScope() {
     scopeStack.push_back(currentScope);
     currentScope = newScope;
     
-    localScopes[newScope] = std::unordered_map<std::string, Value>();
-    localConstVars[newScope] = std::unordered_map<std::string, bool>();
+    reuseScope(localScopes, spareScopes, newScope);
+    reuseScope(localConstVars, spareConstVars, newScope);
 }
 void Parser::exitScope() {
     if (!scopeStack.empty()) {
-        localScopes.erase(currentScope);
-        localConstVars.erase(currentScope);
+        parkScope(localScopes, spareScopes, currentScope);
+        parkScope(localConstVars, spareConstVars, currentScope);
         
         currentScope = scopeStack.back();
         scopeStack.pop_back();
@@ -6330,7 +6330,7 @@ Value Parser::getLocal(uint64_t scope, const std::string& name) const {
     if (it != localScopes.end()) {
         auto varIt = it->second.find(name);
         if (varIt != it->second.end()) {
-            Value var = varIt->second;
+            Value var = joined(varIt->second);
             var.isVariable = true;
             var.variable = name;
             var.varType = VariableType::LOCAL;
@@ -6378,6 +6378,7 @@ Value Parser::resolveVariableValueWithScopes(const std::string& varName, const b
     
     auto it = variables.find(varName);
     if (it != variables.end() && it->second.type != DataType::UNKNOWN) {
+        if (it->second.response()) it->second = joined(it->second);
         Value var = it->second;
         var.isVariable = true;
         var.variable = varName;
@@ -6413,15 +6414,15 @@ std::string Parser::renderJSX(const Value& jsxElement) {
     }
     
     std::string type = jsxElement.getProperty("type", Value::createString("")).toString();
-    Value props = jsxElement.getProperty("props", Value::createNull());
-    Value children = jsxElement.getProperty("children", Value::createNull());
+    const Value props = jsxElement.getProperty("props", Value::createNull());
+    const Value children = jsxElement.getProperty("children", Value::createNull());
     
     if (type.empty()) return "";
     
     std::string result = "<" + type;
     
     if (props.type == DataType::JSON_OBJECT) {
-        for (const auto& [key, value] : props.properties) {
+        for (const auto& [key, value] : props.properties()) {
             if (key == "className" || key == "class") {
                 result += " class=\"" + value.toString() + "\"";
             } else if (key == "id") {
@@ -6430,7 +6431,7 @@ std::string Parser::renderJSX(const Value& jsxElement) {
                 if (value.type == DataType::JSON_OBJECT) {
                     result += " style=\"";
                     bool first = true;
-                    for (const auto& [prop, val] : value.properties) {
+                    for (const auto& [prop, val] : value.properties()) {
                         if (!first) result += ";";
                         first = false;
                         std::string cssProp = prop;
@@ -6482,7 +6483,7 @@ std::string Parser::renderJSX(const Value& jsxElement) {
     result += ">";
     
     if (children.type == DataType::JSON_ARRAY) {
-        for (const auto& child : children.array_elements) {
+        for (const auto& child : children.array_elements()) {
             switch (child.type) {
                 case DataType::STRING:
                     result += child.string_value;
@@ -6502,12 +6503,16 @@ std::string Parser::renderJSX(const Value& jsxElement) {
     return result;
 }
 
-ParseResult Parser::parseTokens(const std::vector<ParserToken>& tokens, bool doExecute, bool runAsync, const std::string& input, const bool allowJavaScript, const bool canAllowJS, const std::string scriptName, const std::string scriptType, const bool allowLuau, const bool canAllowLuau) {
+ParseResult Parser::parseTokens(std::vector<ParserToken> tokens, bool doExecute, bool runAsync, const std::string& input, const bool allowJavaScript, const bool canAllowJS, const std::string& scriptName, const std::string& scriptType, const bool allowLuau, const bool canAllowLuau) {
+    return parseTokens(std::move(tokens), doExecute, runAsync, std::make_shared<const std::string>(input), allowJavaScript, canAllowJS, scriptName, scriptType, allowLuau, canAllowLuau);
+}
+
+ParseResult Parser::parseTokens(std::vector<ParserToken> tokens, bool doExecute, bool runAsync, SourceBuffer source, const bool allowJavaScript, const bool canAllowJS, const std::string& scriptName, const std::string& scriptType, const bool allowLuau, const bool canAllowLuau) {
     #ifndef __EMSCRIPTEN__
     try {
     #endif
 
-        Parser parser(tokens, doExecute, runAsync, input, allowJavaScript, canAllowJS, scriptName, scriptType, allowLuau, canAllowLuau, false, nullptr, CharType::GRAPHEME);
+        Parser parser(std::move(tokens), doExecute, runAsync, std::move(source), allowJavaScript, canAllowJS, scriptName, scriptType, allowLuau, canAllowLuau, false, nullptr, CharType::GRAPHEME);
         return parser.parse(doExecute);
 
     #ifndef __EMSCRIPTEN__
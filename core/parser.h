@@ -30,13 +30,19 @@ SOFTWARE.
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <future>
+#include <mutex>
+#include <atomic>
 #include <cstdint>
 #include <variant>
 #include "lexer.h"
 #include "version.h"
+#include "threadpool.h"
+#include "arena.h"
 #include <functional>
 #include <cstring>
 #include <iomanip>
@@ -75,6 +81,10 @@ SOFTWARE.
 
 struct Value;
 class Parser;
+class LineIndex;
+struct Expression;
+
+using ExpressionPtr = std::shared_ptr<const Expression>;
 
 struct ObjectContext {
     std::shared_ptr<Parser> parser;
@@ -88,7 +98,7 @@ struct ObjectContext {
     std::unordered_map<std::string, std::shared_ptr<ObjectContext>> childObjects;
 };
 
-enum class DataType {
+enum class DataType : int8_t {
     JUSTC_OBJECT =  0,
     NUMBER       =  1,
     STRING       =  2,
@@ -188,35 +198,44 @@ enum class NumericType : uint8_t {
     CUINT64 = 18
 };
 
+// A typed number (int8 ... uint128, float128). The raw bits live in `data`, which is large enough
+// for every NumericType and only ever accessed through memcpy, so it needs no alignment and packs
+// next to Value's flags. Its double value is Value::number_value.
 struct NumericValue {
     NumericType type;
-    double value;
-    void* data;
+    unsigned char data[16];
     
-    NumericValue() : type(NumericType::NONE), value(0.0), data(nullptr) {}
+    NumericValue() : type(NumericType::NONE), data{} {}
     
     template<typename T>
-    NumericValue(T val) : type(NumericType::NONE), value(0.0), data(nullptr) {
+    NumericValue(T val) : NumericValue() {
         set(val);
     }
     
     template<typename T>
     void set(T val) {
-        data = malloc(sizeof(T));
-        if (data) {
-            memcpy(data, &val, sizeof(T));
-            value = static_cast<double>(val);
-            setType<T>();
-        }
+        store(val);
+        setType<T>();
+    }
+
+    // the bits only, for callers that pick the NumericType themselves
+    template<typename T>
+    void store(T val) {
+        static_assert(sizeof(T) <= sizeof(data), "numeric type does not fit NumericValue::data");
+        memcpy(data, &val, sizeof(T));
     }
     
     template<typename T>
     T get() const {
-        if (!data) return T{0};
+        if (type == NumericType::NONE) return T{0};
         T result;
         memcpy(&result, data, sizeof(T));
         return result;
     }
+
+    explicit operator bool() const {
+        return type != NumericType::NONE;
+    }
     
     template<typename T>
     void setType() {
@@ -241,46 +260,6 @@ struct NumericValue {
         else type = NumericType::FLOAT64;
     }
     
-    ~NumericValue() {
-        if (data) {
-            free(data);
-            data = nullptr;
-        }
-    }
-    
-    NumericValue(const NumericValue& other) {
-        type = other.type;
-        value = other.value;
-        if (other.data) {
-            size_t size = getTypeSize(type);
-            data = malloc(size);
-            if (data) {
-                memcpy(data, other.data, size);
-            }
-        } else {
-            data = nullptr;
-        }
-    }
-    
-    NumericValue& operator=(const NumericValue& other) {
-        if (this != &other) {
-            if (data) {
-                free(data);
-                data = nullptr;
-            }
-            type = other.type;
-            value = other.value;
-            if (other.data) {
-                size_t size = getTypeSize(type);
-                data = malloc(size);
-                if (data) {
-                    memcpy(data, other.data, size);
-                }
-            }
-        }
-        return *this;
-    }
-    
     static size_t getTypeSize(NumericType type) {
         switch (type) {
             case NumericType::FLOAT32: return sizeof(float);
@@ -306,6 +285,13 @@ struct NumericValue {
     }
 };
 
+// A function body lexed once and shared by every copy of the FUNCTION value that owns it.
+struct CompiledFunction {
+    SourceBuffer source;
+    std::vector<ParserToken> tokens;
+    std::unordered_set<std::string> identifiers;
+};
+
 struct FunctionInfo {
     std::string code;
     std::vector<std::string> paramNames;
@@ -313,6 +299,7 @@ struct FunctionInfo {
     std::vector<struct Value> defaultValues;
     bool hasVarArgs;
     bool isIsolated;
+    mutable std::shared_ptr<const CompiledFunction> compiled;
 
     FunctionInfo() : hasVarArgs(false), isIsolated(false) {}
 
@@ -349,39 +336,81 @@ enum class VariableType : uint8_t {
     LOCAL = 2
 };
 
+// Members that only objects, arrays, functions and binary data use. They live out of line so that
+// numbers, strings and booleans - most values - stay small and cheap to copy.
+struct ValueData {
+    std::shared_ptr<void> complex_value;
+    std::unordered_map<std::string, Value> object_value;
+    std::vector<unsigned char> binary_data;
+    std::shared_ptr<ObjectContext> object_context;
+    std::unordered_map<std::string, Value> properties;
+    std::vector<Value> array_elements;
+    FunctionInfo function_info;
+    std::shared_ptr<ObjectContext> closure_context;
+    // HTTP response that is still being fetched, joined on the first read of the value
+    std::shared_ptr<Deferred<Value>> response;
+};
+
+// The ValueData of one Value. Copies of a Value share it, so passing and returning objects,
+// arrays and functions is O(1); getMutable() gives the Value its own copy before the first
+// write while the payload is still shared (copy-on-write).
+class ValueDataPtr {
+public:
+    ValueDataPtr() : shared(nullptr) {}
+    ValueDataPtr(const ValueDataPtr& other);
+    ValueDataPtr(ValueDataPtr&& other) noexcept : shared(other.shared) {
+        other.shared = nullptr;
+    }
+    ~ValueDataPtr();
+
+    ValueDataPtr& operator=(const ValueDataPtr& other);
+    ValueDataPtr& operator=(ValueDataPtr&& other) noexcept;
+
+    const ValueData& get() const;
+    ValueData& getMutable();
+
+private:
+    struct Shared;
+    Shared* shared;
+
+    void release();
+};
+
 struct Value {
     DataType type;
+    bool isVariable;
+    VariableType varType;
+    bool isConst;
+    bool native;
+    DataType object_type;
+    NumericValue numeric_data;
 
     union {
         double number_value;
         bool boolean_value;
     };
     std::string string_value;
-    std::shared_ptr<void> complex_value;
     std::string name;
-    std::unordered_map<std::string, Value> object_value;
-    std::vector<unsigned char> binary_data;
-
-    bool isVariable;
     std::string variable;
-    VariableType varType;
-    bool isConst;
 
-    std::shared_ptr<ObjectContext> object_context;
-    std::unordered_map<std::string, Value> properties;
-    std::vector<Value> array_elements;
-    DataType object_type;
+    ValueDataPtr payload;
 
-    FunctionInfo function_info;
-    std::shared_ptr<ObjectContext> closure_context;
+    Value() : type(DataType::UNKNOWN), isVariable(false), varType(VariableType::VARIABLE), isConst(false), native(false), object_type(DataType::UNKNOWN), number_value(0), name("unknown") {}
+    Value(DataType t) : type(t), isVariable(false), varType(VariableType::VARIABLE), isConst(false), native(false), object_type(DataType::UNKNOWN), number_value(0), name(dataTypeToString(t)) {}
+    Value(DataType t, std::string s) : type(t), isVariable(false), varType(VariableType::VARIABLE), isConst(false), native(false), object_type(DataType::UNKNOWN), string_value(std::move(s)), name(dataTypeToString(t)) {}
 
-    bool native;
-    
-    std::shared_ptr<NumericValue> numeric_data;
+    const std::shared_ptr<void>& complex_value() const { return payload.get().complex_value; }
+    const std::unordered_map<std::string, Value>& object_value() const { return payload.get().object_value; }
+    const std::vector<unsigned char>& binary_data() const { return payload.get().binary_data; }
+    const std::shared_ptr<ObjectContext>& object_context() const { return payload.get().object_context; }
+    const std::unordered_map<std::string, Value>& properties() const { return payload.get().properties; }
+    const std::vector<Value>& array_elements() const { return payload.get().array_elements; }
+    const FunctionInfo& function_info() const { return payload.get().function_info; }
+    const std::shared_ptr<ObjectContext>& closure_context() const { return payload.get().closure_context; }
+    const std::shared_ptr<Deferred<Value>>& response() const { return payload.get().response; }
 
-    Value() : type(DataType::UNKNOWN), number_value(0), name("unknown"), object_type(DataType::UNKNOWN), native(false), isVariable(false), varType(VariableType::VARIABLE) {}
-    Value(DataType t) : type(t), number_value(0), name(dataTypeToString(t)), object_type(DataType::UNKNOWN), native(false), isVariable(false), varType(VariableType::VARIABLE) {}
-    Value(DataType t, std::string s) : type(t), string_value(s), name(dataTypeToString(t)), object_type(DataType::UNKNOWN), native(false), isVariable(false), varType(VariableType::VARIABLE) {}
+    // detaches a shared payload, so take references into it only after copying this value
+    ValueData& mutableData() { return payload.getMutable(); }
 
     std::string toString() const;
     std::string toIdentifier() const;
@@ -401,28 +430,24 @@ struct Value {
                type == DataType::JSON_OBJECT ||
                type == DataType::JSON_ARRAY;
     }
+    // detaches a shared payload only when there is a property to hand out
     Value* getProperty(const std::string& name) {
-        if (properties.find(name) != properties.end()) {
-            return &properties[name];
+        const auto& props = payload.get().properties;
+        if (props.find(name) == props.end()) {
+            return nullptr;
         }
-        return nullptr;
+        return &mutableData().properties.find(name)->second;
     }
     Value* getArrayElement(size_t index) {
-        if (type == DataType::JSON_ARRAY && index < array_elements.size()) {
-            return &array_elements[index];
+        if (type == DataType::JSON_ARRAY && index < payload.get().array_elements.size()) {
+            return &mutableData().array_elements[index];
         }
         return nullptr;
     }
 
-    Value getProperty(const std::string& name, Value placeholder) {
-        if (properties.find(name) != properties.end()) {
-            return properties[name];
-        }
-        return placeholder;
-    }
     Value getProperty(const std::string& name, Value placeholder) const {
-        auto it = properties.find(name);
-        if (it != properties.end()) {
+        auto it = properties().find(name);
+        if (it != properties().end()) {
             return it->second;
         }
         return placeholder;
@@ -462,22 +487,19 @@ struct Value {
     template<typename T>
     T getNumericValue() const {
         if (numeric_data) {
-            return numeric_data->get<T>();
+            return numeric_data.get<T>();
         }
         return static_cast<T>(number_value);
     }
     
     NumericType getNumericType() const {
         if (numeric_data) {
-            return numeric_data->type;
+            return numeric_data.type;
         }
         return NumericType::FLOAT64;
     }
     
     double toDouble() const {
-        if (numeric_data) {
-            return numeric_data->value;
-        }
         return number_value;
     }
     
@@ -507,16 +529,20 @@ struct Value {
                 break;
             case DataType::JSON_OBJECT:
             case DataType::JUSTC_OBJECT:
-                archive(properties);
+                if constexpr (Archive::is_loading::value) archive(mutableData().properties);
+                else archive(properties());
                 break;
             case DataType::JSON_ARRAY:
-                archive(array_elements);
+                if constexpr (Archive::is_loading::value) archive(mutableData().array_elements);
+                else archive(array_elements());
                 break;
             case DataType::FUNCTION:
-                archive(name, string_value, function_info);
+                if constexpr (Archive::is_loading::value) archive(name, string_value, mutableData().function_info);
+                else archive(name, string_value, function_info());
                 break;
             case DataType::BINARY_DATA:
-                archive(binary_data);
+                if constexpr (Archive::is_loading::value) archive(mutableData().binary_data);
+                else archive(binary_data());
                 break;
             default:
                 break;
@@ -524,6 +550,61 @@ struct Value {
     }
 };
 
+struct ValueDataPtr::Shared {
+    std::atomic<size_t> references;
+    ValueData data;
+
+    Shared() : references(1) {}
+    explicit Shared(const ValueData& data) : references(1), data(data) {}
+};
+
+inline ValueDataPtr::ValueDataPtr(const ValueDataPtr& other) : shared(other.shared) {
+    if (shared) shared->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline ValueDataPtr::~ValueDataPtr() {
+    release();
+}
+
+inline ValueDataPtr& ValueDataPtr::operator=(const ValueDataPtr& other) {
+    if (shared != other.shared) {
+        release();
+        shared = other.shared;
+        if (shared) shared->references.fetch_add(1, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+inline ValueDataPtr& ValueDataPtr::operator=(ValueDataPtr&& other) noexcept {
+    if (this != &other) {
+        release();
+        shared = other.shared;
+        other.shared = nullptr;
+    }
+    return *this;
+}
+
+inline const ValueData& ValueDataPtr::get() const {
+    static const ValueData empty;
+    return shared ? shared->data : empty;
+}
+
+inline ValueData& ValueDataPtr::getMutable() {
+    if (!shared) {
+        shared = new Shared();
+    } else if (shared->references.load(std::memory_order_acquire) > 1) {
+        Shared* copy = new Shared(shared->data);
+        release();
+        shared = copy;
+    }
+    return shared->data;
+}
+
+inline void ValueDataPtr::release() {
+    if (shared && shared->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete shared;
+    shared = nullptr;
+}
+
 struct LogEntry {
     std::string type;
     std::string message;
@@ -590,11 +671,81 @@ struct Mutated {
     bool applied = false;
 
     Mutated() : value(), startPos(0), applied(false) {}
-    Mutated(Value v, size_t p) : value(v), startPos(p), applied(false) {}
+    Mutated(Value v, size_t p) : value(std::move(v)), startPos(p), applied(false) {}
 };
 
 using Function = std::function<Value(const std::vector<Value>&)>;
 
+// Builtins executeFunction() can dispatch to; RuntimeTables::builtinFunctions maps their names here.
+enum class Builtin {
+    TIME, MATH_PI, BACKSLASH, VERSION,
+    MATH_E, MATH_LN2, MATH_LN10, MATH_SQRT2, MATH_SQRT1_2, MATH_LOG2E, MATH_LOG10E,
+
+    VALUEOF, STRING, LINK, BINARY, OCTAL, HEXADECIMAL, TYPEID, TYPEOF, ECHO, NUMBER, JSON, HTTP,
+    JUSTC, FILE, SIZE, ENV, CONFIG, JAVASCRIPT_IS_ALLOWED, LUAU_IS_ALLOWED,
+
+    BINARY_TO_TEXT, BINARY_FROM_TEXT, BINARY_TO_DATA_URL, BINARY_FROM_DATA_URL, BINARY_DATA,
+    MATH_ABS, MATH_ACOS, MATH_ASIN, MATH_ATAN, MATH_ATAN2, MATH_CEIL, MATH_COS, MATH_CLAMP,
+    MATH_CUBE, MATH_DOUBLE, MATH_EXP, MATH_FACTORIAL, MATH_FLOOR, MATH_HYPOT, MATH_IS_PRIME,
+    MATH_LERP, MATH_LOG, MATH_LOG10, MATH_MAX, MATH_MIN, MATH_POW, MATH_RANDOM, MATH_ROUND,
+    MATH_SIGN, MATH_SIN, MATH_SQRT, MATH_SQUARE, MATH_TAN, MATH_TO_DEGREES, MATH_TO_RADIANS,
+    PARSE_NUMBER,
+
+    STRING_REVERSE, STRING_GRAPHEME_REVERSE, STRING_CODEPOINT_REVERSE, STRING_BYTE_REVERSE,
+    STRING_TRIM, STRING_REPEAT,
+    STRING_SLICE, STRING_GRAPHEME_SLICE, STRING_CODEPOINT_SLICE, STRING_BYTE_SLICE,
+    STRING_STARTS_WITH, STRING_ENDS_WITH, STRING_SPLIT, STRING_LOWER, STRING_UPPER,
+    STRING_NORMALIZE_NFC, STRING_NORMALIZE_NFD, STRING_NORMALIZE_NFKC, STRING_NORMALIZE_NFKD,
+    STRING_LENGTH, STRING_GRAPHEME_LENGTH, STRING_CODEPOINT_LENGTH, STRING_BYTE_LENGTH,
+    STRING_EQUALS_IGNORE_CASE, STRING_IS_WHITESPACE,
+
+    JUSTC_PARSE, JUSTC_EXECUTE, JSON_PARSE, JAVASCRIPT, LUAU, JUSTO_PARSE, JUSTO_STRINGIFY,
+    JUSTC_STRINGIFY, LUAU_COMPILE,
+
+    ARRAY_JOIN, ARRAY_INCLUDES, ARRAY_INDEX_OF, ARRAY_LAST_INDEX_OF, ARRAY_REVERSE,
+    ARRAY_FOR_EACH, ARRAY_FILTER,
+
+    RENDER_JSX
+};
+
+struct BuiltinFunction {
+    Builtin id;
+    size_t minArgs;  // called with fewer arguments -> "Expected at least one argument"
+    bool wrapErrors; // errors get the call position appended
+    bool pure;       // result depends only on the arguments, calls with literal arguments are folded
+};
+
+// Tables every Parser reads and none modifies; built once per process.
+struct RuntimeTables {
+    std::unordered_map<DataType, std::unordered_map<std::string, std::string>> typeMethods;
+    std::unordered_set<std::string> builtins;
+    std::unordered_set<std::string> cpptypes;
+    std::unordered_set<std::string> cppnumbers;
+    std::unordered_map<std::string, Value> builtinObjects;
+    std::unordered_map<std::string, BuiltinFunction> builtinFunctions;
+
+    static const RuntimeTables& getInstance();
+};
+
+// User functions registered on a parser. Child parsers share their parent's registry until one of them writes to it.
+struct FunctionRegistry {
+    std::unordered_map<std::string, Function> functions;
+    std::unordered_map<std::string, bool> constants;
+};
+
+// Expressions made only of literals, pure operators and pure builtin calls, keyed by the source offset of
+// their first token. Parsers of the same source share one table, so a loop or function body re-parsed on
+// every iteration or call computes each of them once.
+struct FoldedConstant {
+    size_t tokens;    // 0 - the expression starting here is not constant
+    size_t lastStart; // source offset of its last token
+    bool calls;       // folded from a builtin call, only valid while calls are executed
+    std::shared_ptr<const Value> value;
+};
+struct ConstantFolds {
+    std::unordered_map<size_t, FoldedConstant> expressions;
+};
+
 class Parser {
 private:
     bool doExecute;
@@ -602,12 +753,36 @@ private:
     std::vector<ParserToken> tokens;
     std::vector<ASTNode> ast;
     size_t position;
-    std::string input;
+    SourceBuffer source;
+    const std::string& input;
+    mutable std::shared_ptr<const LineIndex> lines;
+    const LineIndex& lineIndex() const;
+    std::string sourcePosition(size_t pos) const;
 
     std::unordered_map<std::string, Value> variables;
     std::unordered_map<std::string, Mutated> mutated;
     std::unordered_map<std::string, bool> constVars;
     std::unordered_map<std::string, std::vector<std::string>> dependencies;
+    std::vector<std::string> evaluationOrder;
+    // backs the per-parse tables below; rewind() releases it for the next run
+    ParseArena arena;
+    void releaseArena();
+    // ast indices of each name's VARIABLE_DECLARATION nodes, caught up with ast on lookup
+    std::pmr::unordered_map<std::string, std::pmr::vector<size_t>> declarations{arena.get()};
+    size_t indexedNodes = 0;
+    void indexDeclarations();
+    const std::pmr::vector<size_t>* findDeclarations(const std::string& name);
+
+    // evaluateASTNode() results by ast index; an entry is reused until an assignment or
+    // mutation bumps the generation or more nodes are parsed
+    struct DeclarationMemo {
+        uint64_t generation;
+        size_t nodes;
+        Value value;
+    };
+    std::pmr::unordered_map<size_t, DeclarationMemo> declarationMemo{arena.get()};
+    uint64_t generation = 0;
+    Value evaluateDeclaration(size_t index);
     std::vector<std::string> outputVariables;
     std::vector<std::string> outputNames;
     Value returnValue;
@@ -629,22 +804,25 @@ private:
 
     bool asJSON;
     bool isJSONArray;
-    std::string endOfScript;
+    TokenKind endOfScript;
     std::vector<Value> arrayItems;
 
     bool isFunction;
 
     CharType chartype;
 
-    std::unordered_map<std::string, Function> userFunctions;
-    std::unordered_map<std::string, bool> userFunctionsConst;
+    std::shared_ptr<FunctionRegistry> userFunctions;
+    FunctionRegistry& ownUserFunctions();
+    std::shared_ptr<ConstantFolds> constantFolds;
+    bool foldedConstant(bool ignoreColon, Value& result);
+    bool canFoldBuiltinCalls();
     std::vector<Function> variableUpdateListeners;
 
-    ParserToken currentToken() const;
-    ParserToken peekToken(size_t offset = 1) const;
+    const ParserToken& currentToken() const;
+    const ParserToken& peekToken(size_t offset = 1) const;
     void advance();
-    bool match(const std::string& type) const;
-    bool match(const std::string& type, const std::string& value) const;
+    bool match(TokenKind kind) const;
+    bool match(TokenKind kind, const std::string& value) const;
     bool isEnd() const;
     void skipCommas();
 
@@ -657,13 +835,16 @@ private:
 
     std::vector<std::vector<std::string>> importLogs;
 
-    std::unordered_map<uint64_t, std::unordered_map<std::string, Value>> localScopes;
-    std::unordered_map<uint64_t, std::unordered_map<std::string, bool>> localConstVars;
+    std::pmr::unordered_map<uint64_t, std::pmr::unordered_map<std::string, Value>> localScopes{arena.get()};
+    std::pmr::unordered_map<uint64_t, std::pmr::unordered_map<std::string, bool>> localConstVars{arena.get()};
+    // tables of exited scopes for enterScope() to reuse; emptied before the arena is released
+    std::vector<decltype(localScopes)::node_type> spareScopes;
+    std::vector<decltype(localConstVars)::node_type> spareConstVars;
     std::vector<uint64_t> scopeStack;
     uint64_t currentScope;
     uint64_t rootIndex;
     
-    std::unordered_map<DataType, std::unordered_map<std::string, std::string>> typeMethods;
+    const RuntimeTables& tables;
 
     // logs
     void addLog(const std::string& type, const std::string& message, size_t position = 0);
@@ -678,33 +859,19 @@ private:
     Value parseExpression(bool doExecute, bool identifierMode = false, bool doFunctionCall = true, bool ignoreColon = false);
     Value parsePrimary(bool doExecute, bool doFunctionCall = true);
     Value parseConditional(bool doExecute, bool identifierMode = false, bool doFunctionCall = true, bool ignoreColon = false);
-    Value parseBitwiseOR(bool doExecute, bool identifierMode = false, bool doFunctionCall = true, bool ignoreColon = false);
-    Value parseBitwiseXOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon);
-    Value parseBitwiseAND(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon);
-    Value parseBitwiseSHIFT(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon);
-    Value parseBitwiseNOT(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon);
-    Value parsePipelineOrMethodCall(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon);
-    Value parseElvisOrNullCoalescing(bool doExecute, bool identifierMode, bool doFunctionCall = true, bool ignoreColon = false);
-    Value parseLogicalOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseLogicalXOR(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseLogicalAND(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseLogicalIMPLY(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseEquality(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseComparison(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseTerm(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseFactor(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parsePower(bool doExecute, bool identifierMode, bool doFunctionCall, bool ignoreColon = false);
-    Value parseUnary(bool doExecute, bool identifierMode = false, bool doFunctionCall = true, bool ignoreColon = false);
+    Value parseBinary(size_t minLevel, bool doExecute, bool identifierMode = false, bool doFunctionCall = true, bool ignoreColon = false);
+    bool isOperatorStart(bool identifierMode) const;
     Value parseFunctionCall(bool doExecute, bool doFunctionCall = true);
     Value parseSpaceCall(bool doExecute, bool doFunctionCall = true);
     std::vector<Value> parseLambda(bool doExecute, size_t pos);
 
-    ASTNode typeDeclarationNode(std::string typeDecl, size_t pos);
+    ASTNode typeDeclarationNode(const std::string& typeDecl, size_t pos);
 
     Value parseJustcObject(bool doExecute);
     Value parseJsonObject(bool doExecute);
     Value parseJsonArray(bool doExecute);
     Value parseObjectPropertyAccess(bool doExecute);
+    Value resolvePropertyAccess(const std::vector<std::variant<std::string, size_t>>& accessChain, Value currentValue, bool call, const std::function<std::vector<Value>()>& arguments, bool doExecute);
     std::shared_ptr<ObjectContext> createObjectContext(bool inheritFromParent);
 
     Value accessProperty(const Value& obj, const std::string& propName);
@@ -712,11 +879,10 @@ private:
     std::vector<Value> parseArguments(bool doExecute);
 
     std::string readVariableName();
-    void checkVariableNameAvailable(std::string name);
+    void checkVariableNameAvailable(const std::string& name);
 
     ASTNode parseStatement(bool doExecute);
     bool CanIgnoreNoAssigmentOperator();
-    Value makeValue(Value value, bool b);
     ASTNode parseGlobal(bool doExecute, bool constant = false);
     ASTNode parseVariableDeclaration(bool doExecute, bool constant = false, bool local = false, bool global = false);
     ASTNode parseCommand(bool doExecute);
@@ -727,26 +893,26 @@ private:
     ASTNode parseImportCommand();
 
     Value executeFunction(const std::string& funcName, const std::vector<Value>& args, size_t startPos);
+    Value executeFunction(const std::string& funcName, const std::vector<Value>& args, size_t startPos, const BuiltinFunction* builtin);
+    const BuiltinFunction* findBuiltinFunction(const std::string& funcName) const;
+    Value callBuiltin(Builtin id, const std::string& funcName, const std::vector<Value>& args, size_t startPos);
+    static void registerBuiltinFunctions(std::unordered_map<std::string, BuiltinFunction>& functions);
     Value doubleDot(const Value& left, const Value& right);
     Value evaluateExpression(const Value& left, const std::string& op, const Value& right, bool doExecute);
     Value handleInequality(const Value& value);
     Value handleConditional(const Value& condition, const Value& thenVal, const Value& elseVal,
                            const std::string& thenOp, const std::string& elseOp);
+    bool conditionHolds(const Value& condition, const std::string& thenOp) const;
 
     void buildDependencyGraph();
-    bool detectCycles();
-    bool dfsCycleDetection(const std::string& node,
-                          std::unordered_map<std::string, bool>& visited,
-                          std::unordered_map<std::string, bool>& recStack,
-                          std::vector<std::string>& cyclePath);
 
     Value resolveVariableValue(const std::string& varName, const bool unknownIsString);
     void evaluateAllVariables();
-    void evaluateAllVariablesSync();
-    void evaluateAllVariablesAsync();
-    std::runtime_error typeDeclarationError(const DataType left, const DataType right, const ASTNode node);
-    Value applyTypeDeclaration(const Value value, const ASTNode node);
-    Value applyCPPTypeDeclaration(const Value value, const std::string& cpptype, const DataType typeDecl);
+    void applyMutations();
+    void evaluateVariable(const std::string& varName);
+    std::runtime_error typeDeclarationError(const DataType left, const DataType right, const ASTNode& node);
+    Value applyTypeDeclaration(Value value, const ASTNode& node);
+    Value applyCPPTypeDeclaration(Value value, const std::string& cpptype, const DataType typeDecl);
     Value evaluateASTNode(const ASTNode& node);
     void extractReferences(const Value& value, std::vector<std::string>& references);
 
@@ -762,7 +928,7 @@ private:
     __float128 parseToFloat128(const std::string& str);
     #endif
 
-    Value numberToValue(double num);
+    static Value numberToValue(double num);
     Value booleanToValue(bool b);
     Value linkToValue(const std::string& link);
     Value pathToValue(const std::string& path);
@@ -773,34 +939,39 @@ private:
     Value convertToDecimal(const Value& value);
 
     template<class Func>
-    auto executeAsyncIfEnabled(Func&& func) -> std::future<decltype(func())> {
-        typedef decltype(func()) ResultType;
-
+    auto executeAsyncIfEnabled(Func&& func) -> Deferred<decltype(func())> {
         if (runAsync) {
-    #ifdef __EMSCRIPTEN__
-            return std::async(std::launch::deferred, std::forward<Func>(func));
-    #else
-            return std::async(std::launch::async, std::forward<Func>(func));
-    #endif
-        } else {
-            ResultType result = func();
-            return std::async(std::launch::deferred, [result]() { return result; });
+            return ThreadPool::getInstance().defer(std::forward<Func>(func));
         }
+        return Deferred<decltype(func())>::ready(func());
     }
 
-    Value isolated(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context = nullptr, const std::string name = "auto", bool merge = false, bool silent = false);
-    Value shared(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string name = "auto", bool merge = true, bool silent = false);
+    Value isolated(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context = nullptr, const std::string& name = "auto", bool merge = false, bool silent = false);
+    Value shared(const std::string& code, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name = "auto", bool merge = true, bool silent = false);
+    Value isolated(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context = nullptr, const std::string& name = "auto", bool merge = false, bool silent = false);
+    Value shared(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, size_t startPos, const std::unordered_map<std::string, Value>* context, const std::string& name = "auto", bool merge = true, bool silent = false);
+    std::unique_ptr<Parser> createIsolatedParser(std::vector<ParserToken> code, SourceBuffer source, bool doExecute, const std::unordered_map<std::string, Value>* context, const std::string& name, bool merge);
+    void rewind(const std::vector<ParserToken>& code, const std::unordered_map<std::string, Value>* context);
+    void mergeIsolated(const ParseResult& result, size_t startPos, bool merge, const std::unordered_map<std::string, Value>* context, bool silent);
+    void mergeShared(const std::unordered_map<std::string, Value>& context);
 
     Value parseFunctionDeclaration(bool doExecute, std::string funcName = "anonymous", bool requireName = true);
+    std::shared_ptr<const CompiledFunction> compileFunction(const Value& function, size_t startPos);
+    void captureNames(const Value& function, std::unordered_set<std::string>& names, size_t startPos);
     Value emptyJUSTC();
 
     Value parseCondition(bool doExecute, bool wasIsolated = false);
-    Value i2v(Value fromIsolated);
-    std::string t2i(ParserToken toIsolated);
+    bool conditionHolds(const Expression& condition, bool doExecute, const std::unordered_map<std::string, Value>* context, size_t startPos);
+    Value i2v(const Value& fromIsolated);
+    std::string t2i(const ParserToken& toIsolated);
 
     // built-in
-    std::future<Value> functionHTTPAsync(size_t startPos, const std::string& method, const std::vector<Value>& args);
-    std::future<Value> functionFILEAsync(const std::vector<Value>& args);
+    Deferred<Value> functionHTTPAsync(size_t startPos, const std::string& method, const std::vector<Value>& args);
+    // token index right after the HTTP call that is the whole value of the declaration being parsed
+    size_t deferredResponseAt = std::string::npos;
+    size_t wholeResponseCall() const;
+    void joinResponses();
+    Deferred<Value> functionFILEAsync(const std::vector<Value>& args);
     Value functionVALUE(const std::vector<Value>& args);
     Value functionSTRING(const std::vector<Value>& args);
     Value functionLINK(const std::vector<Value>& args);
@@ -823,9 +994,9 @@ private:
 
     Value callFunction(const Value& function, const std::vector<Value>& args, size_t startPos, bool doExecute);
 
-    Value onExecDisabled(size_t startPos, std::string name);
-    void parseOutputCommandError(const std::string mode);
-    void parseScopeCommandError(const std::string scope);
+    Value onExecDisabled(size_t startPos, const std::string& name);
+    void parseOutputCommandError(const std::string& mode);
+    void parseScopeCommandError(const std::string& scope);
     void parseAllowCommandError();
 
     Value evaluateLengthOperator(const Value& value);
@@ -854,18 +1025,18 @@ private:
         return result;
     }
 
-    std::vector<std::string> builtins;
-    std::vector<std::string> cpptypes;
-    std::vector<std::string> cppnumbers;
-    void initializeBuiltIns();
-    void initializeCPPTypes();
+    std::unordered_map<std::string, Value> builtinValues;
+    std::unordered_map<std::string, bool> builtinConstVars;
     bool isBuiltinVariable(const std::string& name) const;
     bool isCPPType();
     bool isCPPNumber(const std::string& cpptype);
     void handleBuiltinVariableAssignment(const std::string& name, const Value& value, size_t startPos);
     void removeBuiltinVariablesFromOutput();
     void builtinObject(const std::string& name, std::unordered_map<std::string, Value> props);
-    Value builtinObjectFunction(const std::string& name);
+    void builtinObject(const std::string& name);
+    static Value builtinObjectValue(const std::string& name, std::unordered_map<std::string, Value> props);
+    static Value builtinObjectFunction(const std::string& name);
+    friend struct RuntimeTables;
 
     void updateCharType(const std::string& newType, size_t startPos);
 
@@ -883,7 +1054,25 @@ private:
     bool isLocalConst(uint64_t scope, const std::string& name) const;
     Value resolveVariableValueWithScopes(const std::string& varName, const bool unknownIsString);
 
-    void assign(const Value& var, const Value& val, const std::string& pos = ".");
+    void assign(const Value& var, const Value& val, size_t pos = std::string::npos);
+
+    // expression AST (expression.cpp)
+    ExpressionPtr compileRange(size_t first, size_t last);
+    ExpressionPtr compileExpression(bool ignoreColon = false);
+    struct Interpreting;
+    struct Compiling;
+    template<class Reader> typename Reader::Result readConditional(Reader& reader);
+    template<class Reader> typename Reader::Result readBinary(Reader& reader, size_t minLevel);
+    template<class Reader> typename Reader::Result readBitwiseNOT(Reader& reader);
+    template<class Reader> typename Reader::Result readUnary(Reader& reader);
+    ExpressionPtr compilePrimary();
+    ExpressionPtr compileCall();
+    ExpressionPtr compileMember();
+    bool compileArguments(std::vector<ExpressionPtr>& arguments);
+    ExpressionPtr foldConstant(ExpressionPtr expression);
+    Value evaluate(const Expression& expression, bool doExecute, const std::unordered_map<std::string, Value>* scope = nullptr);
+    Value evaluateNode(const Expression& expression, bool doExecute, const std::unordered_map<std::string, Value>* scope);
+    Value lookup(const std::string& name, bool unknownIsString, const std::unordered_map<std::string, Value>* scope);
     bool isInBracketedExpression();
 
     Value parseJSXElement(const std::string& jsxStr);
@@ -892,9 +1081,11 @@ private:
 public:
     static std::string getCurrentTimestamp();
     static Value stringToValue(const std::string& str);
-    Parser(const std::vector<ParserToken>& tokens, bool doExecute = true, bool runAsync = false, const std::string& input = "", const bool allowJavaScript = true, const bool canAllowJS = true, const std::string scriptName = "", const std::string scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true, const bool isFunction = false, const std::unordered_map<std::string, Value>* initialContext = nullptr, const CharType chartype = CharType::GRAPHEME);
+    Parser(std::vector<ParserToken> tokens, bool doExecute, bool runAsync, SourceBuffer source, const bool allowJavaScript = true, const bool canAllowJS = true, const std::string& scriptName = "", const std::string& scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true, const bool isFunction = false, const std::unordered_map<std::string, Value>* initialContext = nullptr, const CharType chartype = CharType::GRAPHEME);
+    Parser(std::vector<ParserToken> tokens, bool doExecute = true, bool runAsync = false, const std::string& input = "", const bool allowJavaScript = true, const bool canAllowJS = true, const std::string& scriptName = "", const std::string& scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true, const bool isFunction = false, const std::unordered_map<std::string, Value>* initialContext = nullptr, const CharType chartype = CharType::GRAPHEME);
     ParseResult parse(bool doExecute = true);
-    static ParseResult parseTokens(const std::vector<ParserToken>& tokens, bool doExecute = true, bool runAsync = false, const std::string& input = "", const bool allowJavaScript = true, const bool canAllowJS = true, const std::string scriptName = "", const std::string scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true);
+    static ParseResult parseTokens(std::vector<ParserToken> tokens, bool doExecute, bool runAsync, SourceBuffer source, const bool allowJavaScript = true, const bool canAllowJS = true, const std::string& scriptName = "", const std::string& scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true);
+    static ParseResult parseTokens(std::vector<ParserToken> tokens, bool doExecute = true, bool runAsync = false, const std::string& input = "", const bool allowJavaScript = true, const bool canAllowJS = true, const std::string& scriptName = "", const std::string& scriptType = "script", const bool allowLuau = true, const bool canAllowLuau = true);
 
     void registerFunction(const std::string& name, Function func, bool isConst = true);
     void registerFunctions(const std::unordered_map<std::string, Function>& functions, bool isConst = true);
@@ -50,6 +50,7 @@ bool parseJsonTokens(const char* tokensJson, std::vector<ParserToken>& parserTok
     while (pos < jsonStr.length()) {
         if (jsonStr[pos] == '{') {
             ParserToken token;
+            std::string type;
             size_t tokenEnd = jsonStr.find('}', pos);
             if (tokenEnd == std::string::npos) break;
 
@@ -60,7 +61,7 @@ bool parseJsonTokens(const char* tokensJson, std::vector<ParserToken>& parserTok
                 typeStart += 8;
                 size_t typeEnd = tokenStr.find('"', typeStart);
                 if (typeEnd != std::string::npos) {
-                    token.type = tokenStr.substr(typeStart, typeEnd - typeStart);
+                    type = tokenStr.substr(typeStart, typeEnd - typeStart);
                 }
             }
 
@@ -83,7 +84,8 @@ bool parseJsonTokens(const char* tokensJson, std::vector<ParserToken>& parserTok
                 }
             }
 
-            if (!token.type.empty()) {
+            if (!type.empty()) {
+                token.kind = stringToTokenKind(type);
                 parserTokens.push_back(token);
             }
 
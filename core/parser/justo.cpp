@@ -49,6 +49,7 @@ bool parseJUSTOTokens(const char* tokensJUSTO, std::vector<ParserToken>& parserT
             if (justoStr[pos] != '{') break;
 
             ParserToken token;
+            std::string type;
             size_t tokenEnd = justoStr.find('}', pos);
             if (tokenEnd == std::string::npos) break;
 
@@ -62,7 +63,7 @@ bool parseJUSTOTokens(const char* tokensJUSTO, std::vector<ParserToken>& parserT
                     typeEnd = tokenStr.find('"', typeEnd);
                 }
                 if (typeEnd != std::string::npos) {
-                    token.type = tokenStr.substr(typeStart, typeEnd - typeStart);
+                    type = tokenStr.substr(typeStart, typeEnd - typeStart);
                 }
             }
 
@@ -89,7 +90,8 @@ bool parseJUSTOTokens(const char* tokensJUSTO, std::vector<ParserToken>& parserT
                 }
             }
 
-            if (!token.type.empty()) {
+            if (!type.empty()) {
+                token.kind = stringToTokenKind(type);
                 parserTokens.push_back(token);
             }
 
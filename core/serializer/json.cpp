@@ -81,7 +81,7 @@ std::string JsonSerializer::valueToJson(const Value& value) {
             std::stringstream ss;
             ss << "{";
             bool first = true;
-            for (const auto& pair : value.properties) {
+            for (const auto& pair : value.properties()) {
                 if (!first) ss << ",";
                 first = false;
                 ss << "\"" << escapeJsonString(pair.first) << "\":"
@@ -93,9 +93,9 @@ std::string JsonSerializer::valueToJson(const Value& value) {
         case DataType::JSON_ARRAY: {
             std::stringstream ss;
             ss << "[";
-            for (size_t i = 0; i < value.array_elements.size(); i++) {
+            for (size_t i = 0; i < value.array_elements().size(); i++) {
                 if (i > 0) ss << ",";
-                ss << valueToJson(value.array_elements[i]);
+                ss << valueToJson(value.array_elements()[i]);
             }
             ss << "]";
             return ss.str();
@@ -121,8 +121,8 @@ std::string JsonSerializer::valueToJson(const Value& value) {
         case DataType::BINARY_DATA: {
             std::stringstream ss;
             ss << "[";
-            for (size_t i = 0; i < value.binary_data.size(); i++) {
-                unsigned char binchar = value.binary_data[i];
+            for (size_t i = 0; i < value.binary_data().size(); i++) {
+                unsigned char binchar = value.binary_data()[i];
                 double binnum = static_cast<double>(binchar);
                 if (i > 0) ss << ",";
                 ss << binnum;
@@ -143,8 +143,8 @@ std::string JsonSerializer::tokensToJson(const std::vector<ParserToken>& tokens)
         const auto& token = tokens[i];
 
         json << "{";
-        json << "\"type\":\"" << escapeJsonString(token.type) << "\",";
-        json << "\"value\":\"" << escapeJsonString(token.value) << "\",";
+        json << "\"type\":\"" << escapeJsonString(token.type()) << "\",";
+        json << "\"value\":\"" << escapeJsonString(token.value.str()) << "\",";
         json << "\"start\":" << token.start;
         json << "}";
 
@@ -37,10 +37,10 @@ public:
     static std::string serialize(const std::vector<LogEntry>& logs);
     static std::string serialize(const std::vector<std::vector<std::string>>& importLogs);
     static std::string escapeJsonString(const std::string& str);
+    static std::string tokensToJson(const std::vector<ParserToken>& tokens);
 
 private:
     static std::string valueToJson(const Value& value);
-    static std::string tokensToJson(const std::vector<ParserToken>& tokens);
 };
 
 #endif
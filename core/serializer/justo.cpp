@@ -88,8 +88,8 @@ std::string JUSTOSerializer::tokensToJUSTO(const std::vector<ParserToken>& token
         const auto& token = tokens[i];
         if (!first) justo << ",";
         first = false;
-        justo << "o{type:" << escapeJUSTOString(token.type) << ";";
-        justo << "value:" << escapeJUSTOString(token.value) << ";";
+        justo << "o{type:" << escapeJUSTOString(token.type()) << ";";
+        justo << "value:" << escapeJUSTOString(token.value.str()) << ";";
         justo << "start:n" << token.start << "}";
     }
 
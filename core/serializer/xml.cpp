@@ -100,8 +100,8 @@ std::string XmlSerializer::tokensToXml(const std::vector<ParserToken>& tokens) {
 
     for (const auto& token : tokens) {
         xml << "<token>";
-        xml << "<type>" << escapeXmlString(token.type) << "</type>";
-        xml << "<value>" << escapeXmlString(token.value) << "</value>";
+        xml << "<type>" << escapeXmlString(token.type()) << "</type>";
+        xml << "<value>" << escapeXmlString(token.value.str()) << "</value>";
         xml << "<start>" << token.start << "</start>";
         xml << "</token>";
     }
@@ -124,8 +124,8 @@ std::string YamlSerializer::tokensToYaml(const std::vector<ParserToken>& tokens)
 
     for (size_t i = 0; i < tokens.size(); i++) {
         const auto& token = tokens[i];
-        yaml << "  - type: " << escapeYamlString(token.type) << "\n";
-        yaml << "    value: " << escapeYamlString(token.value) << "\n";
+        yaml << "  - type: " << escapeYamlString(token.type()) << "\n";
+        yaml << "    value: " << escapeYamlString(token.value.str()) << "\n";
         yaml << "    start: " << token.start << "\n";
     }
 
@@ -0,0 +1,173 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "threadpool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    std::atomic<size_t> defaultWorkers(0);
+    std::atomic<size_t> defaultQueueLimit(1024);
+
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(size_t workers, size_t queueLimit)
+    : queued(0), nextQueue(0), stopping(false), queueLimit(queueLimit), submitted(0), completed(0), ranInline(0), peakQueued(0) {
+    for (size_t i = 0; i < workers; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < workers; i++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::getInstance() {
+#ifdef __EMSCRIPTEN__
+    static ThreadPool instance(0, 0);
+#else
+    static ThreadPool instance(defaultWorkers.load() ? defaultWorkers.load() : std::max(1u, std::thread::hardware_concurrency()), defaultQueueLimit.load());
+#endif
+    return instance;
+}
+
+void ThreadPool::setDefaultWorkers(size_t workers) {
+    defaultWorkers = workers;
+}
+
+void ThreadPool::setDefaultQueueLimit(size_t queueLimit) {
+    defaultQueueLimit = queueLimit;
+}
+
+size_t ThreadPool::workers() const {
+    return threads.size();
+}
+
+ThreadPool::Metrics ThreadPool::metrics() const {
+    Metrics result;
+    result.workers = threads.size();
+    result.queueLimit = queueLimit;
+    result.submitted = submitted.load();
+    result.completed = completed.load();
+    result.ranInline = ranInline.load();
+    result.queued = queued.load();
+    result.peakQueued = peakQueued.load();
+    return result;
+}
+
+void ThreadPool::runTask(Task& task) {
+    try {
+        task();
+    } catch (...) {}
+    completed.fetch_add(1);
+}
+
+void ThreadPool::submit(Task task) {
+    submitted.fetch_add(1);
+    if (threads.empty() || (queueLimit && queued.load() >= queueLimit)) {
+        ranInline.fetch_add(1);
+        runTask(task);
+        return;
+    }
+
+    size_t index = currentPool == this ? currentWorker : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    size_t depth = queued.fetch_add(1) + 1;
+    size_t peak = peakQueued.load();
+    while (depth > peak && !peakQueued.compare_exchange_weak(peak, depth)) {}
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::takeTask(size_t preferred, Task& task) {
+    if (queued.load() == 0) return false;
+
+    {
+        Queue& own = *queues[preferred];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue& other = *queues[(preferred + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runPendingTask() {
+    if (threads.empty()) return false;
+
+    Task task;
+    if (!takeTask(currentPool == this ? currentWorker : 0, task)) return false;
+    runTask(task);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    Task task;
+    while (true) {
+        if (takeTask(index, task)) {
+            runTask(task);
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,147 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template<class T>
+class Deferred;
+
+// Work-stealing pool: each worker runs the newest task of its own deque first and steals
+// the oldest task of another worker once its deque is empty. Without workers (Emscripten
+// builds, or a pool of size 0) submitted tasks run on the calling thread, and so do tasks
+// submitted while `queueLimit` tasks are already waiting.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    struct Metrics {
+        size_t workers;
+        size_t queueLimit;
+        size_t submitted;
+        size_t completed;
+        size_t ranInline;
+        size_t queued;
+        size_t peakQueued;
+    };
+
+    explicit ThreadPool(size_t workers, size_t queueLimit = 1024);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& getInstance();
+    // worker count of getInstance(), used on its first call; 0 - one worker per hardware thread
+    static void setDefaultWorkers(size_t workers);
+    // queue limit of getInstance(), used on its first call; 0 - unlimited
+    static void setDefaultQueueLimit(size_t queueLimit);
+
+    void submit(Task task);
+    template<class Func>
+    auto defer(Func&& func) -> Deferred<decltype(func())>;
+    bool runPendingTask();
+    size_t workers() const;
+    Metrics metrics() const;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> nextQueue;
+    bool stopping;
+
+    size_t queueLimit;
+    std::atomic<size_t> submitted;
+    std::atomic<size_t> completed;
+    std::atomic<size_t> ranInline;
+    std::atomic<size_t> peakQueued;
+
+    void runTask(Task& task);
+    bool takeTask(size_t preferred, Task& task);
+    void workerLoop(size_t index);
+};
+
+// Result of a task started with ThreadPool::defer(). get() joins it; while waiting the caller
+// runs other pending tasks, so joining on a worker thread cannot starve the pool.
+template<class T>
+class Deferred {
+public:
+    Deferred() : pool(nullptr) {}
+    Deferred(ThreadPool* pool, std::shared_future<T> future) : pool(pool), future(std::move(future)) {}
+
+    static Deferred ready(T value) {
+        std::promise<T> promise;
+        promise.set_value(std::move(value));
+        return Deferred(nullptr, promise.get_future().share());
+    }
+
+    bool valid() const {
+        return future.valid();
+    }
+    bool isReady() const {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    T get() const {
+        while (pool && !isReady()) {
+            if (!pool->runPendingTask()) future.wait_for(std::chrono::milliseconds(1));
+        }
+        return future.get();
+    }
+
+private:
+    ThreadPool* pool;
+    std::shared_future<T> future;
+};
+
+template<class Func>
+auto ThreadPool::defer(Func&& func) -> Deferred<decltype(func())> {
+    typedef decltype(func()) ResultType;
+
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+    Deferred<ResultType> result(this, task->get_future().share());
+    submit([task]() { (*task)(); });
+    return result;
+}
+
+#endif
@@ -59,8 +59,8 @@ std::string Utility::value2string(const Value& value) {
             return numberValue2string(value);
         case DataType::JUSTC_OBJECT:
             if (value.name == "HTTP.Responce") {
-                auto text = value.object_value.find("text");
-                if (text != value.object_value.end()) return value2string(text->second);
+                auto text = value.object_value().find("text");
+                if (text != value.object_value().end()) return value2string(text->second);
                 else return value.toString();
             } else return value.toString();
         default:
@@ -173,6 +173,36 @@ std::string Utility::position(const size_t& pos_, const std::string& script) {
     return "line " + std::to_string(line) + ", column " + std::to_string(column);
 }
 
+LineIndex::LineIndex(const std::string& script) : length(script.length()), lineStarts{0} {
+    for (size_t i = 0; i < length; i++) {
+        if (script[i] == '\n') {
+            lineStarts.push_back(i + 1);
+        } else if (script[i] == '\r') {
+            if (i + 1 < length && script[i + 1] == '\n') {
+                crlf.push_back(++i);
+            }
+            lineStarts.push_back(i + 1);
+        }
+    }
+}
+
+std::pair<size_t, size_t> LineIndex::pos(size_t pos) const {
+    if (length == 0 || pos >= length) {
+        return {1, 1};
+    }
+    if (std::binary_search(crlf.begin(), crlf.end(), pos)) { // \n of \r\n belongs to the next line
+        pos++;
+    }
+
+    size_t line = std::upper_bound(lineStarts.begin(), lineStarts.end(), pos) - lineStarts.begin();
+    return {line, pos - lineStarts[line - 1] + 1};
+}
+
+std::string LineIndex::position(size_t pos) const {
+    std::pair<size_t, size_t> position = this->pos(pos);
+    return "line " + std::to_string(position.first) + ", column " + std::to_string(position.second);
+}
+
 DataType Utility::typeDeclaration2dataType(const std::string& typeDeclaration, const std::string& position) {
     static const std::unordered_map<std::string, DataType> typeMap = {
         { "number",      DataType::NUMBER       },     { "num",  DataType::NUMBER       },
@@ -201,31 +231,30 @@ DataType Utility::typeDeclaration2dataType(const std::string& typeDeclaration, c
     throw std::runtime_error("Invalid type declaration \"" + typeDeclaration + "\" at " + position + ".");
 }
 
-Value Utility::convert(const Value value, const DataType type) {
-    Value result = value;
-    result.type = type;
+Value Utility::convert(Value value, const DataType type) {
+    value.type = type;
     switch (type) {
         case DataType::NUMBER:
             break;
         case DataType::BINARY:
-            result.name = double2binString(value.number_value);
+            value.name = double2binString(value.number_value);
             break;
         case DataType::HEXADECIMAL:
-            result.name = double2hexString(value.number_value);
+            value.name = double2hexString(value.number_value);
             break;
         case DataType::OCTAL:
-            result.name = double2octString(value.number_value);
+            value.name = double2octString(value.number_value);
             break;
         default: // warning: 15 enumeration values not handled in switch: 'UNKNOWN', 'JUSTC_OBJECT', 'STRING'... [-Wswitch]
             throw std::runtime_error("JUSTC/core/utility.cpp error: Incorrect usage.");
     }
-    return result;
+    return value;
 }
 
-Value Utility::ParseResult2Value(const ParseResult parseresult) {
+Value Utility::ParseResult2Value(const ParseResult& parseresult) {
     Value result;
     result.type = DataType::JUSTC_OBJECT;
-    result.object_value = parseresult.returnValues;
+    result.mutableData().object_value = parseresult.returnValues;
     result.name = "(Object)";
     return result;
 }
@@ -313,15 +342,15 @@ std::string Utility::_stringifyValue(const Value& value, int indentLevel) {
             std::string result = "{" + nextIndent;
             bool first = true;
 
-            const auto& props = value.properties;
+            const auto& props = value.properties();
             for (const auto& [key, val] : props) {
                 if (!first) result += "," + nextIndent;
                 first = false;
                 result += "\"" + escapeJUSTCString(key) + "\":" + _stringifyValue(val, indentLevel + 1);
             }
 
-            if (value.object_context && !value.object_context->variables.empty()) {
-                for (const auto& [key, val] : value.object_context->variables) {
+            if (value.object_context() && !value.object_context()->variables.empty()) {
+                for (const auto& [key, val] : value.object_context()->variables) {
                     if (props.find(key) != props.end()) continue;
 
                     if (!first) result += "," + nextIndent;
@@ -336,9 +365,9 @@ std::string Utility::_stringifyValue(const Value& value, int indentLevel) {
 
         case DataType::JSON_ARRAY: {
             std::string result = "[" + nextIndent;
-            for (size_t i = 0; i < value.array_elements.size(); i++) {
+            for (size_t i = 0; i < value.array_elements().size(); i++) {
                 if (i > 0) result += "," + nextIndent;
-                result += _stringifyValue(value.array_elements[i], indentLevel + 1);
+                result += _stringifyValue(value.array_elements()[i], indentLevel + 1);
             }
             result += indent + "]";
             return result;
@@ -353,13 +382,13 @@ std::string Utility::_stringifyValue(const Value& value, int indentLevel) {
             }
 
             std::string result;
-            if (value.function_info.isIsolated) {
+            if (value.function_info().isIsolated) {
                 result = "isolated ";
             }
             result += "function " + value.name + "(";
-            for (size_t i = 0; i < value.function_info.paramNames.size(); i++) {
+            for (size_t i = 0; i < value.function_info().paramNames.size(); i++) {
                 if (i > 0) result += ", ";
-                result += value.function_info.paramNames[i];
+                result += value.function_info().paramNames[i];
             }
             result += "){" + nextIndent;
             result += value.string_value;
@@ -369,8 +398,8 @@ std::string Utility::_stringifyValue(const Value& value, int indentLevel) {
 
         case DataType::BINARY_DATA: {
             std::string binData;
-            for (size_t i = 0; i < value.binary_data.size(); i++) {
-                binData += std::to_string(static_cast<int>(value.binary_data[i]));
+            for (size_t i = 0; i < value.binary_data().size(); i++) {
+                binData += std::to_string(static_cast<int>(value.binary_data()[i]));
             }
             return "Binary::FromText(\"" + escapeJUSTCString(binData) + "\")";
         }
@@ -642,23 +671,23 @@ bool Utility::compareValues(const Value& left, const Value& right) {
 
         case DataType::JUSTC_OBJECT:
         case DataType::JSON_OBJECT:
-            if (left.properties.size() != right.properties.size()) return false;
-            for (const auto& [key, val] : left.properties) {
-                auto it = right.properties.find(key);
-                if (it == right.properties.end()) return false;
+            if (left.properties().size() != right.properties().size()) return false;
+            for (const auto& [key, val] : left.properties()) {
+                auto it = right.properties().find(key);
+                if (it == right.properties().end()) return false;
                 if (!compareValues(val, it->second)) return false;
             }
             return true;
 
         case DataType::JSON_ARRAY:
-            if (left.array_elements.size() != right.array_elements.size()) return false;
-            for (size_t i = 0; i < left.array_elements.size(); i++) {
-                if (!compareValues(left.array_elements[i], right.array_elements[i])) return false;
+            if (left.array_elements().size() != right.array_elements().size()) return false;
+            for (size_t i = 0; i < left.array_elements().size(); i++) {
+                if (!compareValues(left.array_elements()[i], right.array_elements()[i])) return false;
             }
             return true;
 
         case DataType::BINARY_DATA:
-            return left.binary_data == right.binary_data;
+            return left.binary_data() == right.binary_data();
 
         case DataType::FUNCTION:
             return _stringifyValue(left) == _stringifyValue(right);
@@ -216,8 +216,8 @@ public:
     static std::pair<size_t, size_t> pos(const size_t& pos, const std::string& script);
     static std::string position(const size_t& pos_, const std::string& script);
     static DataType typeDeclaration2dataType(const std::string& typeDeclaration, const std::string& position);
-    static Value convert(const Value value, const DataType type);
-    static Value ParseResult2Value(const ParseResult parseresult);
+    static Value convert(Value value, const DataType type);
+    static Value ParseResult2Value(const ParseResult& parseresult);
     static bool isGitHubActions();
     static std::unordered_map<std::string, std::string> ParseHeaders(const std::string& headers);
     static std::string defaultHTTPAccept;
@@ -232,6 +232,17 @@ public:
     static std::string doubleToString(double value);
     static bool compareValues(const Value& left, const Value& right);
 };
+class LineIndex {
+public:
+    explicit LineIndex(const std::string& script);
+    std::pair<size_t, size_t> pos(size_t pos) const;
+    std::string position(size_t pos) const;
+
+private:
+    size_t length;
+    std::vector<size_t> lineStarts;
+    std::vector<size_t> crlf;
+};
 class UnicodeUtility {
 public:
     static bool isValidUTF8(const std::string& str) {
@@ -43,7 +43,7 @@ rm -rf wabt-1.0.34 wabt-1.0.34-ubuntu.tar.gz
 git clone --depth 1 --branch v1.3.2 https://github.com/USCiLab/cereal.git _deps/cereal-src
 CEREAL_INCLUDE="-I./_deps/cereal-src/include"
 
-SOURCE_FILES="core/entry/jsapi.cpp core/lexer.cpp core/parser.cpp core/parser/json.cpp core/serializer/json.cpp core/keywords.cpp \
+SOURCE_FILES="core/entry/jsapi.cpp core/lexer.cpp core/parser.cpp core/expression.cpp core/threadpool.cpp core/parser/json.cpp core/serializer/json.cpp core/keywords.cpp \
 core/fetch.cpp core/serializer/xml.cpp core/serializer/yaml.cpp core/utility.cpp core/import.cpp core/lang/luau.cpp core/built-in/http/http.cpp \
 core/built-in/math/math.cpp core/built-in/binary/binary.cpp core/built-in/string/string.cpp core/unicode.cpp core/builtins.cpp core/serializer/justo.cpp \
 core/parser/justo.cpp core/cpptypes.cpp core/justb.cpp core/compiler/justb.cpp core/loader/justb.cpp"
@@ -60,7 +60,7 @@ luau/VM/src/lvmutils.cpp luau/Ast/src/Allocator.cpp luau/Ast/src/Cst.cpp luau/As
 luau/VM/src/lbuflib.cpp luau/VM/src/lgcdebug.cpp luau/VM/src/lnumprint.cpp luau/VM/src/lveclib.cpp"
 LUAU_INCLUDE="-I./luau/Ast/include -I./luau/Common/include -I./luau/Compiler/include -I./luau/VM/include"
 
-COMMON_FLAGS="-s EXPORTED_FUNCTIONS=[\"_malloc\",\"_free\",\"_registerFunction\",\"_unregisterFunction\",\"_clearUserFunctions\",\"_registerGlobal\",\"_getGlobal\",\"_hasGlobal\",\"_unregisterGlobal\",\"_clearGlobals\",\"_registerPointer\",\"_getPointer\",\"_unregisterPointer\",\"_clearPointers\",\"_addVariableUpdateListener\",\"_clearVariableUpdateListeners\",\"_justoParse\",\"_lexer\",\"_parser\",\"_parse\",\"_free_string\",\"_version\",\"_load\"] \
+COMMON_FLAGS="-s EXPORTED_FUNCTIONS=[\"_malloc\",\"_free\",\"_registerFunction\",\"_unregisterFunction\",\"_clearUserFunctions\",\"_registerGlobal\",\"_getGlobal\",\"_hasGlobal\",\"_unregisterGlobal\",\"_clearGlobals\",\"_registerPointer\",\"_getPointer\",\"_unregisterPointer\",\"_clearPointers\",\"_addVariableUpdateListener\",\"_clearVariableUpdateListeners\",\"_justoParse\",\"_lexer\",\"_lexerOpen\",\"_lexerEdit\",\"_lexerClose\",\"_parser\",\"_parse\",\"_free_string\",\"_version\",\"_load\"] \
 -s EXPORTED_RUNTIME_METHODS=[\"ccall\",\"cwrap\",\"addFunction\",\"removeFunction\",\"UTF8ToString\",\"stringToUTF8\",\"setValue\",\"getValue\",\"HEAPU8\",\"HEAP32\",\"HEAP16\",\"HEAP8\"] \
 -s MODULARIZE=1 \
 -s EXPORT_ALL=1 \
@@ -208,7 +208,7 @@ mkdir -p $JSOUT_DIR/JUSTC/javascript
 srcfile=$JSOUT_DIR/JUSTC/index.json
 echo "[" > $srcfile
 
-SOURCE_FILES+=" core/entry/cli.cpp core/lexer.h core/parser.h core/parser/json.hpp core/serializer/json.hpp core/keywords.h core/fetch.h core/version.h core/json.hpp \
+SOURCE_FILES+=" core/entry/cli.cpp core/lexer.h core/parser.h core/expression.h core/parser/json.hpp core/serializer/json.hpp core/keywords.h core/fetch.h core/version.h core/json.hpp \
 core/serializer/xml.hpp core/serializer/yaml.hpp core/utility.h core/import.hpp core/parser.emscripten.h core/lang/js.cpp core/lang/js.hpp core/lang/luau.hpp \
 core/built-in/http/http.hpp core/utility.emscripten.h core/built-in/math/math.hpp core/built-in/binary/binary.hpp core/built-in/s.hpp core/lexer.emscripten.h \
 core/entry/lib.cpp core/entry/lib.hpp LICENSE README.md core/built-in/string/string.hpp core/unicode.hpp core/unicode.emscripten.h core/builtins.h core/global.h \
@@ -103,6 +103,8 @@ SOFTWARE.
         parseError: 'JUSTC/core/parser.cpp error: ',
         jsonInput: 'Argument 0 should be an object.',
         lexerInput: 'Provided input is not valid core.lexer output.',
+        lexerClosed: 'This core.lexer.document has been closed.',
+        editInput: 'Edit offset and removed length should be numbers, and the inserted text a string.',
         boolInput: 'Argument 1 should be a boolean.',
         environment: 'Invalid or compromised environment.',
         outputMode: 'Invalid output format.',
@@ -202,6 +204,47 @@ SOFTWARE.
         }
     };
 
+    JUSTC.Core.LexerResult = function(resultptr) {
+        const resultjson = JUSTC.WASM.UTF8ToString(resultptr);
+        JUSTC.WASM.ccall(
+            'free_string',
+            null,
+            ['number'],
+            [resultptr]
+        );
+        const result = json_.parse(resultjson);
+        if (result.error) {
+            throw new JUSTC.Error((result.lexer ? JUSTC.Errors.lexerError : (JUSTC.Errors.executionError + " ")) + result.error);
+        }
+        return result;
+    };
+    // offsets and token starts are UTF-8 byte offsets into the document, as in core.lexer
+    JUSTC.Core.LexerDocument = function LexerDocument(code) {
+        if (!JUSTC.WASM) throw new JUSTC.Error(JUSTC.Errors.initWasm);
+        if (!code || typeof code != 'string' || code.length < 1) throw new JUSTC.Error(JUSTC.Errors.wrongInputType);
+        const opened = JUSTC.Core.LexerResult(JUSTC.WASM.ccall('lexerOpen', 'number', ['string'], [code]));
+        const id = opened.document;
+        let closed = false;
+        return OBJECT.freeze({
+            tokens: opened.tokens,
+            edit: function(offset, removed, inserted = '') {
+                if (closed) throw new JUSTC.Error(JUSTC.Errors.lexerClosed);
+                if (typeof offset != 'number' || typeof removed != 'number' || typeof inserted != 'string') throw new JUSTC.Error(JUSTC.Errors.editInput);
+                return JUSTC.Core.LexerResult(JUSTC.WASM.ccall(
+                    'lexerEdit',
+                    'number',
+                    ['number', 'number', 'number', 'string'],
+                    [id, offset, removed, inserted]
+                ));
+            },
+            close: function() {
+                if (closed) return;
+                closed = true;
+                JUSTC.WASM.ccall('lexerClose', null, ['number'], [id]);
+            }
+        });
+    };
+
     JUSTC.PrivateFunctions = {
         All: {
             Lexer: {
@@ -209,6 +252,11 @@ SOFTWARE.
                 Name: "core.lexer",
                 Return: JUSTC.Core.Lexer
             },
+            LexerDocument: {
+                NeedsWASM: true,
+                Name: "core.lexer.document",
+                Return: JUSTC.Core.LexerDocument
+            },
             Parser: {
                 NeedsWASM: true,
                 Name: "core.parser",
@@ -283,6 +331,7 @@ SOFTWARE.
         ],
         WhatToName: {
             "core.lexer": "Lexer",
+            "core.lexer.document": "LexerDocument",
             "core.parser": "Parser",
             "errorsEnabled": "CoreErrors",
             "logsEnabled": "CoreLogs",
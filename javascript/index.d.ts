@@ -41,6 +41,35 @@ declare module 'justc' {
         lexer?: boolean;
     }
 
+    interface TokenDelta {
+        /** Index of the first token that changed. */
+        first: number;
+        /** Number of old tokens, from `first` on, that `tokens` replace. */
+        removed: number;
+        /** Byte offset added to the start of every token after the replaced ones. */
+        shift: number;
+        tokens: LexerResult['tokens'];
+    }
+
+    interface LexerDocument {
+        /** Tokens of the document as it was opened. */
+        readonly tokens: LexerResult['tokens'];
+
+        /**
+         * Replace `removed` bytes at `offset` with `inserted` and re-lex only what the edit touched.
+         * Offsets are UTF-8 byte offsets, like token starts.
+         * @returns The tokens that changed.
+         * @since 0.3.0
+         */
+        edit(offset: number, removed: number, inserted?: string): TokenDelta;
+
+        /**
+         * Free the document. It can not be edited afterwards.
+         * @since 0.3.0
+         */
+        close(): void;
+    }
+
     interface ParserResult {
         return?: any;
         error?: string;
@@ -137,6 +166,7 @@ declare module 'justc' {
          * @returns Requested internal function(s) if exists and available.
          * @since 0.1.0
          */
+        requestPermissions(what: 'core.lexer.document'): (code: string) => LexerDocument;
         requestPermissions(what: string | string[]): ((...args: any[]) => any) | ((...args: any[]) => any)[];
     }
 
@@ -201,6 +231,7 @@ declare module 'justc' {
          * @returns Requested internal function(s) if exists and available.
          * @since 0.1.0
          */
+        requestPermissions(what: 'core.lexer.document'): Promise<(code: string) => LexerDocument>;
         requestPermissions(what: string | string[]): Promise<((...args: any[]) => any) | ((...args: any[]) => any)[]>;
 
         /**
@@ -0,0 +1,173 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// Heap allocations per evaluated statement. Every script runs at two sizes and only the difference is
+// counted, so the fixed cost of starting the parser cancels out. Fails when a case goes over its limit.
+
+#include "lexer.h"
+#include "parser.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+static std::atomic<size_t> allocations{0};
+
+// Every replaceable form of operator new goes through these two, so array, nothrow and aligned
+// allocations (pmr resources use the aligned ones) are all counted.
+static void* allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+// over-allocates with malloc and keeps the pointer to free just in front of the aligned block
+static void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    void* raw = std::malloc(size + align + sizeof(void*));
+    if (!raw) return nullptr;
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    void* aligned = reinterpret_cast<void*>((start + align - 1) & ~static_cast<std::uintptr_t>(align - 1));
+    static_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+}
+
+static void freeAligned(void* pointer) {
+    if (pointer) std::free(static_cast<void**>(pointer)[-1]);
+}
+
+void* operator new(std::size_t size) {
+    if (void* pointer = allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* pointer = allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(pointer); }
+
+static size_t countAllocations(const std::string& code) {
+    size_t before = allocations.load();
+    auto lexed = Lexer::parse(code);
+    ParseResult result = Parser::parseTokens(std::move(lexed.second), true, false, lexed.first, false, false, "allocations");
+    if (!result.error.empty()) {
+        std::fprintf(stderr, "%s\n", result.error.c_str());
+        std::exit(1);
+    }
+    return allocations.load() - before;
+}
+
+struct Case {
+    const char* name;
+    std::function<std::string(size_t)> script;
+    double limit;
+};
+
+int main() {
+    // array, aligned and pmr allocations have to reach the counter too
+    auto counted = [](auto&& body) {
+        size_t before = allocations.load();
+        body();
+        return allocations.load() != before;
+    };
+    bool countsEverything = counted([] {
+        char* volatile array = new char[16];
+        delete[] array;
+    }) && counted([] {
+        void* volatile aligned = ::operator new(64, std::align_val_t(64));
+        ::operator delete(aligned, std::align_val_t(64));
+    }) && counted([] {
+        std::pmr::unsynchronized_pool_resource pool;
+        pool.deallocate(pool.allocate(64), 64);
+    });
+    if (!countsEverything) {
+        std::fprintf(stderr, "Allocations bypass the counter.\n");
+        return 1;
+    }
+
+    const Case cases[] = {
+        {"while iteration", [](size_t n) {
+            return "i = 0 , total = 0 , while (i != " + std::to_string(n) + ") { i = i + 1 , total = total + i * 2 . } .";
+        }, 32},
+        {"function call", [](size_t n) {
+            std::string code = "function add(a, b) { return a + b . } , total = 0";
+            for (size_t i = 0; i < n; i++) code += " , total = add(total, " + std::to_string(i) + ")";
+            return code + " .";
+        }, 130},
+        {"declaration", [](size_t n) {
+            std::string code = "v0 is 1";
+            for (size_t i = 1; i < n; i++) code += " , v" + std::to_string(i) + " is v" + std::to_string(i - 1) + " + 1";
+            return code + " .";
+        }, 9},
+    };
+
+    const size_t small = 1000, large = 3000;
+    bool failed = false;
+    for (const Case& test : cases) {
+        size_t first = countAllocations(test.script(small));
+        size_t second = countAllocations(test.script(large));
+        double perStatement = (static_cast<double>(second) - static_cast<double>(first)) / (large - small);
+        bool over = perStatement > test.limit;
+        std::printf("%-16s %8.1f allocations/statement (limit %.0f)%s\n", test.name, perStatement, test.limit, over ? "  FAILED" : "");
+        failed = failed || over;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// A script read in chunks must lex to the same tokens as the whole script: every input is fed
+// one byte at a time and in random-size chunks, and the tokens (or the error) are compared with
+// Lexer::parse.
+
+#include "lexer.h"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct Lexed {
+    SourceBuffer source; // the tokens of Lexer::parse are slices of it
+    std::vector<ParserToken> tokens;
+    std::string error;
+};
+
+static Lexed whole(const std::string& script) {
+    Lexed result;
+    try {
+        std::tie(result.source, result.tokens) = Lexer::parse(script);
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+// `chunkSize` gives the size of each next chunk
+template<class ChunkSize>
+static Lexed streamed(const std::string& script, ChunkSize chunkSize) {
+    Lexed result;
+    size_t offset = 0;
+    try {
+        Lexer lexer([&](std::string& chunk) {
+            if (offset >= script.length()) return false;
+            chunk = script.substr(offset, chunkSize());
+            offset += chunk.length();
+            return true;
+        }, false);
+        ParserToken token;
+        while (lexer.next(token)) {
+            result.tokens.push_back(token);
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+static bool same(const Lexed& expected, const Lexed& actual, const std::string& name, const std::string& mode) {
+    if (expected.error != actual.error) {
+        std::cerr << name << " (" << mode << "): error \"" << actual.error << "\", expected \"" << expected.error << "\"." << std::endl;
+        return false;
+    }
+    if (!expected.error.empty()) return true;
+    if (expected.tokens.size() != actual.tokens.size()) {
+        std::cerr << name << " (" << mode << "): " << actual.tokens.size() << " tokens, expected " << expected.tokens.size() << "." << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < expected.tokens.size(); i++) {
+        const ParserToken& a = expected.tokens[i];
+        const ParserToken& b = actual.tokens[i];
+        if (a.kind != b.kind || a.start != b.start || a.value.str() != b.value.str()) {
+            std::cerr << name << " (" << mode << "): token " << i << " is " << b.type() << " \"" << b.value.str() << "\" at " << b.start
+                      << ", expected " << a.type() << " \"" << a.value.str() << "\" at " << a.start << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::vector<std::pair<std::string, std::string>> scripts = {
+        {"declarations", "a is 1, b = 2.5, c: 0x1F, d is 0b101 + 0o17, e is -3 // 2, const f is a ** b.\n"},
+        {"strings", "a is \"plain\", b is \"esc\\\"aped \\n\", c is 'raw \\n', d is \"\", e is l<https://just.js.org/justc/>.\n"},
+        {"utf-8", "привет is \"мир\", emoji is \"😀 🚀\", é is #\"é\".\r\nz is привет.\r\n"},
+        {"comments", "-- line comment\na is 1, -{ multi\nline }- b is 2 -- trailing\n, c is a.\n"},
+        {"objects", "output disabled,\nfunction f(x) { return x + 1. }, o is |k is 1, m is f(2)|, arr is [1, 2, {x: 3}], echo(o).\n"},
+        {"operators", "a is 1 ?? 2, b is a != 3, c is a <= b, d is a >> 1, e is a..b, f is !a, g is a |> f, h is a ~= b.\n"},
+        {"unterminated", "a is \"never closed"},
+        {"no end", "a is 1,\nb is 2"},
+        {"single token", "."},
+        {"goto", "a is 1,\nlgt 14\nb is 2, lgt 0.\n"},
+        {"json", "{\"a\": [1, 2, {\"b\": null}], \"c\": true}"},
+    };
+
+    // long enough for the streamed buffer to drop the lines it is done with
+    std::string long_;
+    for (int i = 0; i < 10000; i++) {
+        long_ += "v" + std::to_string(i) + " is \"line " + std::to_string(i) + "\" + " + std::to_string(i * 7) + ", -- comment\n";
+    }
+    scripts.push_back({"long", long_ + "done is true."});
+    scripts.push_back({"long, no end", long_ + "done is true"});
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<size_t> sizes(1, 64);
+
+    bool failed = false;
+    for (const auto& [name, script] : scripts) {
+        Lexed expected = whole(script);
+        if (!same(expected, streamed(script, [] { return 1; }), name, "1-byte chunks")) failed = true;
+        for (int run = 0; run < 20; run++) {
+            if (!same(expected, streamed(script, [&] { return sizes(random); }), name, "random chunks")) {
+                failed = true;
+                break;
+            }
+        }
+    }
+    return failed ? 1 : 0;
+}
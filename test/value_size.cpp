@@ -0,0 +1,91 @@
+/*
+
+MIT License
+
+Copyright (c) 2025-2026 JustStudio. <https://juststudio.is-a.dev/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+// Value is copied around everywhere, so its size is part of the interpreter's memory footprint:
+// 1M numbers, plain or typed, should cost about sizeof(Value) each and nothing on the heap beyond
+// the vector.
+
+#include "parser.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <fstream>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(Value) <= 136, "Value grew; keep rarely used members in ValueData");
+
+#ifdef __linux__
+static size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+#endif
+
+#ifdef __linux__
+// resident bytes per value of `count` values made by `make`; `values` keeps them alive so the
+// next measurement can not reuse their pages
+template<class Make>
+double bytesPerValue(std::vector<Value>& values, size_t count, Make make) {
+    size_t before = residentBytes();
+    values.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        values.push_back(make(i));
+    }
+    return static_cast<double>(residentBytes() - before) / count;
+}
+#endif
+
+int main() {
+    std::cout << "sizeof(Value) = " << sizeof(Value) << " bytes" << std::endl;
+
+#ifdef __linux__
+    const size_t count = 1000000;
+    std::vector<Value> numbers, typedNumbers;
+
+    const double perNumber = bytesPerValue(numbers, count, [](size_t i) {
+        return Value::createNumber(static_cast<double>(i));
+    });
+    const double perTypedNumber = bytesPerValue(typedNumbers, count, [](size_t i) {
+        return Value::createNumberWithType(static_cast<int64_t>(i), NumericType::INT64);
+    });
+    std::cout << "RSS per number = " << perNumber << " bytes" << std::endl;
+    std::cout << "RSS per i64 number = " << perTypedNumber << " bytes" << std::endl;
+
+    bool failed = false;
+    for (double perValue : {perNumber, perTypedNumber}) {
+        if (perValue > sizeof(Value) + 16) {
+            std::cerr << "Numbers take " << perValue << " bytes each, expected about " << sizeof(Value) << "." << std::endl;
+            failed = true;
+        }
+    }
+    return failed ? 1 : 0;
+#else
+    return 77;
+#endif
+}